@@ -1,7 +1,9 @@
 #include "BindingSetManager.h"
 #include "Utils/Logger.h"
+#include <algorithm>
 
-BindingSetManager::BindingSetManager(ref<Device> pDevice, const std::vector<ReflectionInfo>& reflectionInfo) : mpDevice(pDevice)
+BindingSetManager::BindingSetManager(ref<Device> pDevice, const std::vector<ReflectionInfo>& reflectionInfo)
+    : mpDevice(pDevice), mReflectionInfo(reflectionInfo)
 {
     for (const auto& info : reflectionInfo)
     {
@@ -21,12 +23,28 @@ BindingSetManager::BindingSetManager(ref<Device> pDevice, const std::vector<Refl
                 continue;
             }
 
-            nvrhi::BindingLayoutDesc layoutDesc;
-            layoutDesc.visibility = nvrhi::ShaderType::All;
-            layoutDesc.registerSpace = space;
-            layoutDesc.bindings.push_back(info.bindingLayoutItem);
+            nvrhi::BindingLayoutHandle descriptorTableLayout;
+            if (info.descriptorTableSize == 0)
+            {
+                // Bindless layouts name their register spaces through the slot field of each item
+                nvrhi::BindingLayoutItem spaceItem = info.bindingLayoutItem;
+                spaceItem.slot = space;
 
-            nvrhi::BindingLayoutHandle descriptorTableLayout = mpDevice->getDevice()->createBindingLayout(layoutDesc);
+                nvrhi::BindlessLayoutDesc bindlessDesc;
+                bindlessDesc.visibility = nvrhi::ShaderType::All;
+                bindlessDesc.firstSlot = info.bindingLayoutItem.slot;
+                bindlessDesc.maxCapacity = kMaxUnboundedTableSize;
+                bindlessDesc.registerSpaces.push_back(spaceItem);
+                descriptorTableLayout = mpDevice->getDevice()->createBindlessLayout(bindlessDesc);
+            }
+            else
+            {
+                nvrhi::BindingLayoutDesc layoutDesc;
+                layoutDesc.visibility = nvrhi::ShaderType::All;
+                layoutDesc.registerSpace = space;
+                layoutDesc.bindings.push_back(info.bindingLayoutItem);
+                descriptorTableLayout = mpDevice->getDevice()->createBindingLayout(layoutDesc);
+            }
             if (!descriptorTableLayout)
             {
                 LOG_ERROR("[BindingSetManager] Failed to create binding layout for descriptor table '{}'", info.name);
@@ -40,16 +58,27 @@ BindingSetManager::BindingSetManager(ref<Device> pDevice, const std::vector<Refl
                 continue;
             }
 
-            mpDevice->getDevice()->resizeDescriptorTable(descriptorTable, info.descriptorTableSize, false);
-            LOG_DEBUG("[BindingSetManager] Creating new descriptor table for space {} with size {}", space, info.descriptorTableSize);
+            // Unbounded tables start small and grow in setDescriptorTable once the texture count is known
+            const uint32_t initialSize = info.descriptorTableSize != 0 ? info.descriptorTableSize : kMinUnboundedTableSize;
+            mpDevice->getDevice()->resizeDescriptorTable(descriptorTable, initialSize, false);
+            LOG_DEBUG(
+                "[BindingSetManager] Creating new descriptor table for space {} with size {}{}",
+                space,
+                initialSize,
+                info.descriptorTableSize == 0 ? " (unbounded)" : ""
+            );
 
             DescriptorTableInfo tableInfo;
+            tableInfo.name = info.name;
             tableInfo.space = space;
             tableInfo.index = 0;
             tableInfo.descriptorTable = descriptorTable;
             tableInfo.bindingLayout = descriptorTableLayout;
             tableInfo.size = info.descriptorTableSize;
-            mDescriptorTables[info.name] = tableInfo;
+            tableInfo.contents.resize(initialSize);
+            mDescriptorTables.push_back(std::move(tableInfo));
+            mSlotIds[info.name] = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back({&spaceData, 0, &mDescriptorTables.back()});
 
             spaceData.descriptorTables.push_back(descriptorTable);
             spaceData.bindingLayout = descriptorTableLayout;
@@ -70,7 +99,8 @@ BindingSetManager::BindingSetManager(ref<Device> pDevice, const std::vector<Refl
             const uint32_t index = static_cast<uint32_t>(spaceData.layoutItems.size());
             spaceData.layoutItems.push_back(info.bindingLayoutItem);
             spaceData.bindingSetItems.push_back(info.bindingSetItem);
-            mResourceMap[info.name] = {space, index};
+            mSlotIds[info.name] = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back({&spaceData, index, nullptr});
         }
     }
 
@@ -87,87 +117,176 @@ BindingSetManager::BindingSetManager(ref<Device> pDevice, const std::vector<Refl
     }
 }
 
-std::vector<nvrhi::BindingSetHandle> BindingSetManager::getBindingSets()
+const std::vector<nvrhi::BindingSetHandle>& BindingSetManager::getBindingSets()
 {
-    std::vector<nvrhi::BindingSetHandle> result;
-    result.reserve(mSpaces.size());
+    if (!mIsDirty)
+        return mBindingSets;
 
+    mBindingSets.clear();
     for (auto& [space, data] : mSpaces)
     {
         if (!data.descriptorTables.empty())
         {
-            result.push_back(data.descriptorTables[0]);
+            mBindingSets.push_back(data.descriptorTables[0]);
             continue;
         }
 
         if (data.layoutItems.empty())
             continue;
 
-        nvrhi::BindingSetDesc bindingSetDesc;
-        bindingSetDesc.bindings = data.bindingSetItems;
-
-        size_t hash = 0;
-        nvrhi::hash_combine(hash, bindingSetDesc);
-        nvrhi::hash_combine(hash, data.bindingLayout);
-
-        if (data.currentHash != hash)
+        if (data.isDirty)
         {
-            LOG_DEBUG("[BindingSetManager] Creating new binding set for space {} with hash: {}", space, hash);
-            data.bindingSet = mpDevice->getDevice()->createBindingSet(bindingSetDesc, data.bindingLayout);
-            data.currentHash = hash;
+            data.bindingSet = acquireBindingSet(space, data);
+            data.isDirty = false;
         }
-        result.push_back(data.bindingSet);
+        mBindingSets.push_back(data.bindingSet);
     }
 
-    return result;
+    mIsDirty = false;
+    return mBindingSets;
+}
+
+nvrhi::BindingSetHandle BindingSetManager::acquireBindingSet(uint32_t space, SpaceData& data)
+{
+    std::vector<nvrhi::IResource*> resources(data.bindingSetItems.size());
+    for (size_t i = 0; i < resources.size(); ++i)
+        resources[i] = data.bindingSetItems[i].resourceHandle;
+
+    auto& recent = data.recentBindingSets;
+    auto it = std::find_if(recent.begin(), recent.end(), [&](const CachedBindingSet& cached) { return cached.resources == resources; });
+    if (it != recent.end())
+    {
+        std::rotate(recent.begin(), it, it + 1);
+        return recent.front().bindingSet;
+    }
+
+    nvrhi::BindingSetDesc bindingSetDesc;
+    bindingSetDesc.bindings = data.bindingSetItems;
+    LOG_DEBUG("[BindingSetManager] Creating new binding set for space {}", space);
+    nvrhi::BindingSetHandle bindingSet = mpDevice->getDevice()->createBindingSet(bindingSetDesc, data.bindingLayout);
+    mCreatedBindingSetCount++;
+    if (!bindingSet)
+        return nullptr;
+
+    recent.insert(recent.begin(), {std::move(resources), bindingSet});
+    if (recent.size() > kBindingSetCacheSize)
+        recent.pop_back();
+    return bindingSet;
 }
 
-std::vector<nvrhi::BindingLayoutHandle> BindingSetManager::getBindingLayouts()
+std::vector<nvrhi::BindingLayoutHandle> BindingSetManager::getBindingLayouts() const
 {
     std::vector<nvrhi::BindingLayoutHandle> result;
     result.reserve(mSpaces.size());
-    for (auto& [space, data] : mSpaces)
+    for (const auto& [space, data] : mSpaces)
         if (data.bindingLayout)
             result.push_back(data.bindingLayout);
     return result;
 }
 
+bool BindingSetManager::isCompatible(const std::vector<ReflectionInfo>& reflectionInfo) const
+{
+    return std::equal(
+        mReflectionInfo.begin(),
+        mReflectionInfo.end(),
+        reflectionInfo.begin(),
+        reflectionInfo.end(),
+        [](const ReflectionInfo& a, const ReflectionInfo& b)
+        {
+            return a.name == b.name && a.bindingLayoutItem == b.bindingLayoutItem && a.bindingSpace == b.bindingSpace &&
+                   a.isDescriptorTable == b.isDescriptorTable && a.descriptorTableSize == b.descriptorTableSize;
+        }
+    );
+}
+
+uint32_t BindingSetManager::getSlot(const std::string& name) const
+{
+    auto it = mSlotIds.find(name);
+    return it != mSlotIds.end() ? it->second : kInvalidSlot;
+}
+
+void BindingSetManager::setResourceHandle(uint32_t slot, nvrhi::ResourceHandle resource)
+{
+    if (slot >= mSlots.size())
+        LOG_ERROR_RETURN("[BindingSetManager] Invalid resource slot {}", slot);
+    if (mSlots[slot].pTable)
+        LOG_ERROR_RETURN("[BindingSetManager] '{}' is a descriptor table; use setDescriptorTable", mSlots[slot].pTable->name);
+
+    nvrhi::BindingSetItem& item = mSlots[slot].pSpace->bindingSetItems[mSlots[slot].index];
+    if (item.resourceHandle == resource.Get())
+        return;
+    item.resourceHandle = resource;
+    mSlots[slot].pSpace->isDirty = true;
+    mIsDirty = true;
+}
+
 void BindingSetManager::setResourceHandle(const std::string& name, nvrhi::ResourceHandle resource)
 {
-    auto it = mResourceMap.find(name);
-    if (it == mResourceMap.end())
+    const uint32_t slot = getSlot(name);
+    if (slot == kInvalidSlot)
         LOG_ERROR_RETURN("[BindingSetManager] Resource '{}' not found in layout", name);
-
-    uint32_t space = it->second.first;
-    uint32_t index = it->second.second;
-    mSpaces[space].bindingSetItems[index].resourceHandle = resource;
+    setResourceHandle(slot, resource);
 }
 
 void BindingSetManager::setDescriptorTable(
     const std::string& name,
     const std::vector<nvrhi::TextureHandle>& textures,
-    nvrhi::TextureHandle defaultTexture
+    nvrhi::TextureHandle defaultTexture,
+    uint64_t generation
 )
 {
-    auto it = mDescriptorTables.find(name);
-    if (it == mDescriptorTables.end())
+    const uint32_t slot = getSlot(name);
+    if (slot == kInvalidSlot || !mSlots[slot].pTable)
         LOG_ERROR_RETURN("[BindingSetManager] Descriptor table '{}' not found", name);
+    setDescriptorTable(slot, textures, defaultTexture, generation);
+}
+
+void BindingSetManager::setDescriptorTable(
+    uint32_t slot,
+    const std::vector<nvrhi::TextureHandle>& textures,
+    nvrhi::TextureHandle defaultTexture,
+    uint64_t generation
+)
+{
+    if (slot >= mSlots.size() || !mSlots[slot].pTable)
+        LOG_ERROR_RETURN("[BindingSetManager] Slot {} is not a descriptor table", slot);
 
-    DescriptorTableInfo& tableInfo = it->second;
+    DescriptorTableInfo& tableInfo = *mSlots[slot].pTable;
+    const std::string& name = tableInfo.name;
+    if (generation != 0 && generation == tableInfo.generation)
+        return;
 
-    for (size_t i = 0; i < textures.size(); ++i)
+    size_t count = textures.size();
+    if (tableInfo.size != 0 && count > tableInfo.size)
     {
-        nvrhi::BindingSetItem item = nvrhi::BindingSetItem::Texture_SRV(static_cast<uint32_t>(i), textures[i]);
-        if (!mpDevice->getDevice()->writeDescriptorTable(tableInfo.descriptorTable, item))
-            LOG_ERROR("[BindingSetManager] Failed to write texture {} to descriptor table '{}'", i, name);
+        LOG_WARN("[BindingSetManager] {} textures exceed the {} slots of descriptor table '{}'", count, tableInfo.size, name);
+        count = tableInfo.size;
     }
 
-    // Fill unused slots with default texture — bindless arrays require every slot
-    // to be written even if unused; unbound descriptors crash the GPU.
-    for (size_t i = textures.size(); i < tableInfo.size; ++i)
+    if (tableInfo.size == 0 && count > tableInfo.contents.size())
     {
-        nvrhi::BindingSetItem item = nvrhi::BindingSetItem::Texture_SRV(static_cast<uint32_t>(i), defaultTexture);
+        size_t newSize = tableInfo.contents.size();
+        while (newSize < count)
+            newSize *= 2;
+        if (newSize > kMaxUnboundedTableSize)
+            LOG_ERROR_RETURN("[BindingSetManager] {} textures exceed the bindless limit of {}", count, kMaxUnboundedTableSize);
+        mpDevice->getDevice()->resizeDescriptorTable(tableInfo.descriptorTable, static_cast<uint32_t>(newSize), true);
+        tableInfo.contents.resize(newSize);
+        LOG_DEBUG("[BindingSetManager] Grew descriptor table '{}' to {} slots", name, newSize);
+    }
+
+    // Every allocated slot holds a valid texture, since unbound descriptors crash the GPU: slots past the list
+    // get the default texture. Each slot is written only when it changes, so newly created slots are filled once.
+    for (size_t i = 0; i < tableInfo.contents.size(); ++i)
+    {
+        nvrhi::TextureHandle texture = i < count && textures[i] ? textures[i] : defaultTexture;
+        if (tableInfo.contents[i] == texture)
+            continue;
+
+        nvrhi::BindingSetItem item = nvrhi::BindingSetItem::Texture_SRV(static_cast<uint32_t>(i), texture);
         if (!mpDevice->getDevice()->writeDescriptorTable(tableInfo.descriptorTable, item))
-            LOG_ERROR("[BindingSetManager] Failed to write default texture to slot {} in descriptor table '{}'", i, name);
+            LOG_ERROR("[BindingSetManager] Failed to write texture {} to descriptor table '{}'", i, name);
+        tableInfo.contents[i] = texture;
     }
+    tableInfo.generation = generation;
 }
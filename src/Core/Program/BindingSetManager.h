@@ -1,5 +1,6 @@
 #pragma once
 #include <nvrhi/nvrhi.h>
+#include <deque>
 #include <map>
 #include <vector>
 #include <unordered_map>
@@ -12,26 +13,81 @@
 // ParameterBlock<> convention gives each bindless array its own space, so this
 // lines up with how shaders in this project are written (see gMaterialTextures
 // / gMaterialSampler in Material.slang). The constructor asserts this.
+//
+// Sized arrays (T[N]) get a table of N slots; unbounded arrays (T[]) get a bindless layout and a
+// table that grows with the texture list. Slots are only rewritten when their texture changes.
+//
+// Resource names resolve once to integer slots. Assigning the resource a slot already holds is a
+// no-op; a change marks its space dirty, and only dirty spaces look for a new binding set. Each space
+// keeps its most recently used sets, so alternating between a few resources (e.g. ping-pong targets)
+// reuses them instead of creating a set per frame.
 class BindingSetManager
 {
 public:
+    static constexpr uint32_t kInvalidSlot = 0xFFFFFFFF;
+
     BindingSetManager(ref<Device> device, const std::vector<ReflectionInfo>& reflectionInfo);
 
-    std::vector<nvrhi::BindingSetHandle> getBindingSets();
-    std::vector<nvrhi::BindingLayoutHandle> getBindingLayouts();
+    // Binding set (or descriptor table) per space; cached until a resource changes
+    const std::vector<nvrhi::BindingSetHandle>& getBindingSets();
+    std::vector<nvrhi::BindingLayoutHandle> getBindingLayouts() const;
+
+    // True if a recompiled program reflects the same bindings, so its pipeline can reuse these layouts and slots
+    bool isCompatible(const std::vector<ReflectionInfo>& reflectionInfo) const;
 
+    // Slot of a resource by its reflected name (e.g. "gScene.vertices"); kInvalidSlot if the program has none
+    uint32_t getSlot(const std::string& name) const;
+
+    void setResourceHandle(uint32_t slot, nvrhi::ResourceHandle resource);
     void setResourceHandle(const std::string& name, nvrhi::ResourceHandle resource);
 
-    void setDescriptorTable(const std::string& name, const std::vector<nvrhi::TextureHandle>& textures, nvrhi::TextureHandle defaultTexture);
+    /*
+        Point the slots of a descriptor table at textures; slots past the list (and null entries) get defaultTexture.
+        The table is addressed by the slot getSlot returns for its name, or by the name itself for one-off updates.
+        \param generation Version of the texture list, bumped by its owner on every change (e.g. TextureManager::getGeneration).
+               A repeated generation returns without touching the table; 0 compares every slot instead.
+    */
+    void setDescriptorTable(
+        uint32_t slot,
+        const std::vector<nvrhi::TextureHandle>& textures,
+        nvrhi::TextureHandle defaultTexture,
+        uint64_t generation = 0
+    );
+    void setDescriptorTable(
+        const std::string& name,
+        const std::vector<nvrhi::TextureHandle>& textures,
+        nvrhi::TextureHandle defaultTexture,
+        uint64_t generation = 0
+    );
+
+    // Binding sets created since construction; stays flat while a pass cycles through cached resources
+    uint64_t getCreatedBindingSetCount() const { return mCreatedBindingSetCount; }
 
 private:
+    // Binding sets remembered per space
+    static constexpr size_t kBindingSetCacheSize = 4;
+
+    // Initial slot count of an unbounded table; it doubles whenever the texture list outgrows it
+    static constexpr uint32_t kMinUnboundedTableSize = 256;
+    // Upper bound of an unbounded table (the root signature range itself is unbounded on D3D12)
+    static constexpr uint32_t kMaxUnboundedTableSize = 1u << 20;
+
     struct DescriptorTableInfo
     {
+        std::string name;
         uint32_t space;
         uint32_t index;
         nvrhi::DescriptorTableHandle descriptorTable;
         nvrhi::BindingLayoutHandle bindingLayout;
-        uint32_t size;
+        uint32_t size;                              // Declared array size; 0 for unbounded arrays
+        uint64_t generation = 0;                    // Texture list generation the table was last written for
+        std::vector<nvrhi::TextureHandle> contents; // Texture in each allocated slot; null until first written
+    };
+
+    struct CachedBindingSet
+    {
+        std::vector<nvrhi::IResource*> resources; // Resource of each binding set item, in item order
+        nvrhi::BindingSetHandle bindingSet;       // Holds references to those resources
     };
 
     struct SpaceData
@@ -40,13 +96,29 @@ private:
         std::vector<nvrhi::BindingLayoutItem> layoutItems;
         std::vector<nvrhi::BindingSetItem> bindingSetItems;
         nvrhi::BindingSetHandle bindingSet;
-        size_t currentHash = 0;
+        bool isDirty = true;
+        std::vector<CachedBindingSet> recentBindingSets; // Most recently used first
 
         std::vector<nvrhi::DescriptorTableHandle> descriptorTables;
     };
 
+    struct Slot
+    {
+        SpaceData* pSpace; // std::map nodes never move
+        uint32_t index;
+        DescriptorTableInfo* pTable; // Set for descriptor tables, which have no binding set item; deque elements never move
+    };
+
+    // Binding set for the current items of a space, from the cache or newly created
+    nvrhi::BindingSetHandle acquireBindingSet(uint32_t space, SpaceData& data);
+
     ref<Device> mpDevice;
+    std::vector<ReflectionInfo> mReflectionInfo;
     std::map<uint32_t, SpaceData> mSpaces;
-    std::unordered_map<std::string, std::pair<uint32_t, uint32_t>> mResourceMap;
-    std::unordered_map<std::string, DescriptorTableInfo> mDescriptorTables;
+    std::vector<Slot> mSlots;
+    std::unordered_map<std::string, uint32_t> mSlotIds;
+    std::vector<nvrhi::BindingSetHandle> mBindingSets;
+    bool mIsDirty = true;
+    uint64_t mCreatedBindingSetCount = 0;
+    std::deque<DescriptorTableInfo> mDescriptorTables;
 };
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "Program.h"
 #include "ShaderCompiler.h"
+#include "Utils/Hash.h"
+#include <algorithm>
+#include <iterator>
 
 namespace
 {
@@ -198,10 +201,9 @@ void walk(const AccessPath& path, std::vector<ReflectionInfo>& out)
 
         ReflectionInfo info;
         info.name = name;
-        // TODO: every constant buffer we treat as volatile for now
-        info.bindingLayoutItem = nvrhi::BindingLayoutItem::VolatileConstantBuffer(slot);
+        // Non-volatile: a buffer keeps its contents across frames, so Pass uploads it only when they change
+        info.bindingLayoutItem = nvrhi::BindingLayoutItem::ConstantBuffer(slot);
         info.bindingSetItem = nvrhi::BindingSetItem::ConstantBuffer(slot, nullptr);
-        info.bindingSetItem.type = nvrhi::ResourceType::VolatileConstantBuffer;
         info.bindingSpace = offset.space;
         LOG_DEBUG("[ShaderBinding] Found constant buffer: {} at slot {} in space {}", name, slot, offset.space);
         out.push_back(std::move(info));
@@ -283,7 +285,9 @@ void walk(const AccessPath& path, std::vector<ReflectionInfo>& out)
             return;
         }
 
-        const auto elementCount = static_cast<uint32_t>(typeLayout->getElementCount());
+        // Unbounded arrays (T[]) report SLANG_UNBOUNDED_SIZE and get a register space of their own
+        const bool isUnbounded = typeLayout->getElementCount() == SLANG_UNBOUNDED_SIZE;
+        const auto elementCount = isUnbounded ? 0u : static_cast<uint32_t>(typeLayout->getElementCount());
         const SlangResourceShape shape = elementType->getResourceShape();
         const SlangResourceAccess access = elementType->getResourceAccess();
 
@@ -305,13 +309,18 @@ void walk(const AccessPath& path, std::vector<ReflectionInfo>& out)
 
         const auto category =
             (access == SLANG_RESOURCE_ACCESS_READ) ? slang::ParameterCategory::ShaderResource : slang::ParameterCategory::UnorderedAccess;
-        const auto offset = computeCumulativeOffset(path, category);
+        auto offset = computeCumulativeOffset(path, category);
+        if (isUnbounded)
+        {
+            for (auto node = path.leaf; node != path.deepestParameterBlock; node = node->outer)
+                offset.space += static_cast<uint32_t>(node->varLayout->getOffset(slang::ParameterCategory::SubElementRegisterSpace));
+        }
 
         nvrhi::BindingLayoutItem layoutItem;
         nvrhi::BindingSetItem bindingItem;
         if (!makeResourceBinding(shape, access, offset.offset, layoutItem, bindingItem))
             return;
-        layoutItem.setSize(elementCount);
+        layoutItem.setSize(isUnbounded ? 1 : elementCount);
 
         ReflectionInfo info;
         info.name = name;
@@ -354,13 +363,32 @@ Program::Program(
     const std::string& filePath,
     const std::unordered_map<std::string, nvrhi::ShaderType>& entryPoints,
     const std::string& profile,
-    const std::vector<std::pair<std::string, std::string>>& defines
+    const std::vector<std::pair<std::string, std::string>>& defines,
+    const std::vector<LinkTimeConstant>& linkTimeConstants,
+    bool useCachedEntry
 )
 {
     if (entryPoints.empty())
         LOG_ERROR_THROW("[Program] No entry points provided");
 
-    slang::ISession* pSession = ShaderCompiler::get().getSession(profile, defines);
+    std::string linkTimeSource;
+    for (const LinkTimeConstant& constant : linkTimeConstants)
+        linkTimeSource += fmt::format("export static const {} {} = {};\n", constant.type, constant.name, constant.value);
+
+    ShaderCache::Key cacheKey;
+    cacheKey.filePath = filePath;
+    cacheKey.profile = profile;
+    cacheKey.sortedDefines = defines;
+    std::sort(cacheKey.sortedDefines.begin(), cacheKey.sortedDefines.end());
+    cacheKey.sortedEntryPoints.assign(entryPoints.begin(), entryPoints.end());
+    std::sort(cacheKey.sortedEntryPoints.begin(), cacheKey.sortedEntryPoints.end());
+    cacheKey.linkTimeSource = linkTimeSource;
+    cacheKey.compilerVersion = ShaderCompiler::get().getCompilerVersion();
+    if (useCachedEntry && loadFromCache(device, cacheKey, entryPoints))
+        return;
+
+    mCompilerLease = ShaderCompiler::get().acquire();
+    slang::ISession* pSession = mCompilerLease.getSession(profile, defines);
     if (!pSession)
         LOG_ERROR_THROW("[Program] Failed to obtain Slang session for profile: {}", profile);
 
@@ -372,6 +400,22 @@ Program::Program(
         LOG_DEBUG("[Program] Compilation diagnostics: {}", (const char*)pDiagnostics->getBufferPointer());
     if (!pModule)
         LOG_ERROR_THROW("[Slang] Failed to load module: {}", filePath);
+    mCompilerLease.storePrecompiledModules(pSession, pModule);
+
+    // Hash every file the module read (imports and includes) now, right after Slang read them: hashes taken at
+    // save time would pair this code with an edit made while it compiled and hide that edit from the cache
+    std::vector<ShaderCache::Dependency> dependencies(pModule->getDependencyFileCount());
+    bool isCacheable = true;
+    for (size_t i = 0; i < dependencies.size(); ++i)
+    {
+        dependencies[i].path = pModule->getDependencyFilePath(static_cast<SlangInt32>(i));
+        mDependencies.push_back(dependencies[i].path);
+        if (!ShaderCache::hashDependency(dependencies[i]))
+        {
+            LOG_WARN("[Program] Not caching '{}': failed to read dependency '{}'", filePath, dependencies[i].path);
+            isCacheable = false;
+        }
+    }
 
     std::vector<Slang::ComPtr<slang::IEntryPoint>> slangEntryPoints;
     slangEntryPoints.reserve(entryPoints.size());
@@ -385,8 +429,22 @@ Program::Program(
     }
 
     std::vector<slang::IComponentType*> components;
-    components.reserve(1 + slangEntryPoints.size());
+    components.reserve(2 + slangEntryPoints.size());
     components.push_back(pModule);
+
+    // Each set of link-time constants is its own small module, named by content so a session can hold all of them
+    if (!linkTimeSource.empty())
+    {
+        const std::string moduleName = fmt::format("LinkTimeConstants_{:016x}", Hash::hash64(linkTimeSource.data(), linkTimeSource.size()));
+        slang::IModule* pConstantsModule = pSession->loadModuleFromSourceString(
+            moduleName.c_str(), (moduleName + ".slang").c_str(), linkTimeSource.c_str(), pDiagnostics.writeRef()
+        );
+        if (pDiagnostics && pDiagnostics->getBufferSize() > 0)
+            LOG_DEBUG("[Program] Link-time constants diagnostics: {}", (const char*)pDiagnostics->getBufferPointer());
+        if (!pConstantsModule)
+            LOG_ERROR_THROW("[Slang] Failed to load link-time constants for: {}", filePath);
+        components.push_back(pConstantsModule);
+    }
     for (auto& entryPoint : slangEntryPoints)
         components.push_back(entryPoint);
 
@@ -403,6 +461,7 @@ Program::Program(
     if (!mpProgramLayout)
         LOG_ERROR_THROW("[Slang] Failed to get program layout");
 
+    ShaderCache::Entry cacheEntry;
     mShaders.clear();
     mShaders.reserve(entryPoints.size());
     mEntryPointToShaderIndex.clear();
@@ -424,16 +483,12 @@ Program::Program(
 
         LOG_DEBUG("[Program] Compiled entry point {}: {} bytes", entryPointName, pKernelBlob->getBufferSize());
 
-        nvrhi::ShaderDesc desc;
-        desc.entryName = entryPointName.c_str();
-        desc.shaderType = entryPointType;
-        auto pShader = device->createShader(desc, pKernelBlob->getBufferPointer(), pKernelBlob->getBufferSize());
-        if (!pShader)
-            LOG_ERROR_THROW("[Program] Failed to create shader for entry point: {}", entryPointName);
-
-        mShaders.push_back(pShader);
+        mShaders.push_back(createShader(device, entryPointName, entryPointType, pKernelBlob->getBufferPointer(), pKernelBlob->getBufferSize()));
         mEntryPointToShaderIndex[entryPointName] = entryPointIndex;
         entryPointIndex++;
+
+        const uint8_t* pCode = static_cast<const uint8_t*>(pKernelBlob->getBufferPointer());
+        cacheEntry.kernels.push_back({entryPointName, std::vector<uint8_t>(pCode, pCode + pKernelBlob->getBufferSize())});
     }
 
     LOG_DEBUG("[Program] Successfully loaded shader with {} entry points from: {}", entryPoints.size(), filePath);
@@ -442,6 +497,75 @@ Program::Program(
     const auto entryPointCount = mpProgramLayout->getEntryPointCount();
     for (unsigned int i = 0; i < entryPointCount; i++)
         walkScope(mpProgramLayout->getEntryPointByIndex(i)->getVarLayout(), mReflectionInfo);
+
+    if (entryPointCount > 0)
+    {
+        SlangUInt threadGroupSize[3] = {1, 1, 1};
+        mpProgramLayout->getEntryPointByIndex(0)->getComputeThreadGroupSize(3, threadGroupSize);
+        for (int i = 0; i < 3; ++i)
+            mThreadGroupSize[i] = static_cast<uint32_t>(threadGroupSize[i]);
+    }
+
+    cacheEntry.reflectionInfo = mReflectionInfo;
+    std::copy(std::begin(mThreadGroupSize), std::end(mThreadGroupSize), cacheEntry.threadGroupSize);
+    cacheEntry.dependencies = std::move(dependencies);
+    if (isCacheable)
+        ShaderCache::save(cacheKey, cacheEntry);
+}
+
+bool Program::loadFromCache(
+    nvrhi::IDevice* device,
+    const ShaderCache::Key& key,
+    const std::unordered_map<std::string, nvrhi::ShaderType>& entryPoints
+)
+{
+    ShaderCache::Entry entry;
+    if (!ShaderCache::load(key, entry))
+        return false;
+
+    std::vector<nvrhi::ShaderHandle> shaders;
+    std::unordered_map<std::string, size_t> entryPointToShaderIndex;
+    for (const auto& [entryPointName, entryPointType] : entryPoints)
+    {
+        auto it = std::find_if(
+            entry.kernels.begin(), entry.kernels.end(), [&](const ShaderCache::Kernel& kernel) { return kernel.entryPoint == entryPointName; }
+        );
+        if (it == entry.kernels.end())
+        {
+            LOG_WARN("[Program] Cached shader for {} lacks entry point {}, recompiling", key.filePath, entryPointName);
+            return false;
+        }
+        entryPointToShaderIndex[entryPointName] = shaders.size();
+        shaders.push_back(createShader(device, entryPointName, entryPointType, it->code.data(), it->code.size()));
+    }
+
+    mShaders = std::move(shaders);
+    mEntryPointToShaderIndex = std::move(entryPointToShaderIndex);
+    mReflectionInfo = std::move(entry.reflectionInfo);
+    mDependencies.clear();
+    for (ShaderCache::Dependency& dependency : entry.dependencies)
+        mDependencies.push_back(std::move(dependency.path));
+    std::copy(std::begin(entry.threadGroupSize), std::end(entry.threadGroupSize), mThreadGroupSize);
+    mIsFromCache = true;
+    LOG_DEBUG("[Program] Loaded {} entry points of {} from the shader cache", entryPoints.size(), key.filePath);
+    return true;
+}
+
+nvrhi::ShaderHandle Program::createShader(
+    nvrhi::IDevice* device,
+    const std::string& entryPoint,
+    nvrhi::ShaderType type,
+    const void* pCode,
+    size_t bytes
+)
+{
+    nvrhi::ShaderDesc desc;
+    desc.entryName = entryPoint.c_str();
+    desc.shaderType = type;
+    auto pShader = device->createShader(desc, pCode, bytes);
+    if (!pShader)
+        LOG_ERROR_THROW("[Program] Failed to create shader for entry point: {}", entryPoint);
+    return pShader;
 }
 
 nvrhi::ShaderHandle Program::getShader(const std::string& entryPoint) const
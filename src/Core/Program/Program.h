@@ -10,6 +10,17 @@
 
 #include "Utils/Logger.h"
 #include "Core/Program/ReflectionInfo.h"
+#include "Core/Program/ShaderCache.h"
+#include "Core/Program/ShaderCompiler.h"
+
+// Value for an `extern static const` declared by the program's modules, supplied at link time. Unlike a
+// define, changing one keeps the session and its checked modules; only linking and code generation rerun.
+struct LinkTimeConstant
+{
+    std::string type; // Slang type, e.g. "bool" or "uint"
+    std::string name;
+    std::string value; // Slang expression, e.g. "true"
+};
 
 class Program
 {
@@ -19,11 +30,19 @@ public:
         const std::string& filePath,
         const std::unordered_map<std::string, nvrhi::ShaderType>& entryPoints,
         const std::string& profile,
-        const std::vector<std::pair<std::string, std::string>>& defines = {}
+        const std::vector<std::pair<std::string, std::string>>& defines = {},
+        const std::vector<LinkTimeConstant>& linkTimeConstants = {},
+        bool useCachedEntry = true // False compiles even if the ShaderCache holds an entry, e.g. after an edit
     );
 
     nvrhi::ShaderHandle getShader(const std::string& entryPoint) const;
+    // Null when the program was restored from the ShaderCache; Slang never ran
     slang::ProgramLayout* getProgramLayout() const { return mpProgramLayout; }
+    // Thread group size of the first entry point (compute shaders); {1, 1, 1} otherwise
+    const uint32_t* getThreadGroupSize() const { return mThreadGroupSize; }
+    bool isFromCache() const { return mIsFromCache; }
+    // Every source file the program read, main file, imports and includes
+    const std::vector<std::string>& getDependencies() const { return mDependencies; }
     const std::vector<nvrhi::ShaderHandle>& getShaders() const { return mShaders; }
     const std::vector<ReflectionInfo>& getReflectionInfo() const { return mReflectionInfo; }
 
@@ -31,10 +50,19 @@ public:
     void printReflectionInfo() const;
 
 private:
+    // Create shaders and bindings from a cached entry; false on a miss
+    bool loadFromCache(nvrhi::IDevice* device, const ShaderCache::Key& key, const std::unordered_map<std::string, nvrhi::ShaderType>& entryPoints);
+    nvrhi::ShaderHandle createShader(nvrhi::IDevice* device, const std::string& entryPoint, nvrhi::ShaderType type, const void* pCode, size_t bytes);
+
+    // Declared first so the Slang objects below are released while the context is still leased
+    ShaderCompiler::Lease mCompilerLease;
     Slang::ComPtr<slang::IComponentType> mLinkedProgram;
     slang::ProgramLayout* mpProgramLayout = nullptr;
 
     std::vector<nvrhi::ShaderHandle> mShaders;                        // All shaders
     std::unordered_map<std::string, size_t> mEntryPointToShaderIndex; // Map entry point names to shader indices
     std::vector<ReflectionInfo> mReflectionInfo;
+    uint32_t mThreadGroupSize[3] = {1, 1, 1};
+    std::vector<std::string> mDependencies;
+    bool mIsFromCache = false;
 };
@@ -0,0 +1,341 @@
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#include "ShaderCache.h"
+#include "Utils/Hash.h"
+#include "Utils/Logger.h"
+
+namespace
+{
+constexpr char kMagic[8] = {'0', '0', '7', 'S', 'H', 'A', 'D', 'R'};
+// Bump when the on-disk layout below, or the meaning of the reflected bindings it stores, changes.
+constexpr uint32_t kFormatVersion = 2;
+
+#ifdef _DEBUG
+constexpr uint32_t kBuildConfig = 1; // Debug sessions emit unoptimized code with full debug info
+#else
+constexpr uint32_t kBuildConfig = 0;
+#endif
+
+struct CacheHeader
+{
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t buildConfig;
+    uint64_t keyHash; // Full key hash; the file name only carries it, so a path collision is still caught here
+
+    // Strides guard against silent layout changes of the NVRHI binding structs stored verbatim.
+    uint32_t layoutItemStride;
+    uint32_t bindingSetItemStride;
+};
+
+std::atomic<uint32_t> sHits{0};
+std::atomic<uint32_t> sMisses{0};
+std::atomic<bool> sEnabled{true};
+
+uint64_t hashString(uint64_t seed, const std::string& value)
+{
+    return Hash::combine(seed, Hash::hash64(value.data(), value.size()));
+}
+
+uint64_t hashKey(const ShaderCache::Key& key)
+{
+    uint64_t h = hashString(kFormatVersion, key.filePath);
+    h = hashString(h, key.profile);
+    h = hashString(h, key.linkTimeSource);
+    h = hashString(h, key.compilerVersion);
+    h = Hash::combine(h, kBuildConfig);
+    for (const auto& [name, value] : key.sortedDefines)
+        h = hashString(hashString(h, name), value);
+    for (const auto& [name, type] : key.sortedEntryPoints)
+        h = Hash::combine(hashString(h, name), static_cast<uint64_t>(type));
+    return h;
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& out)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+        return false;
+    out.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    return !stream.bad();
+}
+
+class ByteWriter
+{
+public:
+    template<typename T>
+    void write(const T& value)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+        mData.insert(mData.end(), p, p + sizeof(T));
+    }
+
+    void writeBytes(const void* pData, size_t sizeBytes)
+    {
+        write(static_cast<uint64_t>(sizeBytes));
+        const uint8_t* p = static_cast<const uint8_t*>(pData);
+        mData.insert(mData.end(), p, p + sizeBytes);
+    }
+
+    void writeString(const std::string& value) { writeBytes(value.data(), value.size()); }
+
+    const std::vector<uint8_t>& data() const { return mData; }
+
+private:
+    std::vector<uint8_t> mData;
+};
+
+// Bounds-checked reader; every read fails once the data runs out, so callers check only at the end.
+class ByteReader
+{
+public:
+    ByteReader(const uint8_t* pData, size_t sizeBytes) : mpData(pData), mSize(sizeBytes) {}
+
+    template<typename T>
+    bool read(T& value)
+    {
+        if (!mIsValid || mSize - mCursor < sizeof(T))
+            return mIsValid = false;
+        std::memcpy(&value, mpData + mCursor, sizeof(T));
+        mCursor += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(std::vector<uint8_t>& out)
+    {
+        uint64_t size = 0;
+        if (!read(size) || mSize - mCursor < size)
+            return mIsValid = false;
+        out.assign(mpData + mCursor, mpData + mCursor + size);
+        mCursor += size;
+        return true;
+    }
+
+    bool readString(std::string& out)
+    {
+        uint64_t size = 0;
+        if (!read(size) || mSize - mCursor < size)
+            return mIsValid = false;
+        out.assign(reinterpret_cast<const char*>(mpData + mCursor), size);
+        mCursor += size;
+        return true;
+    }
+
+    bool isValid() const { return mIsValid; }
+
+private:
+    const uint8_t* mpData;
+    size_t mSize;
+    size_t mCursor = 0;
+    bool mIsValid = true;
+};
+
+bool miss()
+{
+    sMisses++;
+    return false;
+}
+} // namespace
+
+namespace ShaderCache
+{
+bool hashDependency(Dependency& dependency)
+{
+    std::vector<uint8_t> contents;
+    if (!readFile(dependency.path, contents))
+        return false;
+    dependency.hash = Hash::hash64(contents.data(), contents.size());
+    dependency.size = contents.size();
+    return true;
+}
+
+std::string getCachePath(const Key& key)
+{
+    const std::string stem = std::filesystem::path(key.filePath).stem().string();
+    return fmt::format("{}/shaders/{}-{:016x}.shcache", PROJECT_CACHE_DIR, stem, hashKey(key));
+}
+
+bool load(const Key& key, Entry& outEntry)
+{
+    if (!sEnabled)
+        return miss();
+
+    const std::string cachePath = getCachePath(key);
+    std::vector<uint8_t> file;
+    std::error_code ec;
+    if (!std::filesystem::exists(cachePath, ec) || !readFile(cachePath, file) || file.size() < sizeof(CacheHeader))
+        return miss();
+
+    CacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.formatVersion != kFormatVersion || header.buildConfig != kBuildConfig ||
+        header.keyHash != hashKey(key) || header.layoutItemStride != sizeof(nvrhi::BindingLayoutItem) ||
+        header.bindingSetItemStride != sizeof(nvrhi::BindingSetItem))
+    {
+        LOG_DEBUG("[ShaderCache] '{}' was written by a different build, recompiling", cachePath);
+        return miss();
+    }
+
+    ByteReader reader(file.data() + sizeof(header), file.size() - sizeof(header));
+    Entry entry;
+    reader.read(entry.threadGroupSize);
+
+    uint32_t dependencyCount = 0;
+    reader.read(dependencyCount);
+    for (uint32_t i = 0; i < dependencyCount && reader.isValid(); ++i)
+    {
+        Dependency cached;
+        reader.readString(cached.path);
+        reader.read(cached.hash);
+        reader.read(cached.size);
+        if (!reader.isValid())
+            break;
+
+        Dependency current{cached.path};
+        if (!hashDependency(current) || current.hash != cached.hash || current.size != cached.size)
+        {
+            LOG_DEBUG("[ShaderCache] '{}' is stale: '{}' changed", cachePath, cached.path);
+            return miss();
+        }
+        entry.dependencies.push_back(std::move(cached));
+    }
+
+    uint32_t kernelCount = 0;
+    reader.read(kernelCount);
+    for (uint32_t i = 0; i < kernelCount && reader.isValid(); ++i)
+    {
+        Kernel kernel;
+        reader.readString(kernel.entryPoint);
+        reader.readBytes(kernel.code);
+        entry.kernels.push_back(std::move(kernel));
+    }
+
+    uint32_t reflectionCount = 0;
+    reader.read(reflectionCount);
+    for (uint32_t i = 0; i < reflectionCount && reader.isValid(); ++i)
+    {
+        ReflectionInfo info;
+        uint8_t isDescriptorTable = 0;
+        reader.readString(info.name);
+        reader.read(info.bindingLayoutItem);
+        reader.read(info.bindingSetItem);
+        reader.read(info.bindingSpace);
+        reader.read(isDescriptorTable);
+        reader.read(info.descriptorTableSize);
+        info.bindingSetItem.resourceHandle = nullptr;
+        info.isDescriptorTable = isDescriptorTable != 0;
+        entry.reflectionInfo.push_back(std::move(info));
+    }
+
+    if (!reader.isValid())
+    {
+        LOG_WARN("[ShaderCache] '{}' is truncated, recompiling", cachePath);
+        return miss();
+    }
+
+    outEntry = std::move(entry);
+    sHits++;
+    return true;
+}
+
+bool save(const Key& key, const Entry& entry)
+{
+    if (!sEnabled)
+        return false;
+
+    CacheHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.formatVersion = kFormatVersion;
+    header.buildConfig = kBuildConfig;
+    header.keyHash = hashKey(key);
+    header.layoutItemStride = sizeof(nvrhi::BindingLayoutItem);
+    header.bindingSetItemStride = sizeof(nvrhi::BindingSetItem);
+
+    ByteWriter writer;
+    writer.write(header);
+    writer.write(entry.threadGroupSize);
+
+    writer.write(static_cast<uint32_t>(entry.dependencies.size()));
+    for (const Dependency& dependency : entry.dependencies)
+    {
+        writer.writeString(dependency.path);
+        writer.write(dependency.hash);
+        writer.write(dependency.size);
+    }
+
+    writer.write(static_cast<uint32_t>(entry.kernels.size()));
+    for (const Kernel& kernel : entry.kernels)
+    {
+        writer.writeString(kernel.entryPoint);
+        writer.writeBytes(kernel.code.data(), kernel.code.size());
+    }
+
+    writer.write(static_cast<uint32_t>(entry.reflectionInfo.size()));
+    for (const ReflectionInfo& info : entry.reflectionInfo)
+    {
+        nvrhi::BindingSetItem bindingSetItem = info.bindingSetItem;
+        bindingSetItem.resourceHandle = nullptr;
+        writer.writeString(info.name);
+        writer.write(info.bindingLayoutItem);
+        writer.write(bindingSetItem);
+        writer.write(info.bindingSpace);
+        writer.write(static_cast<uint8_t>(info.isDescriptorTable ? 1 : 0));
+        writer.write(info.descriptorTableSize);
+    }
+
+    const std::string cachePath = getCachePath(key);
+    // Per-thread temp file: passes built concurrently may compile the same program at once
+    const std::string tempPath = fmt::format("{}.{}.tmp", cachePath, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(writer.data().data()), static_cast<std::streamsize>(writer.data().size()));
+        stream.close();
+        if (stream.fail())
+        {
+            LOG_WARN("[ShaderCache] Failed writing '{}'", tempPath);
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    // Publish atomically so an interrupted write never leaves a half-written entry behind.
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        LOG_WARN("[ShaderCache] Failed to move '{}' into place: {}", tempPath, ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    LOG_DEBUG("[ShaderCache] Wrote '{}' ({} bytes)", cachePath, writer.data().size());
+    return true;
+}
+
+Stats getStats()
+{
+    return {sHits.load(), sMisses.load()};
+}
+
+void resetStats()
+{
+    sHits = 0;
+    sMisses = 0;
+}
+
+void setEnabled(bool enabled)
+{
+    sEnabled = enabled;
+}
+
+bool isEnabled()
+{
+    return sEnabled;
+}
+} // namespace ShaderCache
@@ -0,0 +1,83 @@
+#pragma once
+#include <nvrhi/nvrhi.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Core/Program/ReflectionInfo.h"
+
+/*
+    Persistent shader cache. Stores the compiled kernels, reflected bindings and thread group size of a
+    Program under <PROJECT_CACHE_DIR>/shaders, so a warm start creates shaders straight from disk without
+    touching Slang. An entry is keyed by everything that changes code generation (source path, profile,
+    sorted defines, entry points, link-time constants, Slang build tag, build configuration) and remembers
+    the content hash of every file the module read, including imported modules and includes, taken when
+    the program compiled them; any later edit makes it stale.
+*/
+namespace ShaderCache
+{
+struct Key
+{
+    std::string filePath;
+    std::string profile;
+    std::vector<std::pair<std::string, std::string>> sortedDefines;
+    std::vector<std::pair<std::string, nvrhi::ShaderType>> sortedEntryPoints;
+    std::string linkTimeSource; // Module defining the program's link-time constants; empty if it has none
+    std::string compilerVersion;
+};
+
+struct Kernel
+{
+    std::string entryPoint;
+    std::vector<uint8_t> code;
+};
+
+struct Dependency
+{
+    std::string path;
+    uint64_t hash = 0;
+    uint64_t size = 0;
+};
+
+struct Entry
+{
+    std::vector<Kernel> kernels;
+    std::vector<ReflectionInfo> reflectionInfo;
+    uint32_t threadGroupSize[3] = {1, 1, 1};
+    std::vector<Dependency> dependencies; // Every source file the module read, main file included
+};
+
+struct Stats
+{
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+};
+
+// Cache file location for a key: <PROJECT_CACHE_DIR>/shaders/<stem>-<key hash>.shcache
+std::string getCachePath(const Key& key);
+
+/*
+    Load a cached entry
+    \return True on a hit; false if the entry is missing, stale or corrupt (counted as a miss)
+*/
+bool load(const Key& key, Entry& outEntry);
+
+// Fill hash and size of a dependency from its contents on disk; false if it cannot be read
+bool hashDependency(Dependency& dependency);
+
+/*
+    Write an entry with the dependency hashes it carries; hash them when the files are compiled, so an edit made
+    while compiling leaves the entry stale
+    \return True if the cache file was written
+*/
+bool save(const Key& key, const Entry& entry);
+
+// Lookups since startup (or the last resetStats)
+Stats getStats();
+void resetStats();
+
+// Disabled caches miss without touching the disk and never write, e.g. to time a cold compile
+void setEnabled(bool enabled);
+bool isEnabled();
+} // namespace ShaderCache
@@ -1,7 +1,107 @@
 #include "ShaderCompiler.h"
+#include "Utils/Hash.h"
 #include "Utils/Logger.h"
 #include <nvrhi/nvrhi.h>
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+namespace
+{
+#ifdef _DEBUG
+constexpr uint64_t kBuildConfig = 1;
+#else
+constexpr uint64_t kBuildConfig = 0;
+#endif
+
+constexpr const char* kManifestName = "manifest.txt";
+
+// Owns a copy of a precompiled module file for loadModuleFromIRBlob
+class ModuleBlob final : public ISlangBlob
+{
+public:
+    explicit ModuleBlob(std::vector<uint8_t> data) : mData(std::move(data)) {}
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(const SlangUUID& uuid, void** outObject) override
+    {
+        const SlangUUID blobGuid = ISlangBlob::getTypeGuid();
+        const SlangUUID unknownGuid = ISlangUnknown::getTypeGuid();
+        if (std::memcmp(&uuid, &blobGuid, sizeof(uuid)) == 0 || std::memcmp(&uuid, &unknownGuid, sizeof(uuid)) == 0)
+        {
+            addRef();
+            *outObject = static_cast<ISlangBlob*>(this);
+            return SLANG_OK;
+        }
+        *outObject = nullptr;
+        return SLANG_E_NO_INTERFACE;
+    }
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override { return ++mRefCount; }
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() override
+    {
+        const uint32_t count = --mRefCount;
+        if (count == 0)
+            delete this;
+        return count;
+    }
+    SLANG_NO_THROW const void* SLANG_MCALL getBufferPointer() override { return mData.data(); }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() override { return mData.size(); }
+
+private:
+    std::vector<uint8_t> mData;
+    std::atomic<uint32_t> mRefCount{0};
+};
+
+struct ManifestEntry
+{
+    std::string name; // Slang module name, e.g. "Scene.Scene"
+    std::string path; // Source file the module was compiled from
+};
+
+// One "name<TAB>path" line per module, in load order: a module's imports always precede it
+std::vector<ManifestEntry> readManifest(const std::filesystem::path& dir)
+{
+    std::vector<ManifestEntry> entries;
+    std::ifstream stream(dir / kManifestName);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        const size_t tab = line.find('\t');
+        if (tab != std::string::npos)
+            entries.push_back({line.substr(0, tab), line.substr(tab + 1)});
+    }
+    return entries;
+}
+
+// Temp file plus rename, so readers never see a partial file
+bool writeFileAtomic(const std::filesystem::path& path, const void* pData, size_t sizeBytes)
+{
+    const std::filesystem::path tempPath = fmt::format("{}.{}.tmp", path.string(), std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    std::error_code ec;
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        stream.write(static_cast<const char*>(pData), static_cast<std::streamsize>(sizeBytes));
+        stream.close();
+        if (stream.fail())
+        {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+        std::filesystem::remove(tempPath, ec);
+    return !ec;
+}
+
+std::filesystem::path getModulePath(const std::filesystem::path& dir, const std::string& moduleName)
+{
+    return dir / (moduleName + ".slang-module");
+}
+} // namespace
 
 ShaderCompiler& ShaderCompiler::get()
 {
@@ -11,7 +111,196 @@ ShaderCompiler& ShaderCompiler::get()
 
 ShaderCompiler::ShaderCompiler()
 {
-    slang::createGlobalSession(mGlobalSession.writeRef());
+    std::unique_ptr<Context> pContext = createContext();
+    if (pContext->globalSession && pContext->globalSession->getBuildTagString())
+        mCompilerVersion = pContext->globalSession->getBuildTagString();
+    mFreeContexts.push_back(pContext.get());
+    mContexts.push_back(std::move(pContext));
+}
+
+std::unique_ptr<ShaderCompiler::Context> ShaderCompiler::createContext()
+{
+    auto pContext = std::make_unique<Context>();
+    if (SLANG_FAILED(slang::createGlobalSession(pContext->globalSession.writeRef())))
+        LOG_ERROR("[ShaderCompiler] Failed to create Slang global session");
+    return pContext;
+}
+
+ShaderCompiler::Lease ShaderCompiler::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mFreeContexts.empty())
+        {
+            Context* pContext = mFreeContexts.back();
+            mFreeContexts.pop_back();
+            if (pContext->generation != mGeneration)
+            {
+                pContext->sessions.clear();
+                pContext->generation = mGeneration;
+            }
+            return Lease(this, pContext);
+        }
+    }
+
+    // Creating a global session loads the Slang core module; do it outside the lock
+    std::unique_ptr<Context> pContext = createContext();
+    Context* pLeased = pContext.get();
+    std::lock_guard<std::mutex> lock(mMutex);
+    pContext->generation = mGeneration;
+    mContexts.push_back(std::move(pContext));
+    LOG_DEBUG("[ShaderCompiler] Created compiler context {} for a concurrent compile", mContexts.size());
+    return Lease(this, pLeased);
+}
+
+void ShaderCompiler::release(Context* pContext)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFreeContexts.push_back(pContext);
+}
+
+size_t ShaderCompiler::getContextCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mContexts.size();
+}
+
+void ShaderCompiler::resetModuleStats()
+{
+    mLoadedModules = 0;
+    mStoredModules = 0;
+}
+
+void ShaderCompiler::resetSessions()
+{
+    // Leased contexts may be compiling; every context clears its sessions the next time it is handed out
+    std::lock_guard<std::mutex> lock(mMutex);
+    mGeneration++;
+}
+
+void ShaderCompiler::loadPrecompiledModules(SessionData& sessionData)
+{
+    const std::filesystem::path dir = sessionData.moduleCacheDir;
+    std::vector<ManifestEntry> manifest;
+    {
+        std::lock_guard<std::mutex> lock(mManifestMutex);
+        manifest = readManifest(dir);
+    }
+
+    for (const ManifestEntry& entry : manifest)
+    {
+        std::ifstream stream(getModulePath(dir, entry.name), std::ios::binary);
+        if (!stream)
+            continue;
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        Slang::ComPtr<ISlangBlob> pBlob(new ModuleBlob(std::move(data)));
+
+        // Stale modules (source or any dependency edited) are compiled from source and re-serialized later
+        if (!sessionData.session->isBinaryModuleUpToDate(entry.path.c_str(), pBlob))
+            continue;
+
+        Slang::ComPtr<slang::IBlob> pDiagnostics;
+        slang::IModule* pModule = sessionData.session->loadModuleFromIRBlob(entry.name.c_str(), entry.path.c_str(), pBlob, pDiagnostics.writeRef());
+        if (!pModule)
+        {
+            if (pDiagnostics && pDiagnostics->getBufferSize() > 0)
+                LOG_DEBUG("[ShaderCompiler] Precompiled module {} rejected: {}", entry.name, (const char*)pDiagnostics->getBufferPointer());
+            continue;
+        }
+        sessionData.precompiled.insert(entry.name);
+        mLoadedModules++;
+    }
+    if (!sessionData.precompiled.empty())
+        LOG_DEBUG("[ShaderCompiler] Loaded {} precompiled modules from {}", sessionData.precompiled.size(), dir.string());
+}
+
+void ShaderCompiler::Lease::storePrecompiledModules(slang::ISession* pSession, slang::IModule* pMainModule)
+{
+    if (!mpContext || !pSession || !mpOwner->mPrecompiledModulesEnabled)
+        return;
+    auto it = std::find_if(
+        mpContext->sessions.begin(), mpContext->sessions.end(), [&](const auto& entry) { return entry.second.session.get() == pSession; }
+    );
+    if (it == mpContext->sessions.end())
+        return;
+    SessionData& sessionData = it->second;
+    const std::filesystem::path dir = sessionData.moduleCacheDir;
+
+    // The session lists modules in load order, so each module's imports come before it
+    std::vector<ManifestEntry> added;
+    for (SlangInt i = 0; i < pSession->getLoadedModuleCount(); ++i)
+    {
+        slang::IModule* pModule = pSession->getLoadedModule(i);
+        if (!pModule || pModule == pMainModule || !pModule->getName() || !pModule->getFilePath())
+            continue;
+        // Source-string modules (link-time constants) have no file to validate a reload against
+        std::error_code ec;
+        if (!std::filesystem::exists(pModule->getFilePath(), ec))
+            continue;
+        const std::string name = pModule->getName();
+        if (sessionData.precompiled.count(name))
+            continue;
+
+        Slang::ComPtr<ISlangBlob> pBlob;
+        if (SLANG_FAILED(pModule->serialize(pBlob.writeRef())) || !pBlob)
+        {
+            LOG_WARN("[ShaderCompiler] Failed to serialize module {}", name);
+            continue;
+        }
+        std::filesystem::create_directories(dir, ec);
+        if (!writeFileAtomic(getModulePath(dir, name), pBlob->getBufferPointer(), pBlob->getBufferSize()))
+        {
+            LOG_WARN("[ShaderCompiler] Failed to write precompiled module {} to {}", name, dir.string());
+            continue;
+        }
+        sessionData.precompiled.insert(name);
+        added.push_back({name, pModule->getFilePath()});
+        mpOwner->mStoredModules++;
+    }
+    if (added.empty())
+        return;
+
+    // Merge with what other sessions of the same key wrote; known names keep their position
+    std::lock_guard<std::mutex> lock(mpOwner->mManifestMutex);
+    std::vector<ManifestEntry> manifest = readManifest(dir);
+    for (ManifestEntry& entry : added)
+    {
+        auto existing =
+            std::find_if(manifest.begin(), manifest.end(), [&](const ManifestEntry& other) { return other.name == entry.name; });
+        if (existing == manifest.end())
+            manifest.push_back(std::move(entry));
+    }
+    std::string text;
+    for (const ManifestEntry& entry : manifest)
+        text += entry.name + '\t' + entry.path + '\n';
+    if (!writeFileAtomic(dir / kManifestName, text.data(), text.size()))
+        LOG_WARN("[ShaderCompiler] Failed to write module manifest in {}", dir.string());
+    else
+        LOG_DEBUG("[ShaderCompiler] Precompiled {} modules into {}", added.size(), dir.string());
+}
+
+ShaderCompiler::Lease::Lease(Lease&& other) noexcept : mpOwner(other.mpOwner), mpContext(other.mpContext)
+{
+    other.mpOwner = nullptr;
+    other.mpContext = nullptr;
+}
+
+ShaderCompiler::Lease& ShaderCompiler::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (mpContext)
+            mpOwner->release(mpContext);
+        mpOwner = std::exchange(other.mpOwner, nullptr);
+        mpContext = std::exchange(other.mpContext, nullptr);
+    }
+    return *this;
+}
+
+ShaderCompiler::Lease::~Lease()
+{
+    if (mpContext)
+        mpOwner->release(mpContext);
 }
 
 size_t ShaderCompiler::SessionKeyHash::operator()(const SessionKey& key) const
@@ -26,15 +315,19 @@ size_t ShaderCompiler::SessionKeyHash::operator()(const SessionKey& key) const
     return h;
 }
 
-slang::ISession* ShaderCompiler::getSession(const std::string& profile, const std::vector<std::pair<std::string, std::string>>& defines)
+slang::ISession* ShaderCompiler::Lease::getSession(const std::string& profile, const std::vector<std::pair<std::string, std::string>>& defines)
 {
+    if (!mpContext || !mpContext->globalSession)
+        return nullptr;
+
     SessionKey key;
     key.profile = profile;
     key.sortedDefines = defines;
     std::sort(key.sortedDefines.begin(), key.sortedDefines.end());
 
-    if (auto it = mSessions.find(key); it != mSessions.end())
-        return it->second;
+    auto& sessions = mpContext->sessions;
+    if (auto it = sessions.find(key); it != sessions.end())
+        return it->second.session;
 
     // Target-level options: affect code generation (debug info, optimization level).
     std::vector<slang::CompilerOptionEntry> targetOptions;
@@ -71,7 +364,7 @@ slang::ISession* ShaderCompiler::getSession(const std::string& profile, const st
 
     slang::TargetDesc targetDesc = {};
     targetDesc.format = SLANG_DXIL;
-    targetDesc.profile = mGlobalSession->findProfile(profile.c_str());
+    targetDesc.profile = mpContext->globalSession->findProfile(profile.c_str());
     targetDesc.compilerOptionEntries = targetOptions.data();
     targetDesc.compilerOptionEntryCount = static_cast<uint32_t>(targetOptions.size());
 
@@ -86,13 +379,28 @@ slang::ISession* ShaderCompiler::getSession(const std::string& profile, const st
     sessionDesc.compilerOptionEntryCount = static_cast<uint32_t>(sessionOptions.size());
 
     Slang::ComPtr<slang::ISession> pSession;
-    auto result = mGlobalSession->createSession(sessionDesc, pSession.writeRef());
+    auto result = mpContext->globalSession->createSession(sessionDesc, pSession.writeRef());
     if (SLANG_FAILED(result))
     {
         LOG_ERROR("[ShaderCompiler] Failed to create session with result: {}", result);
         return nullptr;
     }
 
-    auto [it, _] = mSessions.emplace(std::move(key), pSession);
-    return it->second;
+    // Precompiled modules are shared by every session with the same key, compiler and build configuration
+    uint64_t dirHash = Hash::combine(kBuildConfig, Hash::hash64(mpOwner->mCompilerVersion.data(), mpOwner->mCompilerVersion.size()));
+    dirHash = Hash::combine(dirHash, Hash::hash64(key.profile.data(), key.profile.size()));
+    for (const auto& [name, value] : key.sortedDefines)
+    {
+        dirHash = Hash::combine(dirHash, Hash::hash64(name.data(), name.size()));
+        dirHash = Hash::combine(dirHash, Hash::hash64(value.data(), value.size()));
+    }
+
+    SessionData sessionData;
+    sessionData.session = pSession;
+    sessionData.moduleCacheDir = fmt::format("{}/slang-modules/{}-{:016x}", PROJECT_CACHE_DIR, key.profile, dirHash);
+    if (mpOwner->mPrecompiledModulesEnabled)
+        mpOwner->loadPrecompiledModules(sessionData);
+
+    auto [it, _] = sessions.emplace(std::move(key), std::move(sessionData));
+    return it->second.session;
 }
@@ -2,34 +2,92 @@
 #include <slang.h>
 #include <slang-com-helper.h>
 #include <slang-com-ptr.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
-// Process-wide owner of the Slang IGlobalSession and a cache of ISessions keyed
-// by {profile, sorted defines}. Sharing sessions means a module imported by
-// multiple Programs (e.g. Scene.slang) is front-end compiled only once.
+// Process-wide owner of Slang compiler contexts. A context is an IGlobalSession plus
+// a cache of ISessions keyed by {profile, sorted defines}; sharing sessions means a
+// module imported by multiple Programs (e.g. Scene.slang) is front-end compiled only
+// once per context.
 //
-// NOT thread-safe: Slang's loadModule/link are not reentrant, and concurrent
-// callers would also race on the session cache. All shader init runs on the
-// main thread today; if that ever changes, add a mutex around getSession and
-// around front-end work performed on the returned session.
+// Thread-safe: Slang objects are not reentrant, so a compile leases a context for its
+// exclusive use and returns it when the lease ends. Contexts are created on demand,
+// so N concurrent compiles (e.g. passes built on the ThreadPool) use N global
+// sessions, each paying its own front-end cost for shared modules.
 //
-// NO runtime hot-reload: ISession::loadModule() caches module IR on first load,
-// so a Program constructed after a cached session exists will reuse old IR even
-// if the .slang file has been edited on disk. Restart the app to pick up shader
-// edits. If hot-reload becomes a desired workflow, add file-mtime invalidation
-// (walk the session's loaded modules, compare against disk, clear the session
-// entry if any source is stale).
+// Precompiled modules: every module a program imports is serialized as Slang IR under
+// <PROJECT_CACHE_DIR>/slang-modules/<session key>/, with a manifest in load order. A new
+// session loads the ones whose sources are unchanged before any program is compiled, so
+// shared imports (Scene.Scene, GLTFMaterial, SampleGenerator, ...) skip the front end.
+//
+// Edits: ISession::loadModule() caches module IR on first load, so a cached session
+// never sees a .slang file edited on disk. ShaderHotReload calls resetSessions() when
+// a watched file changes, and every context starts over with fresh sessions.
 class ShaderCompiler
 {
+    struct Context;
+
 public:
     static ShaderCompiler& get();
 
-    // Returns a session cached by {profile, sorted defines}. Non-owning — the
-    // ShaderCompiler singleton outlives any caller.
-    slang::ISession* getSession(const std::string& profile, const std::vector<std::pair<std::string, std::string>>& defines);
+    // Exclusive use of one compiler context; Slang objects created through it must be released before the lease ends
+    class Lease
+    {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        // Returns a session cached by {profile, sorted defines}. Non-owning — the
+        // context outlives the lease.
+        slang::ISession* getSession(const std::string& profile, const std::vector<std::pair<std::string, std::string>>& defines);
+
+        // Serialize the modules pMainModule pulled into pSession that are not precompiled yet (pMainModule itself excluded)
+        void storePrecompiledModules(slang::ISession* pSession, slang::IModule* pMainModule);
+
+        explicit operator bool() const { return mpContext != nullptr; }
+
+    private:
+        friend class ShaderCompiler;
+        Lease(ShaderCompiler* pOwner, Context* pContext) : mpOwner(pOwner), mpContext(pContext) {}
+
+        ShaderCompiler* mpOwner = nullptr;
+        Context* mpContext = nullptr;
+    };
+
+    // Blocks only on the pool mutex; creates a new context when every existing one is leased
+    Lease acquire();
+
+    // Slang build tag; part of every ShaderCache key so a compiler upgrade invalidates cached kernels
+    const std::string& getCompilerVersion() const { return mCompilerVersion; }
+
+    // Contexts created so far, i.e. the peak number of concurrent compiles
+    size_t getContextCount();
+
+    struct ModuleStats
+    {
+        uint32_t loaded = 0; // Modules restored from precompiled IR
+        uint32_t stored = 0; // Modules serialized after a front-end compile
+    };
+    ModuleStats getModuleStats() const { return {mLoadedModules.load(), mStoredModules.load()}; }
+    void resetModuleStats();
+
+    // Disabled: sessions compile every import from source and nothing is serialized
+    void setPrecompiledModulesEnabled(bool enabled) { mPrecompiledModulesEnabled = enabled; }
+    bool isPrecompiledModulesEnabled() const { return mPrecompiledModulesEnabled; }
+
+    // Drop every cached session; each context starts over the next time it is leased
+    void resetSessions();
 
 private:
     ShaderCompiler();
@@ -46,6 +104,32 @@ private:
         size_t operator()(const SessionKey& key) const;
     };
 
-    Slang::ComPtr<slang::IGlobalSession> mGlobalSession;
-    std::unordered_map<SessionKey, Slang::ComPtr<slang::ISession>, SessionKeyHash> mSessions;
+    struct SessionData
+    {
+        Slang::ComPtr<slang::ISession> session;
+        std::string moduleCacheDir;                  // Precompiled modules of this session key
+        std::unordered_set<std::string> precompiled; // Module names already on disk and up to date
+    };
+
+    struct Context
+    {
+        Slang::ComPtr<slang::IGlobalSession> globalSession;
+        std::unordered_map<SessionKey, SessionData, SessionKeyHash> sessions;
+        uint64_t generation = 0;
+    };
+
+    std::unique_ptr<Context> createContext();
+    void release(Context* pContext);
+    void loadPrecompiledModules(SessionData& sessionData);
+
+    std::string mCompilerVersion;
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<Context>> mContexts;
+    std::vector<Context*> mFreeContexts;
+    uint64_t mGeneration = 0;
+
+    std::mutex mManifestMutex;
+    std::atomic<bool> mPrecompiledModulesEnabled{true};
+    std::atomic<uint32_t> mLoadedModules{0};
+    std::atomic<uint32_t> mStoredModules{0};
 };
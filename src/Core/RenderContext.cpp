@@ -0,0 +1,36 @@
+#include "RenderContext.h"
+#include "Device.h"
+#include "Utils/FrameStats.h"
+
+RenderContext::RenderContext(ref<Device> pDevice) : mpDevice(pDevice)
+{
+    // A list of its own: helpers such as ResourceIO open the device's shared list while a frame is recorded
+    mCommandList = mpDevice->getDevice()->createCommandList(nvrhi::CommandListParameters().setQueueType(nvrhi::CommandQueue::Graphics));
+}
+
+RenderContext::~RenderContext()
+{
+    submit();
+}
+
+nvrhi::ICommandList* RenderContext::getCommandList()
+{
+    if (!mIsOpen)
+    {
+        mCommandList->open();
+        mIsOpen = true;
+    }
+    return mCommandList;
+}
+
+void RenderContext::submit()
+{
+    if (!mIsOpen)
+        return;
+
+    mCommandList->close();
+    mpDevice->getDevice()->executeCommandList(mCommandList);
+    mIsOpen = false;
+    mSubmissionCount++;
+    FrameStats::addCommandListSubmission();
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <nvrhi/nvrhi.h>
+
+#include "Pointer.h"
+
+class Device;
+
+/*
+    Frame-scoped recording context. RenderGraph::execute() hands one to every pass, which records into
+    its command list instead of submitting work of its own, and the graph submits the whole frame once.
+    The list is opened on first use, so a frame that records nothing submits nothing. A pass that needs
+    its results on the CPU before the frame ends (e.g. a readback) calls submit() first; later work
+    goes into the reopened list.
+*/
+class RenderContext
+{
+public:
+    RenderContext(ref<Device> pDevice);
+    ~RenderContext();
+
+    // Open command list of the current submission
+    nvrhi::ICommandList* getCommandList();
+
+    // Submit the recorded work without waiting, if there is any
+    void submit();
+
+    // Submissions since construction
+    uint32_t getSubmissionCount() const { return mSubmissionCount; }
+
+private:
+    ref<Device> mpDevice;
+    nvrhi::CommandListHandle mCommandList;
+    bool mIsOpen = false;
+    uint32_t mSubmissionCount = 0;
+};
@@ -31,6 +31,10 @@ public:
 
     void setResource(const std::string& name, const nvrhi::ResourceHandle& resource) { mResources[name] = resource; }
 
+    // Entries as (name, resource), in no particular order
+    auto begin() const { return mResources.begin(); }
+    auto end() const { return mResources.end(); }
+
 private:
     std::unordered_map<std::string, nvrhi::ResourceHandle> mResources;
 };
\ No newline at end of file
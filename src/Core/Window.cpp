@@ -196,13 +196,13 @@ void Window::RenderEnd()
 
 void Window::SetDisplayTexture(ID3D12Resource* texture)
 {
-    if (!texture)
+    if (!texture || texture == mpCurrentDisplayTexture.Get())
         return;
     mpCurrentDisplayTexture = texture;
 
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
     srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-    srvDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+    srvDesc.Format = texture->GetDesc().Format;
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
     srvDesc.Texture2D.MostDetailedMip = 0;
@@ -219,7 +219,7 @@ ImTextureID Window::GetDisplayTextureImGuiHandle() const
 
 ID3D12Resource* Window::GetCurrentDisplayTexture() const
 {
-    return mpCurrentDisplayTexture;
+    return mpCurrentDisplayTexture.Get();
 }
 
 uint2 Window::GetWindowSize() const
@@ -245,6 +245,7 @@ void Window::ResizeClientArea(uint32_t clientWidth, uint32_t clientHeight)
 void Window::CleanupResources()
 {
     WaitForLastSubmittedFrame();
+    mpCurrentDisplayTexture.Reset();
 
     // Cleanup ImGui
     ImGui_ImplDX12_Shutdown();
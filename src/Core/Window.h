@@ -79,8 +79,9 @@ private:
     ImGuiIO* mpIo;
     bool mEnableVSync;
 
-    // Display texture and descriptor handles
-    ID3D12Resource* mpCurrentDisplayTexture = nullptr;
+    // Display texture and descriptor handles. Holding a reference keeps the address from being reused by a new
+    // resource, so the SRV is only rewritten when the texture actually changes.
+    ComPtr<ID3D12Resource> mpCurrentDisplayTexture;
     ImTextureID mDisplayImGuiHandle = (ImTextureID)0;
     D3D12_CPU_DESCRIPTOR_HANDLE mDisplaySrvCpuHandle = {};
     D3D12_GPU_DESCRIPTOR_HANDLE mDisplaySrvGpuHandle = {};
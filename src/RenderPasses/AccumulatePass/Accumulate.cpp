@@ -22,6 +22,7 @@ struct AccumulatePassRegistration
 
 const std::string kInputName = "input";
 const std::string kOutputName = "output";
+constexpr uint32_t kOutputIndex = 0;
 constexpr int kMaxSppSliderMax = 8192;
 } // namespace
 
@@ -33,12 +34,15 @@ AccumulatePass::AccumulatePass(ref<Device> pDevice) : RenderPass(pDevice)
     cbDesc.initialState = nvrhi::ResourceStates::ConstantBuffer;
     cbDesc.keepInitialState = true;
     cbDesc.cpuAccess = nvrhi::CpuAccessMode::None;
-    cbDesc.isVolatile = true;
     cbDesc.debugName = "AccumulatePass/PerFrameCB";
     mCbPerFrame = mpDevice->getDevice()->createBuffer(cbDesc);
 
     mpPass = make_ref<ComputePass>(pDevice, "/src/RenderPasses/AccumulatePass/Accumulate.slang", "main");
     mpPass->addConstantBuffer(mCbPerFrame, &mPerFrameData, sizeof(PerFrameCB));
+    mSlots.perFrameCB = mpPass->getSlot("PerFrameCB");
+    mSlots.input = mpPass->getSlot(kInputName);
+    mSlots.accumulateTexture = mpPass->getSlot("accumulateTexture");
+    mSlots.output = mpPass->getSlot(kOutputName);
 }
 
 std::vector<RenderPassInput> AccumulatePass::getInputs() const
@@ -48,10 +52,11 @@ std::vector<RenderPassInput> AccumulatePass::getInputs() const
 
 std::vector<RenderPassOutput> AccumulatePass::getOutputs() const
 {
-    return {RenderPassOutput(kOutputName, RenderDataType::Texture2D)};
+    // Persistent: once Max SPP is reached the pass returns last frame's output without dispatching
+    return {RenderPassOutput(kOutputName, nvrhi::Format::RGBA32_FLOAT, RenderPassOutputLifetime::Persistent)};
 }
 
-RenderData AccumulatePass::execute(const RenderData& renderData)
+void AccumulatePass::execute(RenderContext& context, const RenderData& renderData)
 {
     nvrhi::TextureHandle pInputTexture = dynamic_cast<nvrhi::ITexture*>(renderData[kInputName].Get());
     uint2 resolution = uint2(pInputTexture->getDesc().width, pInputTexture->getDesc().height);
@@ -67,11 +72,20 @@ RenderData AccumulatePass::execute(const RenderData& renderData)
     if (hasFlag(GUI::getRefreshFlags(), RenderPassRefreshFlags::ResetAccumulation))
         mReset = true;
 
-    RenderData output;
-    output.setResource(kOutputName, mTextureOut);
+    nvrhi::TextureHandle pTextureOut = getOutputTexture(kOutputName);
+    if (!pTextureOut)
+        pTextureOut = mTextureOut;
+    // A graph that (re)created the output has nothing accumulated in it yet
+    if (pTextureOut != mpLastTextureOut)
+    {
+        mpLastTextureOut = pTextureOut;
+        mReset = true;
+    }
+
+    setOutput(kOutputIndex, pTextureOut);
 
     if (mMaxSpp > 0 && mFrameCount >= mMaxSpp && !mReset)
-        return output;
+        return;
 
     mPerFrameData.gWidth = mWidth;
     mPerFrameData.gHeight = mHeight;
@@ -83,12 +97,11 @@ RenderData AccumulatePass::execute(const RenderData& renderData)
     }
     mPerFrameData.frameCount = ++mFrameCount;
 
-    (*mpPass)["PerFrameCB"] = mCbPerFrame;
-    (*mpPass)["input"] = pInputTexture;
-    (*mpPass)["accumulateTexture"] = mAccumulateTexture;
-    (*mpPass)["output"] = mTextureOut;
-    mpPass->execute(mWidth, mHeight, 1);
-    return output;
+    (*mpPass)[mSlots.perFrameCB] = mCbPerFrame;
+    (*mpPass)[mSlots.input] = pInputTexture;
+    (*mpPass)[mSlots.accumulateTexture] = mAccumulateTexture;
+    (*mpPass)[mSlots.output] = pTextureOut;
+    mpPass->execute(context, mWidth, mHeight, 1);
 }
 
 void AccumulatePass::renderUI()
@@ -111,7 +124,8 @@ void AccumulatePass::prepareResources()
                                          .setDebugName("AccumulatePass/output")
                                          .setIsUAV(true)
                                          .setKeepInitialState(true);
-    mTextureOut = mpDevice->getDevice()->createTexture(textureDesc);
+    // Inside a RenderGraph the graph creates the output
+    mTextureOut = getOutputTexture(kOutputName) ? nullptr : mpDevice->getDevice()->createTexture(textureDesc);
     textureDesc.setDebugName("AccumulatePass/accumulateTexture");
     mAccumulateTexture = mpDevice->getDevice()->createTexture(textureDesc);
 }
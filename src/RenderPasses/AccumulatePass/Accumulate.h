@@ -7,7 +7,7 @@ class AccumulatePass : public RenderPass
 public:
     AccumulatePass(ref<Device> pDevice);
 
-    RenderData execute(const RenderData& input) override;
+    void execute(RenderContext& context, const RenderData& input) override;
 
     void renderUI() override;
 
@@ -22,6 +22,7 @@ public:
     // RenderGraph interface
     std::string getName() const override { return "Accumulate"; }
     bool accumulatesHistory() const override { return true; }
+    bool hasSideEffects() const override { return true; } // A skipped frame would miss its reset
     std::vector<RenderPassInput> getInputs() const override;
     std::vector<RenderPassOutput> getOutputs() const override;
 
@@ -44,6 +45,15 @@ private:
 
     nvrhi::BufferHandle mCbPerFrame;
     nvrhi::TextureHandle mTextureOut;
+    nvrhi::TextureHandle mpLastTextureOut; // Output written last frame, whoever created it
     nvrhi::TextureHandle mAccumulateTexture;
     ref<ComputePass> mpPass;
+
+    struct BindingSlots
+    {
+        uint32_t perFrameCB = BindingSetManager::kInvalidSlot;
+        uint32_t input = BindingSetManager::kInvalidSlot;
+        uint32_t accumulateTexture = BindingSetManager::kInvalidSlot;
+        uint32_t output = BindingSetManager::kInvalidSlot;
+    } mSlots;
 };
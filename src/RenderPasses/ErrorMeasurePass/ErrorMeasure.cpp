@@ -24,6 +24,7 @@ struct ErrorMeasurePassRegistration
 const std::string kSourceName = "source";
 const std::string kReferenceName = "reference";
 const std::string kOutputName = "output";
+constexpr uint32_t kOutputIndex = 0;
 } // namespace
 
 ErrorMeasurePass::ErrorMeasurePass(ref<Device> pDevice) : RenderPass(pDevice)
@@ -34,11 +35,14 @@ ErrorMeasurePass::ErrorMeasurePass(ref<Device> pDevice) : RenderPass(pDevice)
     cbDesc.initialState = nvrhi::ResourceStates::ConstantBuffer;
     cbDesc.keepInitialState = true;
     cbDesc.cpuAccess = nvrhi::CpuAccessMode::None;
-    cbDesc.isVolatile = true;
     cbDesc.debugName = "ErrorMeasure/PerFrameCB";
     mCbPerFrame = mpDevice->getDevice()->createBuffer(cbDesc);
     mpPass = make_ref<ComputePass>(pDevice, "/src/RenderPasses/ErrorMeasurePass/ErrorMeasure.slang", "main");
     mpPass->addConstantBuffer(mCbPerFrame, &mPerFrameData, sizeof(PerFrameCB));
+    mSlots.perFrameCB = mpPass->getSlot("PerFrameCB");
+    mSlots.source = mpPass->getSlot("source");
+    mSlots.reference = mpPass->getSlot("reference");
+    mSlots.output = mpPass->getSlot("output");
 }
 
 void ErrorMeasurePass::setTextureReference(const std::string& path)
@@ -78,10 +82,10 @@ std::vector<RenderPassInput> ErrorMeasurePass::getInputs() const
 
 std::vector<RenderPassOutput> ErrorMeasurePass::getOutputs() const
 {
-    return {RenderPassOutput(kOutputName, RenderDataType::Texture2D)};
+    return {RenderPassOutput(kOutputName, nvrhi::Format::RGBA32_FLOAT, RenderPassOutputLifetime::Transient)};
 }
 
-RenderData ErrorMeasurePass::execute(const RenderData& renderData)
+void ErrorMeasurePass::execute(RenderContext& context, const RenderData& renderData)
 {
     mpSourceTexture = dynamic_cast<nvrhi::ITexture*>(renderData[kSourceName].Get());
     uint2 resolution = uint2(mpSourceTexture->getDesc().width, mpSourceTexture->getDesc().height);
@@ -100,10 +104,9 @@ RenderData ErrorMeasurePass::execute(const RenderData& renderData)
         if (resolution.x != refRes.x || resolution.y != refRes.y)
         {
             LOG_WARN("Resolution mismatch: source({}x{}) vs reference({}x{})", resolution.x, resolution.y, refRes.x, refRes.y);
-            RenderData output;
-            output.setResource(kOutputName, mpSourceTexture);
+            setOutput(kOutputIndex, mpSourceTexture);
             mSelectedOutput = OutputId::Source;
-            return output;
+            return;
         }
     }
 
@@ -114,18 +117,18 @@ RenderData ErrorMeasurePass::execute(const RenderData& renderData)
     mPerFrameData.gConstantColor = mConstantReferenceColor;
     mPerFrameData.gMetric = static_cast<uint32_t>(mMetric);
 
-    (*mpPass)["PerFrameCB"] = mCbPerFrame;
-    (*mpPass)["source"] = mpSourceTexture;
+    (*mpPass)[mSlots.perFrameCB] = mCbPerFrame;
+    (*mpPass)[mSlots.source] = mpSourceTexture;
     if (mReferenceMode == ReferenceMode::Texture && mpReferenceTexture)
-        (*mpPass)["reference"] = mpReferenceTexture;
+        (*mpPass)[mSlots.reference] = mpReferenceTexture;
     else
-        (*mpPass)["reference"] = mpSourceTexture; // Dummy bind; shader won't read it in Constant mode
-    (*mpPass)["output"] = mpOutputTexture;
-    mpPass->execute(mWidth, mHeight, 1);
-
-    RenderData output;
-    output.setResource(kOutputName, mpOutputTexture);
-    return output;
+        (*mpPass)[mSlots.reference] = mpSourceTexture; // Dummy bind; shader won't read it in Constant mode
+    nvrhi::TextureHandle pOutputTexture = getOutputTexture(kOutputName);
+    if (!pOutputTexture)
+        pOutputTexture = mpOutputTexture;
+    (*mpPass)[mSlots.output] = pOutputTexture;
+    mpPass->execute(context, mWidth, mHeight, 1);
+    setOutput(kOutputIndex, pOutputTexture);
 }
 
 void ErrorMeasurePass::renderUI()
@@ -155,5 +158,6 @@ void ErrorMeasurePass::prepareResources(uint32_t width, uint32_t height)
                                          .setDebugName("ErrorMeasure/outputTexture")
                                          .setIsUAV(true)
                                          .setKeepInitialState(true);
-    mpOutputTexture = mpDevice->getDevice()->createTexture(textureDesc);
+    // Inside a RenderGraph the graph creates the output
+    mpOutputTexture = getOutputTexture(kOutputName) ? nullptr : mpDevice->getDevice()->createTexture(textureDesc);
 }
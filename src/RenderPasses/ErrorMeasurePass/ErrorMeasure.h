@@ -27,7 +27,7 @@ public:
     };
     // Values are mirrored by kMetricMAE/kMetricRelMSE in ErrorMeasure.slang; keep in sync.
 
-    RenderData execute(const RenderData& input) override;
+    void execute(RenderContext& context, const RenderData& input) override;
 
     void renderUI() override;
 
@@ -76,4 +76,12 @@ private:
     nvrhi::TextureHandle mpReferenceTexture;
     nvrhi::TextureHandle mpOutputTexture;
     ref<ComputePass> mpPass;
+
+    struct BindingSlots
+    {
+        uint32_t perFrameCB = BindingSetManager::kInvalidSlot;
+        uint32_t source = BindingSetManager::kInvalidSlot;
+        uint32_t reference = BindingSetManager::kInvalidSlot;
+        uint32_t output = BindingSetManager::kInvalidSlot;
+    } mSlots;
 };
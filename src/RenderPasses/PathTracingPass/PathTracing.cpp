@@ -19,6 +19,8 @@ struct PathTracingPassRegistration
 };
 
 [[maybe_unused]] static PathTracingPassRegistration gPathTracingPassRegistration;
+
+constexpr uint32_t kOutputIndex = 0;
 } // namespace
 
 PathTracingPass::PathTracingPass(ref<Device> pDevice) : RenderPass(pDevice)
@@ -29,9 +31,9 @@ PathTracingPass::PathTracingPass(ref<Device> pDevice) : RenderPass(pDevice)
     cbDesc.initialState = nvrhi::ResourceStates::ConstantBuffer;
     cbDesc.keepInitialState = true;
     cbDesc.cpuAccess = nvrhi::CpuAccessMode::None;
-    cbDesc.isVolatile = true;
     cbDesc.debugName = "PathTracingPass/PerFrameCB";
     mCbPerFrame = mpDevice->getDevice()->createBuffer(cbDesc);
+    mpPerFrameConstants = make_ref<ConstantBuffer>(ConstantBuffer{mCbPerFrame, &mPerFrameData, sizeof(PerFrameCB), {}});
 
     cbDesc.byteSize = sizeof(CameraData);
     cbDesc.debugName = "PathTracingPass/Camera";
@@ -43,27 +45,63 @@ PathTracingPass::PathTracingPass(ref<Device> pDevice) : RenderPass(pDevice)
     samplerDesc.setAllAddressModes(nvrhi::SamplerAddressMode::Repeat);
     mTextureSampler = mpDevice->getDevice()->createSampler(samplerDesc);
 
-    buildRayTracingPass();
+    selectVariant();
 }
 
-void PathTracingPass::buildRayTracingPass()
+void PathTracingPass::selectVariant()
 {
-    LOG_DEBUG("[PathTracingPass] Recompiling path tracing shader program (furnaceMode={})", static_cast<uint32_t>(mFurnaceMode));
+    const uint32_t key = static_cast<uint32_t>(mFurnaceMode) | (mUseNEE ? 1u << 16 : 0u);
+    auto it = mVariants.find(key);
+    if (it == mVariants.end())
+        it = mVariants.emplace(key, buildVariant()).first;
+    mpPass = it->second.pass;
+    mSlots = it->second.slots;
+}
+
+PathTracingPass::Variant PathTracingPass::buildVariant()
+{
+    LOG_DEBUG("[PathTracingPass] Building variant (furnaceMode={}, nee={})", static_cast<uint32_t>(mFurnaceMode), mUseNEE);
     std::vector<std::pair<std::string, nvrhi::ShaderType>> entryPoints = {
         {"rayGenMain", nvrhi::ShaderType::RayGeneration},
         {"missMain", nvrhi::ShaderType::Miss},
         {"shadowMissMain", nvrhi::ShaderType::Miss},
         {"closestHitMain", nvrhi::ShaderType::ClosestHit}
     };
-    std::vector<std::pair<std::string, std::string>> defines;
-    if (mFurnaceMode == FurnaceMode::WeakWhiteFurnace)
-        defines.emplace_back("WEAK_WHITE_FURNACE", "1");
-
-    mpPass.reset();
-    mpPass = make_ref<RayTracingPass>(mpDevice, "/src/RenderPasses/PathTracingPass/PathTracing.slang", entryPoints, defines);
-    mpPass->addConstantBuffer(mCbPerFrame, &mPerFrameData, sizeof(PerFrameCB));
-    if (mpScene)
-        mpPass->addConstantBuffer(mCbCamera, &mpScene->camera->getCameraData(), sizeof(CameraData));
+    std::vector<LinkTimeConstant> linkTimeConstants = {
+        {"bool", "kWeakWhiteFurnace", mFurnaceMode == FurnaceMode::WeakWhiteFurnace ? "true" : "false"},
+        {"bool", "kUseNEE", mUseNEE ? "true" : "false"}
+    };
+
+    Variant variant;
+    variant.pass = make_ref<RayTracingPass>(
+        mpDevice,
+        "/src/RenderPasses/PathTracingPass/PathTracing.slang",
+        entryPoints,
+        std::vector<std::pair<std::string, std::string>>(),
+        linkTimeConstants
+    );
+    variant.pass->addConstantBuffer(mpPerFrameConstants);
+    if (mpCameraConstants)
+        variant.pass->addConstantBuffer(mpCameraConstants);
+
+    RayTracingPass& pass = *variant.pass;
+    BindingSlots& slots = variant.slots;
+    slots.perFrameCB = pass.getSlot("PerFrameCB");
+    slots.camera = pass.getSlot("gCamera");
+    slots.vertices = pass.getSlot("gScene.vertices");
+    slots.indices = pass.getSlot("gScene.indices");
+    slots.meshes = pass.getSlot("gScene.meshes");
+    slots.instances = pass.getSlot("gScene.instances");
+    slots.materials = pass.getSlot("gScene.materials");
+    slots.rtAccel = pass.getSlot("gScene.rtAccel");
+    slots.emissiveTriangles = pass.getSlot("gScene.emissiveTriangles");
+    slots.emissiveAliasTable = pass.getSlot("gScene.emissiveAliasTable");
+    slots.lightBVHNodes = pass.getSlot("gScene.lightBVHNodes");
+    slots.lightBVHBitTrails = pass.getSlot("gScene.lightBVHBitTrails");
+    slots.materialTextures = pass.getSlot("gMaterialTextures.textures");
+    slots.sampler = pass.getSlot("gMaterialSampler.sampler");
+    slots.result = pass.getSlot("result");
+    return variant;
 }
 
 void PathTracingPass::setFurnaceMode(FurnaceMode mode)
@@ -71,10 +109,18 @@ void PathTracingPass::setFurnaceMode(FurnaceMode mode)
     if (mode == mFurnaceMode)
         return;
     mFurnaceMode = mode;
-    buildRayTracingPass();
+    selectVariant();
 }
 
-RenderData PathTracingPass::execute(const RenderData& input)
+void PathTracingPass::setNEE(bool enabled)
+{
+    if (enabled == mUseNEE)
+        return;
+    mUseNEE = enabled;
+    selectVariant();
+}
+
+void PathTracingPass::execute(RenderContext& context, const RenderData& input)
 {
     uint2 resolution = uint2(mpScene->camera->getCameraData().frameWidth, mpScene->camera->getCameraData().frameHeight);
     if (resolution.x != mWidth || resolution.y != mHeight)
@@ -90,30 +136,42 @@ RenderData PathTracingPass::execute(const RenderData& input)
     mPerFrameData.frameCount = ++mFrameCount;
     mPerFrameData.gColor = mGColorSlider;
     mPerFrameData.emissiveTriangleCount = mpScene->getEmissiveTriangleCount();
-    mPerFrameData.totalEmissiveArea = mpScene->totalEmissiveArea;
-
-    RenderData output;
-    output.setResource("output", mTextureOut);
-    (*mpPass)["PerFrameCB"] = mCbPerFrame;
-    (*mpPass)["gCamera"] = mCbCamera;
-    (*mpPass)["gScene.vertices"] = mpScene->getVertexBuffer();
-    (*mpPass)["gScene.indices"] = mpScene->getIndexBuffer();
-    (*mpPass)["gScene.meshes"] = mpScene->getMeshBuffer();
-    (*mpPass)["gScene.instances"] = mpScene->getInstanceBuffer();
-    (*mpPass)["gScene.materials"] = mpScene->getMaterialBuffer();
-    (*mpPass)["gScene.rtAccel"] = mpScene->getTLAS();
-    (*mpPass)["gScene.emissiveTriangles"] = mpScene->getEmissiveTriangleBuffer();
-
-    // Bind all textures to descriptor table for bindless access
-    // Pass default texture to fill unused slots
-    mpPass->setDescriptorTable("gMaterialTextures.textures", mpScene->getTextures(), mpScene->getDefaultTexture());
+    mPerFrameData.totalEmissivePower = mpScene->totalEmissivePower;
+    mPerFrameData.lightSamplerMode = static_cast<uint32_t>(mLightSamplerMode);
+    mPerFrameData.textureLODMode = static_cast<uint32_t>(mTextureLODMode);
+
+    nvrhi::TextureHandle pTextureOut = getOutputTexture("output");
+    if (!pTextureOut)
+        pTextureOut = mTextureOut;
+
+    setOutput(kOutputIndex, pTextureOut);
+    (*mpPass)[mSlots.perFrameCB] = mCbPerFrame;
+    (*mpPass)[mSlots.camera] = mCbCamera;
+    (*mpPass)[mSlots.vertices] = mpScene->getVertexBuffer();
+    (*mpPass)[mSlots.indices] = mpScene->getIndexBuffer();
+    (*mpPass)[mSlots.meshes] = mpScene->getMeshBuffer();
+    (*mpPass)[mSlots.instances] = mpScene->getInstanceBuffer();
+    (*mpPass)[mSlots.materials] = mpScene->getMaterialBuffer();
+    (*mpPass)[mSlots.rtAccel] = mpScene->getTLAS();
+    (*mpPass)[mSlots.emissiveTriangles] = mpScene->getEmissiveTriangleBuffer();
+    (*mpPass)[mSlots.emissiveAliasTable] = mpScene->getEmissiveAliasBuffer();
+    (*mpPass)[mSlots.lightBVHNodes] = mpScene->getLightBVHNodeBuffer();
+    (*mpPass)[mSlots.lightBVHBitTrails] = mpScene->getLightBVHBitTrailBuffer();
+
+    // Bind all textures to descriptor table for bindless access; only slots added or changed since the last
+    // frame are written, and unused slots get the default texture once
+    mpPass->setDescriptorTable(
+        mSlots.materialTextures,
+        mpScene->getTextures(),
+        mpScene->getDefaultTexture(),
+        mpScene->getTextureManager()->getGeneration()
+    );
 
     // Bind sampler separately (in different register space)
-    (*mpPass)["gMaterialSampler.sampler"] = mTextureSampler;
+    (*mpPass)[mSlots.sampler] = mTextureSampler;
 
-    (*mpPass)["result"] = mTextureOut;
-    mpPass->execute(mWidth, mHeight, 1);
-    return output;
+    (*mpPass)[mSlots.result] = pTextureOut;
+    mpPass->execute(context, mWidth, mHeight, 1);
 }
 
 void PathTracingPass::renderUI()
@@ -124,10 +182,31 @@ void PathTracingPass::renderUI()
     int furnaceIdx = static_cast<int>(mFurnaceMode);
     if (GUI::Combo("Furnace Mode", &furnaceIdx, furnaceModeLabels, 2))
         setFurnaceMode(static_cast<FurnaceMode>(furnaceIdx));
+
+    bool useNEE = mUseNEE;
+    if (GUI::Checkbox("Next Event Estimation", &useNEE))
+        setNEE(useNEE);
+
+    static const char* lightSamplerLabels[] = {"Alias Table", "Light BVH"};
+    int lightSamplerIdx = static_cast<int>(mLightSamplerMode);
+    if (GUI::Combo("Light Sampler", &lightSamplerIdx, lightSamplerLabels, 2))
+        setLightSamplerMode(static_cast<LightSamplerMode>(lightSamplerIdx));
+
+    static const char* textureLODLabels[] = {"Mip 0", "Ray Cones"};
+    int textureLODIdx = static_cast<int>(mTextureLODMode);
+    if (GUI::Combo("Texture LOD", &textureLODIdx, textureLODLabels, 2))
+        setTextureLODMode(static_cast<TextureLODMode>(textureLODIdx));
 }
 
 void PathTracingPass::prepareResources()
 {
+    // Inside a RenderGraph the graph creates the output
+    if (getOutputTexture("output"))
+    {
+        mTextureOut = nullptr;
+        return;
+    }
+
     nvrhi::TextureDesc textureDesc = nvrhi::TextureDesc()
                                          .setWidth(mWidth)
                                          .setHeight(mHeight)
@@ -1,6 +1,7 @@
 #pragma once
 #include "RenderPasses/RenderPass.h"
 #include "ShaderPasses/RayTracingPass.h"
+#include <unordered_map>
 
 enum class FurnaceMode : uint32_t
 {
@@ -8,35 +9,60 @@ enum class FurnaceMode : uint32_t
     WeakWhiteFurnace = 1,
 };
 
+// Must match kLightSampler* in LightSampler.slang
+enum class LightSamplerMode : uint32_t
+{
+    AliasTable = 0, // Global flux-weighted alias table
+    LightBVH = 1,   // Receiver-aware Light BVH traversal
+};
+
+// Must match kTextureLOD* in PathTracing.slang
+enum class TextureLODMode : uint32_t
+{
+    Mip0 = 0,     // Always sample the finest level
+    RayCones = 1, // Footprint from ray cones, widened at each scatter by the sampled lobe
+};
+
 class PathTracingPass : public RenderPass
 {
 public:
     PathTracingPass(ref<Device> pDevice);
 
-    RenderData execute(const RenderData& input = RenderData()) override;
+    void execute(RenderContext& context, const RenderData& input = RenderData()) override;
 
     void renderUI() override;
 
     void setMissColor(float c) { mGColorSlider = c; }
     void setFurnaceMode(FurnaceMode mode);
+    void setNEE(bool enabled);
+    void setLightSamplerMode(LightSamplerMode mode) { mLightSamplerMode = mode; }
+    void setTextureLODMode(TextureLODMode mode) { mTextureLODMode = mode; }
 
     void setScene(ref<Scene> pScene) override
     {
         mpScene = pScene;
-        // Store a pointer to the live CPU-side CameraData. RayTracingPass uploads all
-        // registered constant buffers right before dispatch, so per-frame jitter updates
-        // written by Camera::calculateCameraParameters() are visible on the GPU.
-        mpPass->addConstantBuffer(mCbCamera, &mpScene->camera->getCameraData(), sizeof(CameraData));
+        // Store a pointer to the live CPU-side CameraData. RayTracingPass uploads every
+        // registered constant buffer whose data changed right before dispatch, so per-frame
+        // jitter updates written by Camera::calculateCameraParameters() are visible on the GPU.
+        mpCameraConstants = make_ref<ConstantBuffer>(ConstantBuffer{mCbCamera, &mpScene->camera->getCameraData(), sizeof(CameraData), {}});
+        for (auto& [key, variant] : mVariants)
+            variant.pass->addConstantBuffer(mpCameraConstants);
     }
 
+    // Program variants compiled so far; switching back to one of them costs no compile
+    size_t getVariantCount() const { return mVariants.size(); }
+
     // RenderGraph interface
     std::string getName() const override { return "PathTracing"; }
     std::vector<RenderPassInput> getInputs() const override { return {}; } // No inputs, generates from scene
-    std::vector<RenderPassOutput> getOutputs() const override { return {RenderPassOutput("output", RenderDataType::Texture2D)}; }
+    std::vector<RenderPassOutput> getOutputs() const override
+    {
+        return {RenderPassOutput("output", nvrhi::Format::RGBA32_FLOAT, RenderPassOutputLifetime::Transient)};
+    }
 
 private:
     void prepareResources();
-    void buildRayTracingPass();
+    void selectVariant();
 
     uint32_t mWidth;
     uint32_t mHeight;
@@ -44,6 +70,9 @@ private:
     uint32_t mMaxDepth = 10;
     float mGColorSlider = 0.f; // UI slider value
     FurnaceMode mFurnaceMode = FurnaceMode::Off;
+    bool mUseNEE = true;
+    LightSamplerMode mLightSamplerMode = LightSamplerMode::LightBVH;
+    TextureLODMode mTextureLODMode = TextureLODMode::RayCones;
 
     struct PerFrameCB
     {
@@ -53,13 +82,48 @@ private:
         uint32_t frameCount;
         float gColor;
         uint32_t emissiveTriangleCount;
-        float totalEmissiveArea;
-        uint32_t _cbPadding;
+        float totalEmissivePower;
+        uint32_t lightSamplerMode;
+        uint32_t textureLODMode;
     } mPerFrameData;
 
     nvrhi::BufferHandle mCbPerFrame;
     nvrhi::BufferHandle mCbCamera;
+    // Shared by every variant, so a variant selected again knows what the others uploaded meanwhile
+    ref<ConstantBuffer> mpPerFrameConstants;
+    ref<ConstantBuffer> mpCameraConstants;
     nvrhi::TextureHandle mTextureOut;
     nvrhi::SamplerHandle mTextureSampler;
+    // Resolved once per variant
+    struct BindingSlots
+    {
+        uint32_t perFrameCB = BindingSetManager::kInvalidSlot;
+        uint32_t camera = BindingSetManager::kInvalidSlot;
+        uint32_t vertices = BindingSetManager::kInvalidSlot;
+        uint32_t indices = BindingSetManager::kInvalidSlot;
+        uint32_t meshes = BindingSetManager::kInvalidSlot;
+        uint32_t instances = BindingSetManager::kInvalidSlot;
+        uint32_t materials = BindingSetManager::kInvalidSlot;
+        uint32_t rtAccel = BindingSetManager::kInvalidSlot;
+        uint32_t emissiveTriangles = BindingSetManager::kInvalidSlot;
+        uint32_t emissiveAliasTable = BindingSetManager::kInvalidSlot;
+        uint32_t lightBVHNodes = BindingSetManager::kInvalidSlot;
+        uint32_t lightBVHBitTrails = BindingSetManager::kInvalidSlot;
+        uint32_t materialTextures = BindingSetManager::kInvalidSlot;
+        uint32_t sampler = BindingSetManager::kInvalidSlot;
+        uint32_t result = BindingSetManager::kInvalidSlot;
+    };
+
+    // Feature switches are link-time constants of PathTracing.slang, so each combination is its own pipeline.
+    // Variants are built on first use and kept; selecting one swaps mpPass and mSlots.
+    struct Variant
+    {
+        ref<RayTracingPass> pass;
+        BindingSlots slots;
+    };
+    Variant buildVariant();
+
+    std::unordered_map<uint32_t, Variant> mVariants; // Keyed by furnace mode and NEE bit
     ref<RayTracingPass> mpPass;
+    BindingSlots mSlots;
 };
@@ -45,6 +45,7 @@ bool RenderGraph::build(const std::vector<RenderGraphNode>& nodes, const std::ve
         LOG_ERROR("Topological sort failed - circular dependency detected");
         return false;
     }
+    compilePlan();
     LOG_INFO("Render graph built successfully");
     return true;
 }
@@ -207,39 +208,307 @@ bool RenderGraph::topologicalSort()
     return true;
 }
 
-RenderData RenderGraph::execute()
+void RenderGraph::compilePlan()
 {
-    mIntermediateResults.clear();
-    RenderData finalOutput;
-    for (const auto& nodeIndex : mExecutionOrder)
+    // Resource slots follow mAvailableOutputs: every node's outputs, in node order
+    std::unordered_map<std::string, uint32_t> slotByKey;
+    for (uint32_t slot = 0; slot < mAvailableOutputs.size(); ++slot)
+        slotByKey[mAvailableOutputs[slot]] = slot;
+    mResources.assign(mAvailableOutputs.size(), nullptr);
+
+    mFinalOutput = RenderData();
+    mFinalOutputEntries.clear();
+    for (const std::string& key : mAvailableOutputs)
+        mFinalOutputEntries.push_back(&mFinalOutput[key]);
+
+    // Walk the dependencies back from the selected output and from every pass with side effects; the rest is culled
+    std::vector<uint> pending;
+    mPlannedOutputIndex = mSelectedOutputIndex;
+    mPlannedSideEffects.assign(mNodes.size(), false);
+    for (uint i = 0; i < mNodes.size(); ++i)
+    {
+        mPlannedSideEffects[i] = mNodes[i].pass->hasSideEffects();
+        if (mPlannedSideEffects[i])
+            pending.push_back(i);
+        for (const auto& output : mNodes[i].pass->getOutputs())
+            if (mNodes[i].name + "." + output.name == mSelectedOutputKey)
+                pending.push_back(i);
+    }
+    mIsLive.assign(mNodes.size(), false);
+    while (!pending.empty())
     {
-        RenderData result = executePass(nodeIndex);
-        mIntermediateResults[mNodes[nodeIndex].name] = result;
-        for (const auto& output : mNodes[nodeIndex].pass->getOutputs())
-            finalOutput[mNodes[nodeIndex].name + "." + output.name] = result[output.name];
+        const uint nodeIndex = pending.back();
+        pending.pop_back();
+        if (mIsLive[nodeIndex])
+            continue;
+        mIsLive[nodeIndex] = true;
+        pending.insert(pending.end(), mDependencies[nodeIndex].begin(), mDependencies[nodeIndex].end());
+    }
+
+    std::vector<uint> liveOrder;
+    for (uint nodeIndex : mExecutionOrder)
+        if (mIsLive[nodeIndex])
+            liveOrder.push_back(nodeIndex);
+
+    // Sized up front: the bindings point into each step's own input RenderData
+    mSteps.clear();
+    mSteps.resize(liveOrder.size());
+    for (size_t i = 0; i < liveOrder.size(); ++i)
+    {
+        ExecutionStep& step = mSteps[i];
+        const RenderGraphNode& node = mNodes[liveOrder[i]];
+        step.nodeIndex = liveOrder[i];
+        step.pPass = node.pass.get();
+        for (const auto& conn : mConnections)
+        {
+            if (conn.toPass != node.name)
+                continue;
+            RenderDataType type = RenderDataType::Unknown;
+            for (const auto& output : mNodes[findNode(conn.fromPass)].pass->getOutputs())
+                if (output.name == conn.fromOutput)
+                    type = output.type;
+            for (const auto& input : node.pass->getInputs())
+                if (input.name == conn.toInput && type == RenderDataType::Unknown)
+                    type = input.type;
+            step.inputs.push_back({slotByKey.at(conn.fromPass + "." + conn.fromOutput), &step.input[conn.toInput], type});
+        }
+        const std::vector<RenderPassOutput> outputs = node.pass->getOutputs();
+        for (uint32_t outputIndex = 0; outputIndex < outputs.size(); ++outputIndex)
+            step.outputs.push_back({outputIndex, slotByKey.at(node.name + "." + outputs[outputIndex].name)});
     }
+
+    mIsAllocationStale = true;
+    LOG_DEBUG("[RenderGraph] Executing {} of {} passes for '{}'", mSteps.size(), mNodes.size(), mSelectedOutputKey);
+}
+
+bool RenderGraph::isPlanStale() const
+{
+    if (mSelectedOutputIndex != mPlannedOutputIndex)
+        return true;
+    for (uint i = 0; i < mNodes.size(); ++i)
+        if (mNodes[i].pass->hasSideEffects() != mPlannedSideEffects[i])
+            return true;
+    return false;
+}
+
+const RenderData& RenderGraph::execute()
+{
+    const uint32_t submissionsBefore = mpRenderContext->getSubmissionCount();
+    if (isPlanStale())
+        compilePlan();
+    allocateOutputs();
+    std::fill(mResources.begin(), mResources.end(), nullptr);
+    for (ExecutionStep& step : mSteps)
+        executeStep(step);
+    for (size_t slot = 0; slot < mResources.size(); ++slot)
+        *mFinalOutputEntries[slot] = mResources[slot];
+
+    resolveFinalOutput();
+    mpRenderContext->submit();
+    mLastSubmissionCount = mpRenderContext->getSubmissionCount() - submissionsBefore;
     GUI::clearRefreshFlags();
-    return finalOutput;
+    return mFinalOutput;
 }
 
-RenderData RenderGraph::executePass(int nodeIndex)
+void RenderGraph::executeStep(ExecutionStep& step)
 {
-    RenderData input;
-    for (const auto& conn : mConnections)
+    // Each edge is a read of the producer's output; transition them all in one batch before the pass records
+    bool hasBarriers = false;
+    for (const InputBinding& binding : step.inputs)
     {
-        if (conn.toPass == mNodes[nodeIndex].name)
+        const nvrhi::ResourceHandle& resource = mResources[binding.resourceSlot];
+        *binding.pInput = resource;
+        if (!resource)
+            continue;
+
+        nvrhi::ICommandList* pCommandList = mpRenderContext->getCommandList();
+        switch (binding.type)
         {
-            auto it = mIntermediateResults.find(conn.fromPass);
-            auto resource = it->second[conn.fromOutput];
-            input[conn.toInput] = resource;
+        case RenderDataType::Texture2D:
+            pCommandList->setTextureState(
+                static_cast<nvrhi::ITexture*>(resource.Get()), nvrhi::AllSubresources, nvrhi::ResourceStates::ShaderResource
+            );
+            break;
+        case RenderDataType::Buffer:
+            pCommandList->setBufferState(static_cast<nvrhi::IBuffer*>(resource.Get()), nvrhi::ResourceStates::ShaderResource);
+            break;
+        default:
+            // Neither side declared what flows over this edge
+            if (auto pTexture = dynamic_cast<nvrhi::ITexture*>(resource.Get()))
+                pCommandList->setTextureState(pTexture, nvrhi::AllSubresources, nvrhi::ResourceStates::ShaderResource);
+            else if (auto pBuffer = dynamic_cast<nvrhi::IBuffer*>(resource.Get()))
+                pCommandList->setBufferState(pBuffer, nvrhi::ResourceStates::ShaderResource);
+            break;
         }
+        hasBarriers = true;
     }
-    return mNodes[nodeIndex].pass->execute(input);
+
+    if (step.nodeIndex < mAliasingBarrierBeforePass.size() && mAliasingBarrierBeforePass[step.nodeIndex])
+    {
+        nvrhi::ICommandList* pCommandList = mpRenderContext->getCommandList();
+        for (const nvrhi::TextureHandle& texture : mRetiredBeforePass[step.nodeIndex])
+            pCommandList->setTextureState(texture, nvrhi::AllSubresources, texture->getDesc().initialState);
+        pCommandList->commitBarriers();
+        hasBarriers = false;
+
+        // NVRHI has no aliasing barriers; any placed resource may be the previous user of the memory
+        D3D12_RESOURCE_BARRIER barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+        static_cast<ID3D12GraphicsCommandList*>(pCommandList->getNativeObject(nvrhi::ObjectTypes::D3D12_GraphicsCommandList))
+            ->ResourceBarrier(1, &barrier);
+    }
+    if (hasBarriers)
+        mpRenderContext->getCommandList()->commitBarriers();
+
+    step.pPass->clearOutputs();
+    step.pPass->execute(*mpRenderContext, step.input);
+    for (const OutputBinding& output : step.outputs)
+        mResources[output.resourceSlot] = step.pPass->getOutput(output.outputIndex);
+}
+
+void RenderGraph::allocateOutputs()
+{
+    if (!mpScene || !mpScene->camera)
+        return;
+    const uint32_t width = mpScene->camera->getWidth();
+    const uint32_t height = mpScene->camera->getHeight();
+    const bool isResized = width != mAllocatedWidth || height != mAllocatedHeight;
+    if (width == 0 || height == 0 || (!isResized && !mIsAllocationStale))
+        return;
+    mAllocatedWidth = width;
+    mAllocatedHeight = height;
+    mIsAllocationStale = false;
+    const int directOutputIndex = mDirectOutputIndex;
+    const nvrhi::TextureHandle directOutputTexture = mDirectOutputTexture;
+    mDirectOutputIndex = -1;
+    mDirectOutputTexture = nullptr;
+
+    auto pNvrhiDevice = mpDevice->getDevice();
+    std::vector<uint32_t> position(mNodes.size(), 0);
+    for (uint32_t i = 0; i < mSteps.size(); ++i)
+        position[mSteps[i].nodeIndex] = i;
+
+    struct Transient
+    {
+        uint nodeIndex;
+        std::string outputName;
+        nvrhi::TextureHandle texture;
+    };
+    std::vector<Transient> transients;
+    std::vector<TransientResourcePlanner::Request> requests;
+    for (uint nodeIndex = 0; nodeIndex < mNodes.size(); ++nodeIndex)
+    {
+        const RenderGraphNode& node = mNodes[nodeIndex];
+        for (const auto& output : node.pass->getOutputs())
+        {
+            if (output.lifetime == RenderPassOutputLifetime::External || output.format == nvrhi::Format::UNKNOWN)
+                continue;
+
+            // The selected output starts and ends every frame as a shader resource, so the display samples it in place
+            const std::string key = node.name + "." + output.name;
+            const bool isDisplayed = key == mSelectedOutputKey;
+            const bool wasDisplayed = directOutputIndex >= 0 && key == mAvailableOutputs[directOutputIndex];
+            const nvrhi::ResourceStates initialState = isDisplayed ? nvrhi::ResourceStates::ShaderResource : nvrhi::ResourceStates::UnorderedAccess;
+            if (isDisplayed)
+                mDirectOutputIndex = mSelectedOutputIndex;
+            nvrhi::TextureDesc desc = nvrhi::TextureDesc()
+                                          .setWidth(width)
+                                          .setHeight(height)
+                                          .setFormat(output.format)
+                                          .setInitialState(initialState)
+                                          .setDebugName("RenderGraph/" + key)
+                                          .setIsUAV(true)
+                                          .setKeepInitialState(true);
+
+            // Recreating a persistent output loses what it holds, so only a resize or a new initial state does it
+            if (output.lifetime == RenderPassOutputLifetime::Persistent)
+            {
+                if (isResized || isDisplayed != wasDisplayed)
+                {
+                    nvrhi::TextureHandle texture = pNvrhiDevice->createTexture(desc);
+                    node.pass->setOutputTexture(output.name, texture);
+                    if (isDisplayed)
+                        mDirectOutputTexture = texture;
+                }
+                else if (isDisplayed)
+                {
+                    mDirectOutputTexture = directOutputTexture;
+                }
+                continue;
+            }
+
+            // Culled passes get no memory; the texture of an earlier plan would keep its heap alive
+            if (!mIsLive[nodeIndex])
+            {
+                node.pass->setOutputTexture(output.name, nullptr);
+                continue;
+            }
+
+            // Live from the pass that writes it to its last reader; the selected output until the display reads it
+            uint32_t lastUse = isDisplayed ? static_cast<uint32_t>(mSteps.size()) : position[nodeIndex];
+            for (const auto& conn : mConnections)
+            {
+                const int toNodeIndex = findNode(conn.toPass);
+                if (conn.fromPass == node.name && conn.fromOutput == output.name && mIsLive[toNodeIndex])
+                    lastUse = std::max(lastUse, position[toNodeIndex]);
+            }
+
+            desc.setIsVirtual(true);
+            nvrhi::TextureHandle texture = pNvrhiDevice->createTexture(desc);
+            if (isDisplayed)
+                mDirectOutputTexture = texture;
+            const nvrhi::MemoryRequirements requirements = pNvrhiDevice->getTextureMemoryRequirements(texture);
+            requests.push_back({requirements.size, requirements.alignment, position[nodeIndex], lastUse});
+            transients.push_back({nodeIndex, output.name, texture});
+        }
+    }
+
+    const TransientResourcePlanner::Plan plan = TransientResourcePlanner::plan(requests);
+    mTransientHeap = nullptr;
+    if (plan.heapSizeBytes > 0)
+    {
+        nvrhi::HeapDesc heapDesc;
+        heapDesc.capacity = plan.heapSizeBytes;
+        heapDesc.type = nvrhi::HeapType::DeviceLocal;
+        heapDesc.debugName = "RenderGraph/TransientHeap";
+        mTransientHeap = pNvrhiDevice->createHeap(heapDesc);
+        if (!mTransientHeap)
+            LOG_ERROR_THROW("[RenderGraph] Failed to create a {} byte transient heap", plan.heapSizeBytes);
+    }
+
+    mAliasingBarrierBeforePass.assign(mNodes.size(), false);
+    mRetiredBeforePass.assign(mNodes.size(), {});
+    for (size_t i = 0; i < transients.size(); ++i)
+    {
+        if (!pNvrhiDevice->bindTextureMemory(transients[i].texture, mTransientHeap, plan.offsets[i]))
+            LOG_ERROR_THROW("[RenderGraph] Failed to place '{}' in the transient heap", transients[i].texture->getDesc().debugName);
+        mNodes[transients[i].nodeIndex].pass->setOutputTexture(transients[i].outputName, transients[i].texture);
+
+        for (size_t other : plan.sharesMemoryWith[i])
+        {
+            mAliasingBarrierBeforePass[transients[i].nodeIndex] = true;
+            if (requests[other].lastUse < requests[i].firstUse)
+                mRetiredBeforePass[transients[i].nodeIndex].push_back(transients[other].texture);
+        }
+    }
+
+    mTransientHeapBytes = plan.heapSizeBytes;
+    mTransientRequestedBytes = plan.requestedBytes;
+    LOG_INFO(
+        "[RenderGraph] {} transient outputs at {}x{}: {:.1f} MB heap, {:.1f} MB without aliasing",
+        transients.size(),
+        width,
+        height,
+        plan.heapSizeBytes / (1024.0 * 1024.0),
+        plan.requestedBytes / (1024.0 * 1024.0)
+    );
 }
 
 void RenderGraph::setScene(ref<Scene> pScene)
 {
+    // Before the passes see the scene, so they find their graph-created outputs and skip creating their own
     mpScene = pScene;
+    allocateOutputs();
     for (auto& node : mNodes)
         node.pass->setScene(pScene);
 }
@@ -256,29 +525,40 @@ bool RenderGraph::isUpstreamOfAccumulator(const std::string& name) const
     return index >= 0 && mAccumulationResetPasses.count(static_cast<uint>(index));
 }
 
-nvrhi::TextureHandle RenderGraph::getFinalOutputTexture()
+bool RenderGraph::isCulled(const std::string& name) const
 {
-    size_t dotPos = mSelectedOutputKey.find('.');
-    std::string passName = mSelectedOutputKey.substr(0, dotPos);
-    std::string outputName = mSelectedOutputKey.substr(dotPos + 1);
-    auto it = mIntermediateResults.find(passName);
-    nvrhi::TextureHandle sourceTexture = static_cast<nvrhi::ITexture*>(it->second[outputName].Get());
+    int index = findNode(name);
+    return index >= 0 && static_cast<size_t>(index) < mIsLive.size() && !mIsLive[index];
+}
+
+void RenderGraph::resolveFinalOutput()
+{
+    if (mSelectedOutputIndex < 0 || mSelectedOutputIndex >= static_cast<int>(mResources.size()))
+        return;
+    nvrhi::TextureHandle sourceTexture = dynamic_cast<nvrhi::ITexture*>(mResources[mSelectedOutputIndex].Get());
+    if (!sourceTexture)
+        return;
+
+    // Allocated to return to ShaderResource when the frame's command list closes; nothing to record. Compared by
+    // handle: a pass may publish some other texture (e.g. its input) under the selected output.
+    mIsFinalOutputCopied = sourceTexture != mDirectOutputTexture;
+    if (!mIsFinalOutputCopied)
+    {
+        mOutputTexture = sourceTexture;
+        return;
+    }
+
     const auto& sourceDesc = sourceTexture->getDesc();
-    if (!mOutputTexture)
+    if (!mOutputCopyTexture)
         createOutputTexture(sourceDesc.width, sourceDesc.height, sourceDesc.format);
-    const auto& destDesc = mOutputTexture->getDesc();
+    const auto& destDesc = mOutputCopyTexture->getDesc();
     if (sourceDesc.width != destDesc.width || sourceDesc.height != destDesc.height || sourceDesc.format != destDesc.format)
         createOutputTexture(sourceDesc.width, sourceDesc.height, sourceDesc.format);
 
-    // Copy the source texture to our managed output texture
-    auto commandList = mpDevice->getCommandList();
-    commandList->open();
+    // Copy the source texture to our managed output texture as the last command of the frame
     nvrhi::TextureSlice slice;
-    commandList->copyTexture(mOutputTexture, slice, sourceTexture, slice);
-    commandList->close();
-    mpDevice->getDevice()->executeCommandList(commandList);
-
-    return mOutputTexture;
+    mpRenderContext->getCommandList()->copyTexture(mOutputCopyTexture, slice, sourceTexture, slice);
+    mOutputTexture = mOutputCopyTexture;
 }
 
 void RenderGraph::createOutputTexture(uint32_t width, uint32_t height, nvrhi::Format format)
@@ -296,7 +576,7 @@ void RenderGraph::createOutputTexture(uint32_t width, uint32_t height, nvrhi::Fo
     desc.initialState = nvrhi::ResourceStates::ShaderResource;
     desc.keepInitialState = true;
     desc.debugName = "RenderGraph/OutputTexture";
-    mOutputTexture = mpDevice->getDevice()->createTexture(desc);
+    mOutputCopyTexture = mpDevice->getDevice()->createTexture(desc);
 }
 
 void RenderGraph::renderOutputSelectionUI()
@@ -312,3 +592,13 @@ void RenderGraph::renderOutputSelectionUI()
     if (GUI::Combo("Output", &mSelectedOutputIndex, outputNames.data(), static_cast<int>(outputNames.size())))
         mSelectedOutputKey = mAvailableOutputs[mSelectedOutputIndex];
 }
+
+bool RenderGraph::selectOutput(const std::string& key)
+{
+    auto it = std::find(mAvailableOutputs.begin(), mAvailableOutputs.end(), key);
+    if (it == mAvailableOutputs.end())
+        return false;
+    mSelectedOutputIndex = static_cast<int>(it - mAvailableOutputs.begin());
+    mSelectedOutputKey = key;
+    return true;
+}
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "RenderPass.h"
+#include "TransientResourcePlanner.h"
 #include "Core/Pointer.h"
 
 struct RenderGraphConnection
@@ -45,7 +46,7 @@ enum class RenderGraphBuildStatus
 class RenderGraph
 {
 public:
-    RenderGraph(ref<Device> pDevice) : mpDevice(pDevice), mSelectedOutputIndex(0) {}
+    RenderGraph(ref<Device> pDevice) : mpDevice(pDevice), mpRenderContext(make_ref<RenderContext>(pDevice)), mSelectedOutputIndex(0) {}
     ~RenderGraph() = default;
 
     // Core graph building from external data
@@ -58,15 +59,28 @@ public:
     // Status from the most recent create() call. Reset to Ok at the top of each create().
     static RenderGraphBuildStatus lastBuildStatus() { return sLastBuildStatus; }
 
-    // Execute the entire render graph
-    RenderData execute();
+    // Record every pass, and the copy of the selected output if it needs one, into one command list and submit it.
+    // Returns every pass output keyed "<pass>.<output>"; valid until the next execute().
+    const RenderData& execute();
 
-    // Get the final output texture for display (based on UI selection)
-    nvrhi::TextureHandle getFinalOutputTexture();
+    // Output selected in the UI as of the last execute(), in the ShaderResource state. A graph-created output is
+    // returned as is; one a pass creates itself is copied, since the graph does not own its state.
+    nvrhi::TextureHandle getFinalOutputTexture() const { return mOutputTexture; }
+    bool isFinalOutputCopied() const { return mIsFinalOutputCopied; }
+
+    // Command lists submitted by the last execute(), readbacks of passes such as TextureAverage excluded
+    uint32_t getLastSubmissionCount() const { return mLastSubmissionCount; }
+
+    // Memory of the transient pass outputs: the shared heap, and what they would take with a heap each
+    uint64_t getTransientHeapBytes() const { return mTransientHeapBytes; }
+    uint64_t getTransientRequestedBytes() const { return mTransientRequestedBytes; }
 
     // Render UI for output selection
     void renderOutputSelectionUI();
 
+    // Select the displayed output by its "<pass>.<output>" key; false if no pass has it
+    bool selectOutput(const std::string& key);
+
     // Set scene for all passes that need it
     void setScene(ref<Scene> pScene);
 
@@ -76,6 +90,10 @@ public:
     const std::vector<uint>& getExecutionOrder() const { return mExecutionOrder; }
     bool isUpstreamOfAccumulator(const std::string& name) const;
 
+    // Skipped by execute(): feeds neither the selected output nor a pass with side effects. As of the last plan,
+    // which execute() recompiles when the selection or a pass's hasSideEffects() changes.
+    bool isCulled(const std::string& name) const;
+
     template<typename T>
     ref<T> getPassByName(const std::string& name) const
     {
@@ -93,11 +111,15 @@ private:
     void buildDependencyGraph();
     void buildAccumulationResetMap();
 
-    RenderData executePass(int nodeIndex);
+    bool isPlanStale() const;
+    void compilePlan();
+    void allocateOutputs();
+    void resolveFinalOutput();
     int findNode(const std::string& name) const;
     void createOutputTexture(uint32_t width, uint32_t height, nvrhi::Format format);
 
     ref<Device> mpDevice;
+    ref<RenderContext> mpRenderContext;
     ref<Scene> mpScene;
 
     std::vector<RenderGraphNode> mNodes;
@@ -105,11 +127,60 @@ private:
     std::vector<std::unordered_set<uint>> mDependencies; // Node indices this node depends on
     std::vector<uint> mExecutionOrder;
     std::unordered_set<uint> mAccumulationResetPasses;                // Node indices upstream of (and including) the accumulator
-    std::unordered_map<std::string, RenderData> mIntermediateResults; // UI state for output selection
     std::string mSelectedOutputKey;
-    std::vector<std::string> mAvailableOutputs;
+    std::vector<std::string> mAvailableOutputs; // "<pass>.<output>", indexed by resource slot
     int mSelectedOutputIndex;
     nvrhi::TextureHandle mOutputTexture;
+    nvrhi::TextureHandle mOutputCopyTexture;
+    bool mIsFinalOutputCopied = false;
+    uint32_t mLastSubmissionCount = 0;
+
+    // Execution plan compiled by build(), so execute() moves handles between integer slots and does no string
+    // lookups, casts or allocation. A resource slot is one pass output, numbered like mAvailableOutputs. Only the
+    // nodes the selected output or a side-effect pass depends on get a step.
+    struct InputBinding
+    {
+        uint32_t resourceSlot;
+        nvrhi::ResourceHandle* pInput; // Entry of the step's input RenderData; unordered_map entries never move
+        RenderDataType type;           // Declared by the producer (or else the consumer); picks the state transition
+    };
+    struct OutputBinding
+    {
+        uint32_t outputIndex; // In the pass's getOutputs(), as published with RenderPass::setOutput
+        uint32_t resourceSlot;
+    };
+    struct ExecutionStep
+    {
+        uint nodeIndex;
+        RenderPass* pPass;
+        RenderData input; // Reused every frame, with an entry per connected input
+        std::vector<InputBinding> inputs;
+        std::vector<OutputBinding> outputs;
+    };
+    void executeStep(ExecutionStep& step);
+
+    std::vector<ExecutionStep> mSteps;     // In execution order
+    std::vector<bool> mIsLive;             // Per node
+    std::vector<bool> mPlannedSideEffects; // Per node, hasSideEffects() when the plan was compiled
+    int mPlannedOutputIndex = -1;
+    std::vector<nvrhi::ResourceHandle> mResources;
+    RenderData mFinalOutput;
+    std::vector<nvrhi::ResourceHandle*> mFinalOutputEntries; // Per resource slot
+
+    // Graph-created pass outputs, rebuilt when the camera resolution or the plan changes. Transients whose
+    // lifetimes do not overlap share memory in mTransientHeap; a pass that writes one gets an aliasing barrier first,
+    // after the dead transients in the same memory are returned to their initial state.
+    nvrhi::HeapHandle mTransientHeap;
+    uint64_t mTransientHeapBytes = 0;
+    uint64_t mTransientRequestedBytes = 0;
+    uint32_t mAllocatedWidth = 0;
+    uint32_t mAllocatedHeight = 0;
+    bool mIsAllocationStale = true; // Set by compilePlan(): lifetimes follow the steps
+    int mDirectOutputIndex = -1;    // Selected output allocated to end the frame as a shader resource; -1 if none
+    // The texture allocated for that output; the display samples only this handle in place, anything else is copied
+    nvrhi::TextureHandle mDirectOutputTexture;
+    std::vector<bool> mAliasingBarrierBeforePass;                      // Per node
+    std::vector<std::vector<nvrhi::TextureHandle>> mRetiredBeforePass; // Per node
 
     static RenderGraphBuildStatus sLastBuildStatus;
 };
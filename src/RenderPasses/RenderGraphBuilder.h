@@ -1,23 +1,40 @@
 #pragma once
+#include <future>
+
 #include "RenderGraph.h"
 #include "PathTracingPass/PathTracing.h"
 #include "AccumulatePass/Accumulate.h"
 #include "ToneMappingPass/ToneMapping.h"
 #include "ErrorMeasurePass/ErrorMeasure.h"
 #include "Utils/TextureAverage/TextureAverage.h"
+#include "Utils/ThreadPool.h"
 
 class RenderGraphBuilder
 {
 public:
+    // Construct a pass on the ThreadPool. Its shaders compile on a leased ShaderCompiler context and its pipeline
+    // is created as soon as they are ready, so passes requested together build concurrently.
+    template<typename T>
+    static std::future<ref<RenderPass>> createPassAsync(ref<Device> pDevice)
+    {
+        return ThreadPool::get().submit([pDevice]() -> ref<RenderPass> { return make_ref<T>(pDevice); });
+    }
+
     static ref<RenderGraph> createDefaultGraph(ref<Device> pDevice)
     {
-        // Create nodes
+        // Create nodes; startup takes about as long as the slowest pass instead of the sum of all of them
+        std::future<ref<RenderPass>> pathTracing = createPassAsync<PathTracingPass>(pDevice);
+        std::future<ref<RenderPass>> accumulate = createPassAsync<AccumulatePass>(pDevice);
+        std::future<ref<RenderPass>> toneMapping = createPassAsync<ToneMappingPass>(pDevice);
+        std::future<ref<RenderPass>> errorMeasure = createPassAsync<ErrorMeasurePass>(pDevice);
+        std::future<ref<RenderPass>> textureAverage = createPassAsync<TextureAverage>(pDevice);
+
         std::vector<RenderGraphNode> nodes;
-        nodes.emplace_back("PathTracing", make_ref<PathTracingPass>(pDevice));
-        nodes.emplace_back("Accumulate", make_ref<AccumulatePass>(pDevice));
-        nodes.emplace_back("ToneMapping", make_ref<ToneMappingPass>(pDevice));
-        nodes.emplace_back("ErrorMeasure", make_ref<ErrorMeasurePass>(pDevice));
-        nodes.emplace_back("TextureAverage", make_ref<TextureAverage>(pDevice));
+        nodes.emplace_back("PathTracing", pathTracing.get());
+        nodes.emplace_back("Accumulate", accumulate.get());
+        nodes.emplace_back("ToneMapping", toneMapping.get());
+        nodes.emplace_back("ErrorMeasure", errorMeasure.get());
+        nodes.emplace_back("TextureAverage", textureAverage.get());
 
         // Create connections
         std::vector<RenderGraphConnection> connections;
@@ -3,8 +3,10 @@
 #include <string>
 #include <functional>
 #include <algorithm>
+#include <unordered_map>
 
 #include "Core/Device.h"
+#include "Core/RenderContext.h"
 #include "Core/RenderData.h"
 #include "Scene/Scene.h"
 #include "Utils/GUI.h"
@@ -40,12 +42,25 @@ struct RenderPassInput
     {}
 };
 
+// Which outputs RenderGraph creates instead of the pass
+enum class RenderPassOutputLifetime
+{
+    External,   // The pass creates the resource itself
+    Transient,  // Written every frame and read only later in the same frame; may share memory with other transients
+    Persistent, // Graph-owned, but read again next frame (e.g. a pass that can skip its dispatch), so never shared
+};
+
 struct RenderPassOutput
 {
     std::string name;
     RenderDataType type;
+    RenderPassOutputLifetime lifetime = RenderPassOutputLifetime::External;
+    nvrhi::Format format = nvrhi::Format::UNKNOWN; // Graph-created outputs are UAV textures at the scene camera's resolution
 
     RenderPassOutput(const std::string& outputName, RenderDataType outputType) : name(outputName), type(outputType) {}
+    RenderPassOutput(const std::string& outputName, nvrhi::Format textureFormat, RenderPassOutputLifetime outputLifetime)
+        : name(outputName), type(RenderDataType::Texture2D), lifetime(outputLifetime), format(textureFormat)
+    {}
 };
 
 class RenderPass
@@ -53,7 +68,9 @@ class RenderPass
 public:
     RenderPass(ref<Device> pDevice) : mpDevice(pDevice) {};
 
-    virtual RenderData execute(const RenderData& input = RenderData()) = 0;
+    // Record the pass into the frame's command list and publish its outputs with setOutput(); RenderGraph submits
+    // the command list after the last pass
+    virtual void execute(RenderContext& context, const RenderData& input = RenderData()) = 0;
 
     virtual void renderUI() = 0;
 
@@ -70,9 +87,57 @@ public:
     // The render graph uses this to determine which upstream passes should trigger a reset.
     virtual bool accumulatesHistory() const { return false; }
 
+    // Returns true if the pass must run even when nothing reads its outputs (e.g. a CPU readback, or history that has
+    // to see every frame). The render graph culls passes that feed neither such a pass nor the selected output.
+    virtual bool hasSideEffects() const { return false; }
+
+    // RenderGraph hands over the textures it created for graph-owned outputs; null clears one
+    void setOutputTexture(const std::string& name, nvrhi::TextureHandle texture)
+    {
+        if (texture)
+            mOutputTextures[name] = texture;
+        else
+            mOutputTextures.erase(name);
+    }
+
+    // What the last execute() published for getOutputs()[index]; null if it published nothing there
+    nvrhi::ResourceHandle getOutput(uint32_t index) const { return index < mPublishedOutputs.size() ? mPublishedOutputs[index] : nullptr; }
+
+    // Lookup by output name for callers outside a graph; RenderGraph resolves the indices once when it compiles its plan
+    nvrhi::ResourceHandle getOutput(const std::string& name) const
+    {
+        const std::vector<RenderPassOutput> outputs = getOutputs();
+        for (uint32_t i = 0; i < outputs.size(); ++i)
+            if (outputs[i].name == name)
+                return getOutput(i);
+        return nullptr;
+    }
+
+    // Forget the published outputs, keeping their storage; RenderGraph calls this before every execute()
+    void clearOutputs() { std::fill(mPublishedOutputs.begin(), mPublishedOutputs.end(), nullptr); }
+
 protected:
+    // Publish the resource behind getOutputs()[index] for this frame
+    void setOutput(uint32_t index, const nvrhi::ResourceHandle& resource)
+    {
+        if (index >= mPublishedOutputs.size())
+            mPublishedOutputs.resize(index + 1);
+        mPublishedOutputs[index] = resource;
+    }
+
+    // The texture RenderGraph created for an output; null outside a graph, where the pass creates its own
+    nvrhi::TextureHandle getOutputTexture(const std::string& name) const
+    {
+        auto it = mOutputTextures.find(name);
+        return it != mOutputTextures.end() ? it->second : nullptr;
+    }
+
     ref<Device> mpDevice;
     ref<Scene> mpScene;
+
+private:
+    std::unordered_map<std::string, nvrhi::TextureHandle> mOutputTextures;
+    std::vector<nvrhi::ResourceHandle> mPublishedOutputs; // By getOutputs() index
 };
 
 struct RenderPassDescriptor
@@ -20,11 +20,14 @@ struct ToneMappingPassRegistration
 
 const std::string kInputName = "input";
 const std::string kOutputName = "output";
+constexpr uint32_t kOutputIndex = 0;
 } // namespace
 
 ToneMappingPass::ToneMappingPass(ref<Device> pDevice) : RenderPass(pDevice)
 {
     mpPass = make_ref<ComputePass>(pDevice, "/src/RenderPasses/ToneMappingPass/ToneMapping.slang", "main");
+    mInputSlot = mpPass->getSlot(kInputName);
+    mOutputSlot = mpPass->getSlot(kOutputName);
 }
 
 std::vector<RenderPassInput> ToneMappingPass::getInputs() const
@@ -34,10 +37,10 @@ std::vector<RenderPassInput> ToneMappingPass::getInputs() const
 
 std::vector<RenderPassOutput> ToneMappingPass::getOutputs() const
 {
-    return {RenderPassOutput(kOutputName, RenderDataType::Texture2D)};
+    return {RenderPassOutput(kOutputName, nvrhi::Format::RGBA32_FLOAT, RenderPassOutputLifetime::Transient)};
 }
 
-RenderData ToneMappingPass::execute(const RenderData& renderData)
+void ToneMappingPass::execute(RenderContext& context, const RenderData& renderData)
 {
     nvrhi::TextureHandle pInputTexture = dynamic_cast<nvrhi::ITexture*>(renderData[kInputName].Get());
     uint2 resolution = uint2(pInputTexture->getDesc().width, pInputTexture->getDesc().height);
@@ -48,16 +51,25 @@ RenderData ToneMappingPass::execute(const RenderData& renderData)
         prepareResources();
     }
 
-    RenderData output;
-    output.setResource(kOutputName, mTextureOut);
-    (*mpPass)[kInputName] = pInputTexture;
-    (*mpPass)[kOutputName] = mTextureOut;
-    mpPass->execute(mWidth, mHeight, 1);
-    return output;
+    nvrhi::TextureHandle pTextureOut = getOutputTexture(kOutputName);
+    if (!pTextureOut)
+        pTextureOut = mTextureOut;
+
+    setOutput(kOutputIndex, pTextureOut);
+    (*mpPass)[mInputSlot] = pInputTexture;
+    (*mpPass)[mOutputSlot] = pTextureOut;
+    mpPass->execute(context, mWidth, mHeight, 1);
 }
 
 void ToneMappingPass::prepareResources()
 {
+    // Inside a RenderGraph the graph creates the output
+    if (getOutputTexture(kOutputName))
+    {
+        mTextureOut = nullptr;
+        return;
+    }
+
     nvrhi::TextureDesc textureDesc = nvrhi::TextureDesc()
                                          .setWidth(mWidth)
                                          .setHeight(mHeight)
@@ -7,7 +7,7 @@ class ToneMappingPass : public RenderPass
 public:
     ToneMappingPass(ref<Device> pDevice);
 
-    RenderData execute(const RenderData& input) override;
+    void execute(RenderContext& context, const RenderData& input) override;
 
     void renderUI() override {}
 
@@ -24,4 +24,6 @@ private:
 
     nvrhi::TextureHandle mTextureOut;
     ref<ComputePass> mpPass;
+    uint32_t mInputSlot = BindingSetManager::kInvalidSlot;
+    uint32_t mOutputSlot = BindingSetManager::kInvalidSlot;
 };
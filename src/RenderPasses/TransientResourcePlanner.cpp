@@ -0,0 +1,55 @@
+#include "TransientResourcePlanner.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return alignment > 1 ? (value + alignment - 1) & ~(alignment - 1) : value;
+}
+} // namespace
+
+TransientResourcePlanner::Plan TransientResourcePlanner::plan(const std::vector<Request>& requests)
+{
+    Plan plan;
+    plan.offsets.assign(requests.size(), 0);
+    plan.sharesMemoryWith.resize(requests.size());
+
+    std::vector<size_t> order(requests.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return requests[a].sizeBytes > requests[b].sizeBytes; });
+
+    std::vector<size_t> placed;
+    std::vector<std::pair<uint64_t, uint64_t>> occupied; // [begin, end) of placed resources live at the same time
+    for (size_t index : order)
+    {
+        const Request& request = requests[index];
+        occupied.clear();
+        for (size_t other : placed)
+            if (livesOverlap(request, requests[other]))
+                occupied.emplace_back(plan.offsets[other], plan.offsets[other] + requests[other].sizeBytes);
+        std::sort(occupied.begin(), occupied.end());
+
+        // Lowest aligned offset that fits below, between or above the live ranges
+        uint64_t offset = 0;
+        for (const auto& [begin, end] : occupied)
+        {
+            if (alignUp(offset, request.alignment) + request.sizeBytes <= begin)
+                break;
+            offset = std::max(offset, end);
+        }
+        offset = alignUp(offset, request.alignment);
+
+        plan.offsets[index] = offset;
+        plan.heapSizeBytes = std::max(plan.heapSizeBytes, offset + request.sizeBytes);
+        plan.requestedBytes += request.sizeBytes;
+        placed.push_back(index);
+    }
+
+    for (size_t i = 0; i < requests.size(); ++i)
+        for (size_t j = 0; j < requests.size(); ++j)
+            if (i != j && plan.offsets[i] < plan.offsets[j] + requests[j].sizeBytes && plan.offsets[j] < plan.offsets[i] + requests[i].sizeBytes)
+                plan.sharesMemoryWith[i].push_back(j);
+    return plan;
+}
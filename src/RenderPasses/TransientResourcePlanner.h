@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+    Places render graph outputs in one heap. A resource is live over an inclusive range of positions in the
+    execution order, from the pass that writes it to the last pass that reads it; resources whose ranges do
+    not overlap may share memory. CPU only, so the placement can be tested without a device.
+*/
+class TransientResourcePlanner
+{
+public:
+    struct Request
+    {
+        uint64_t sizeBytes;
+        uint64_t alignment; // Power of two
+        uint32_t firstUse;
+        uint32_t lastUse;
+    };
+
+    struct Plan
+    {
+        std::vector<uint64_t> offsets;                     // Per request, in request order
+        std::vector<std::vector<size_t>> sharesMemoryWith; // Per request, the others placed over any of its bytes
+        uint64_t heapSizeBytes = 0;
+        uint64_t requestedBytes = 0; // Memory without aliasing
+    };
+
+    // First fit, largest resource first
+    static Plan plan(const std::vector<Request>& requests);
+
+    static bool livesOverlap(const Request& a, const Request& b) { return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse; }
+};
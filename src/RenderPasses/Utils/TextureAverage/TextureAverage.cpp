@@ -32,6 +32,8 @@ constexpr uint32_t kTileHeight = 16;
 TextureAverage::TextureAverage(ref<Device> pDevice) : RenderPass(pDevice)
 {
     mpPass = make_ref<ComputePass>(pDevice, "/src/RenderPasses/Utils/TextureAverage/TextureAverage.slang", "main");
+    mInputSlot = mpPass->getSlot("inputTexture");
+    mResultSlot = mpPass->getSlot("resultBuffer");
     mAverageResult = float4(0.0f);
 }
 
@@ -46,7 +48,7 @@ std::vector<RenderPassOutput> TextureAverage::getOutputs() const
     return {};
 }
 
-RenderData TextureAverage::execute(const RenderData& renderData)
+void TextureAverage::execute(RenderContext& context, const RenderData& renderData)
 {
     mpInputTexture = dynamic_cast<nvrhi::ITexture*>(renderData[kInputName].Get());
 
@@ -54,7 +56,7 @@ RenderData TextureAverage::execute(const RenderData& renderData)
     {
         LOG_WARN("TextureAverage: No input texture provided");
         mAverageResult = float4(0.0f);
-        return RenderData();
+        return;
     }
 
     // Get texture dimensions
@@ -65,7 +67,7 @@ RenderData TextureAverage::execute(const RenderData& renderData)
     if (mWidth == 0 || mHeight == 0)
     {
         mAverageResult = float4(0.0f);
-        return RenderData();
+        return;
     }
 
     const uint32_t tilesX = (mWidth + kTileWidth - 1) / kTileWidth;
@@ -88,18 +90,21 @@ RenderData TextureAverage::execute(const RenderData& renderData)
     }
 
     // Bind resources to compute pass
-    (*mpPass)["inputTexture"] = mpInputTexture;
-    (*mpPass)["resultBuffer"] = mResultBuffer;
+    (*mpPass)[mInputSlot] = mpInputTexture;
+    (*mpPass)[mResultSlot] = mResultBuffer;
 
     // Execute compute pass with one thread per tile
-    mpPass->execute(tilesX, tilesY, 1);
+    mpPass->execute(context, tilesX, tilesY, 1);
+
+    // The readback waits on the queue, so the frame recorded so far has to be on it
+    context.submit();
 
     // Read back the result from GPU
     std::vector<uint8_t> resultData(requiredBytes);
     if (!mResultBuffer || requiredBytes == 0 || !ResourceIO::readbackBuffer(mpDevice, mResultBuffer, resultData.data(), requiredBytes))
     {
         mAverageResult = float4(0.0f);
-        return RenderData();
+        return;
     }
 
     float4 totalSum(0.0f);
@@ -112,11 +117,11 @@ RenderData TextureAverage::execute(const RenderData& renderData)
 
     const float totalPixels = static_cast<float>(static_cast<uint64_t>(mWidth) * static_cast<uint64_t>(mHeight));
     mAverageResult = totalPixels > 0.0f ? totalSum / totalPixels : float4(0.0f);
-    return RenderData();
 }
 
 void TextureAverage::renderUI()
 {
+    ImGui::Checkbox("Measure every frame", &mIsMeasuring);
     GUI::Text("Averages:");
     GUI::Text("(%.5f, %.5f, %.5f, %.5f)", mAverageResult.r, mAverageResult.g, mAverageResult.b, mAverageResult.a);
 }
@@ -8,7 +8,7 @@ class TextureAverage : public RenderPass
 public:
     TextureAverage(ref<Device> pDevice);
 
-    RenderData execute(const RenderData& input) override;
+    void execute(RenderContext& context, const RenderData& input) override;
 
     void renderUI() override;
 
@@ -16,15 +16,19 @@ public:
     std::string getName() const override { return "TextureAverage"; }
     std::vector<RenderPassInput> getInputs() const override;
     std::vector<RenderPassOutput> getOutputs() const override;
+    bool hasSideEffects() const override { return mIsMeasuring; }
 
     float4 getAverageResult() const { return mAverageResult; }
 
 private:
     float4 mAverageResult;
+    bool mIsMeasuring = true; // Off: the graph culls this pass, and whatever feeds only it
 
     nvrhi::BufferHandle mResultBuffer;
     size_t mResultBufferSize = 0;
     ref<ComputePass> mpPass;
+    uint32_t mInputSlot = BindingSetManager::kInvalidSlot;
+    uint32_t mResultSlot = BindingSetManager::kInvalidSlot;
     nvrhi::TextureHandle mpInputTexture;
     uint32_t mWidth = 0;
     uint32_t mHeight = 0;
@@ -2,10 +2,30 @@
 #include <assimp/postprocess.h>
 #include <assimp/pbrmaterial.h>
 #include <assimp/GltfMaterial.h>
+#include <glm/gtc/type_ptr.hpp>
 
 #include "AssimpImporter.h"
 #include "Utils/Logger.h"
 
+namespace
+{
+// Place every mesh referenced by this node subtree as an instance of its shared scene mesh.
+void addNodeInstances(const aiNode* node, const glm::mat4& parentToWorld, const aiScene* aiScene, const std::vector<uint32_t>& meshIds, Scene& scene)
+{
+    // aiMatrix4x4 is row-major with column vectors; make_mat4 reads it transposed.
+    glm::mat4 localToWorld = parentToWorld * glm::transpose(glm::make_mat4(&node->mTransformation.a1));
+
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i)
+    {
+        unsigned int meshIndex = node->mMeshes[i];
+        scene.addInstance(meshIds[meshIndex], aiScene->mMeshes[meshIndex]->mMaterialIndex, localToWorld);
+    }
+
+    for (unsigned int i = 0; i < node->mNumChildren; ++i)
+        addNodeInstances(node->mChildren[i], localToWorld, aiScene, meshIds, scene);
+}
+} // namespace
+
 ref<Scene> AssimpImporter::loadScene(const std::string& fileName)
 {
     // Configure import flags for good geometry processing
@@ -18,7 +38,6 @@ ref<Scene> AssimpImporter::loadScene(const std::string& fileName)
                                     aiProcess_ImproveCacheLocality |     // Optimize vertex cache locality
                                     aiProcess_RemoveRedundantMaterials | // Remove unused materials
                                     aiProcess_OptimizeMeshes |           // Reduce mesh count
-                                    aiProcess_PreTransformVertices |     // Apply node transformations to vertex data
                                     aiProcess_ValidateDataStructure;     // Validate the imported scene
     const aiScene* aiScene = mImporter.ReadFile(fileName, postProcessFlags);
     if (aiScene == nullptr)
@@ -27,17 +46,15 @@ ref<Scene> AssimpImporter::loadScene(const std::string& fileName)
         return nullptr;
     }
 
-    ref<Scene> scene = make_ref<Scene>(mpDevice);
-    // Load meshes
+    ref<Scene> scene = createScene(fileName);
+    // Load each mesh once in its local space; nodes reference meshes and become instances.
+    std::vector<uint32_t> meshIds(aiScene->mNumMeshes, kInvalidMeshId);
     scene->meshes.reserve(aiScene->mNumMeshes);
-    scene->instances.reserve(aiScene->mNumMeshes);
     for (unsigned int i = 0; i < aiScene->mNumMeshes; ++i)
     {
         const aiMesh* aiMesh = aiScene->mMeshes[i];
 
         uint32_t indexOffset = static_cast<uint32_t>(scene->indices.size());
-
-        // aiProcess_PreTransformVertices flattens world xform into positions.
         uint32_t vertexOffset = static_cast<uint32_t>(scene->vertices.size());
         for (unsigned int j = 0; j < aiMesh->mNumVertices; ++j)
         {
@@ -65,8 +82,9 @@ ref<Scene> AssimpImporter::loadScene(const std::string& fileName)
         }
 
         uint32_t indexCount = static_cast<uint32_t>(scene->indices.size()) - indexOffset;
-        scene->addMeshInstance(indexOffset, indexCount, aiMesh->mMaterialIndex);
+        meshIds[i] = scene->addMesh(indexOffset, indexCount);
     }
+    addNodeInstances(aiScene->mRootNode, glm::mat4(1.0f), aiScene, meshIds, *scene);
 
     // Load materials
     scene->materials.reserve(aiScene->mNumMaterials);
@@ -1,6 +1,8 @@
 #include "Importer.h"
 #include "AssimpImporter.h"
 #include "UsdImporter.h"
+#include "SceneCache.h"
+#include "Utils/Logger.h"
 #include <algorithm>
 #include <filesystem>
 #include <unordered_set>
@@ -40,26 +42,77 @@ ImporterType determineImporterType(const std::string& fileName)
         return ImporterType::Assimp;
     return ImporterType::Unknown;
 }
+
+void logTextureMemory(const Scene& scene)
+{
+    auto textureManager = scene.getTextureManager();
+    constexpr double kMiB = 1024.0 * 1024.0;
+    LOG_INFO(
+        "Texture memory: {} textures, {:.1f} MiB ({:.1f} MiB as 32-bit float){}",
+        textureManager->getTextureCount(),
+        textureManager->getTextureMemoryBytes() / kMiB,
+        textureManager->getFloatEquivalentMemoryBytes() / kMiB,
+        textureManager->isCompressionEnabled() ? ", block-compressed" : ""
+    );
+    if (textureManager->getDeduplicatedTextureCount() > 0)
+    {
+        LOG_INFO(
+            "Texture deduplication: {} loads reused an identical texture, {:.1f} MiB saved",
+            textureManager->getDeduplicatedTextureCount(),
+            textureManager->getDeduplicatedBytes() / kMiB
+        );
+    }
+}
 } // namespace
 
-ref<Scene> loadSceneWithImporter(const std::string& fileName, ref<Device> pDevice)
+ref<Scene> Importer::createScene(const std::string& fileName)
 {
+    ref<Scene> scene = make_ref<Scene>(mpDevice);
+    scene->name = fileName;
+    scene->getTextureManager()->setPayloadRecording(mRecordTexturePayloads);
+    scene->getTextureManager()->setCompression(mCompressTextures);
+    return scene;
+}
+
+ref<Scene> loadSceneWithImporter(const std::string& fileName, ref<Device> pDevice, bool useSceneCache, bool compressTextures)
+{
+    if (useSceneCache)
+    {
+        if (ref<Scene> cachedScene = SceneCache::load(fileName, pDevice, compressTextures))
+        {
+            logTextureMemory(*cachedScene);
+            return cachedScene;
+        }
+    }
+
+    std::unique_ptr<Importer> importer;
     ImporterType importerType = determineImporterType(fileName);
 
     switch (importerType)
     {
     case ImporterType::USD:
-    {
-        auto usdImporter = std::make_unique<UsdImporter>(pDevice);
-        return usdImporter->loadScene(fileName);
-    }
+        importer = std::make_unique<UsdImporter>(pDevice);
+        break;
     case ImporterType::Assimp:
-    {
-        auto assimpImporter = std::make_unique<AssimpImporter>(pDevice);
-        return assimpImporter->loadScene(fileName);
-    }
+        importer = std::make_unique<AssimpImporter>(pDevice);
+        break;
     case ImporterType::Unknown:
     default:
         throw std::runtime_error("Unsupported file format: " + getFileExtension(fileName) + " for file: " + fileName);
     }
+
+    importer->setRecordTexturePayloads(useSceneCache);
+    importer->setCompressTextures(compressTextures);
+    ref<Scene> scene = importer->loadScene(fileName);
+    if (scene)
+    {
+        scene->getTextureManager()->flush();
+        logTextureMemory(*scene);
+    }
+    if (scene && useSceneCache)
+    {
+        SceneCache::save(fileName, *scene);
+        scene->getTextureManager()->setPayloadRecording(false);
+    }
+    return scene;
 }
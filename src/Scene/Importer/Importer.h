@@ -9,11 +9,25 @@ class Importer
 {
 public:
     Importer(ref<Device> pDevice) : mpDevice(pDevice) {}
+    virtual ~Importer() = default;
 
     virtual ref<Scene> loadScene(const std::string& fileName) { return nullptr; }
 
+    // Keep CPU copies of uploaded textures so the result can be written to the scene cache
+    void setRecordTexturePayloads(bool enable) { mRecordTexturePayloads = enable; }
+
+    // Block-compress 8-bit textures (BC1/BC4/BC5/BC7) while importing
+    void setCompressTextures(bool enable) { mCompressTextures = enable; }
+
 protected:
+    // Create the scene an importer fills, with importer-wide settings applied
+    ref<Scene> createScene(const std::string& fileName);
+
     ref<Device> mpDevice;
+    bool mRecordTexturePayloads = false;
+    bool mCompressTextures = false;
 };
 
-ref<Scene> loadSceneWithImporter(const std::string& fileName, ref<Device> pDevice);
\ No newline at end of file
+// Load a scene, going through the binary scene cache unless useSceneCache is false.
+// Compressed and uncompressed imports are cached separately.
+ref<Scene> loadSceneWithImporter(const std::string& fileName, ref<Device> pDevice, bool useSceneCache = true, bool compressTextures = false);
@@ -0,0 +1,454 @@
+#include <windows.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "SceneCache.h"
+#include "Utils/Hash.h"
+#include "Utils/Logger.h"
+
+namespace
+{
+constexpr char kMagic[8] = {'0', '0', '7', 'S', 'C', 'E', 'N', 'E'};
+// Bump when the on-disk layout below changes.
+constexpr uint32_t kFormatVersion = 3;
+constexpr uint64_t kSectionAlignment = 16;
+
+struct Section
+{
+    uint64_t offset; // absolute byte offset in the cache file
+    uint64_t count;  // element count (byte count for the string blob)
+};
+
+struct CacheHeader
+{
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t importerVersion;
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+
+    // Element strides guard against silent layout changes of the POD scene structs.
+    uint32_t vertexStride;
+    uint32_t meshStride;
+    uint32_t instanceStride;
+    uint32_t materialStride;
+
+    Section vertices;
+    Section indices;
+    Section meshes;
+    Section instances;
+    Section materials;
+    Section textures;
+    Section dependencies;
+    Section names;
+
+    uint32_t hasCamera;
+    uint32_t cameraWidth;
+    uint32_t cameraHeight;
+    float cameraFovY;
+    float cameraPosition[3];
+    float cameraTarget[3];
+};
+
+struct TextureRecord
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t format; // nvrhi::Format
+    uint32_t mipLevels;
+    uint32_t nameLength;
+    uint32_t _padding0;
+    uint64_t nameOffset; // relative to the names section
+    uint64_t dataOffset; // absolute byte offset in the cache file
+    uint64_t dataSize;
+};
+
+// A file besides the source scene that the import read, e.g. a texture
+struct DependencyRecord
+{
+    uint32_t pathLength;
+    uint32_t _padding0;
+    uint64_t pathOffset; // relative to the names section
+    uint64_t size;
+    uint64_t hash;
+};
+
+// Read-only view of a whole file through a single mapping.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path)
+    {
+        mFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (mFile == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(mFile, &fileSize) || fileSize.QuadPart == 0)
+            return;
+
+        mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mMapping)
+            return;
+
+        mpData = static_cast<const uint8_t*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+        if (mpData)
+            mSize = static_cast<size_t>(fileSize.QuadPart);
+    }
+
+    ~MappedFile()
+    {
+        if (mpData)
+            UnmapViewOfFile(mpData);
+        if (mMapping)
+            CloseHandle(mMapping);
+        if (mFile != INVALID_HANDLE_VALUE)
+            CloseHandle(mFile);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isValid() const { return mpData != nullptr; }
+    const uint8_t* data() const { return mpData; }
+    size_t size() const { return mSize; }
+
+private:
+    HANDLE mFile = INVALID_HANDLE_VALUE;
+    HANDLE mMapping = nullptr;
+    const uint8_t* mpData = nullptr;
+    size_t mSize = 0;
+};
+
+bool hashSourceFile(const std::string& sourcePath, uint64_t& outHash, uint64_t& outSize)
+{
+    MappedFile source(sourcePath);
+    if (!source.isValid())
+        return false;
+    outHash = Hash::hash64(source.data(), source.size());
+    outSize = source.size();
+    return true;
+}
+
+bool isSectionValid(const MappedFile& file, const Section& section, size_t stride)
+{
+    return section.offset <= file.size() && section.count <= (file.size() - section.offset) / stride;
+}
+
+template<typename T>
+void copySection(const MappedFile& file, const Section& section, std::vector<T>& out)
+{
+    const T* pBegin = reinterpret_cast<const T*>(file.data() + section.offset);
+    out.assign(pBegin, pBegin + section.count);
+}
+
+class CacheWriter
+{
+public:
+    explicit CacheWriter(const std::string& path) : mStream(path, std::ios::binary | std::ios::trunc) {}
+
+    bool isValid() const { return mStream.good(); }
+
+    void write(const void* pData, size_t sizeBytes)
+    {
+        mStream.write(static_cast<const char*>(pData), static_cast<std::streamsize>(sizeBytes));
+        mCursor += sizeBytes;
+    }
+
+    void align()
+    {
+        static const char kZeros[kSectionAlignment] = {};
+        uint64_t padding = (kSectionAlignment - mCursor % kSectionAlignment) % kSectionAlignment;
+        write(kZeros, padding);
+    }
+
+    template<typename T>
+    Section writeSection(const std::vector<T>& values)
+    {
+        align();
+        Section section{mCursor, values.size()};
+        write(values.data(), values.size() * sizeof(T));
+        return section;
+    }
+
+    void rewriteHeader(const CacheHeader& header)
+    {
+        mStream.seekp(0);
+        mStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    uint64_t cursor() const { return mCursor; }
+    bool finish()
+    {
+        mStream.close();
+        return !mStream.fail();
+    }
+
+private:
+    std::ofstream mStream;
+    uint64_t mCursor = 0;
+};
+} // namespace
+
+namespace SceneCache
+{
+std::string getCachePath(const std::string& sourcePath, bool compressedTextures)
+{
+    std::filesystem::path source = std::filesystem::absolute(sourcePath).lexically_normal();
+    std::string sourceString = source.string();
+    uint64_t pathHash = Hash::hash64(sourceString.data(), sourceString.size());
+    return fmt::format("{}/scenes/{}-{:016x}{}.scache", PROJECT_CACHE_DIR, source.stem().string(), pathHash, compressedTextures ? "-bc" : "");
+}
+
+ref<Scene> load(const std::string& sourcePath, ref<Device> pDevice, bool compressedTextures)
+{
+    const std::string cachePath = getCachePath(sourcePath, compressedTextures);
+    std::error_code ec;
+    if (!std::filesystem::exists(cachePath, ec))
+        return nullptr;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    uint64_t sourceHash = 0;
+    uint64_t sourceSize = 0;
+    if (!hashSourceFile(sourcePath, sourceHash, sourceSize))
+        return nullptr;
+
+    MappedFile file(cachePath);
+    if (!file.isValid() || file.size() < sizeof(CacheHeader))
+    {
+        LOG_WARN("Scene cache '{}' could not be mapped, re-importing", cachePath);
+        return nullptr;
+    }
+
+    const CacheHeader& header = *reinterpret_cast<const CacheHeader*>(file.data());
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.formatVersion != kFormatVersion ||
+        header.importerVersion != kImporterVersion || header.vertexStride != sizeof(Vertex) || header.meshStride != sizeof(MeshDesc) ||
+        header.instanceStride != sizeof(MeshInstance) || header.materialStride != sizeof(Material))
+    {
+        LOG_INFO("Scene cache '{}' was written by a different build, re-importing", cachePath);
+        return nullptr;
+    }
+    if (header.sourceHash != sourceHash || header.sourceSize != sourceSize)
+    {
+        LOG_INFO("Scene cache '{}' is stale, re-importing", cachePath);
+        return nullptr;
+    }
+
+    if (!isSectionValid(file, header.vertices, sizeof(Vertex)) || !isSectionValid(file, header.indices, sizeof(uint32_t)) ||
+        !isSectionValid(file, header.meshes, sizeof(MeshDesc)) || !isSectionValid(file, header.instances, sizeof(MeshInstance)) ||
+        !isSectionValid(file, header.materials, sizeof(Material)) || !isSectionValid(file, header.textures, sizeof(TextureRecord)) ||
+        !isSectionValid(file, header.dependencies, sizeof(DependencyRecord)) || !isSectionValid(file, header.names, 1))
+    {
+        LOG_WARN("Scene cache '{}' is truncated, re-importing", cachePath);
+        return nullptr;
+    }
+
+    // Every texture the import read must be unchanged too, or the cached payloads are stale
+    const char* names = reinterpret_cast<const char*>(file.data() + header.names.offset);
+    const DependencyRecord* dependencies = reinterpret_cast<const DependencyRecord*>(file.data() + header.dependencies.offset);
+    std::vector<std::string> sourceFiles;
+    for (uint64_t i = 0; i < header.dependencies.count; i++)
+    {
+        const DependencyRecord& record = dependencies[i];
+        if (record.pathOffset + record.pathLength > header.names.count)
+        {
+            LOG_WARN("Scene cache '{}' has a corrupt dependency record, re-importing", cachePath);
+            return nullptr;
+        }
+
+        std::string path(names + record.pathOffset, record.pathLength);
+        uint64_t dependencyHash = 0;
+        uint64_t dependencySize = 0;
+        if (!hashSourceFile(path, dependencyHash, dependencySize) || dependencyHash != record.hash || dependencySize != record.size)
+        {
+            LOG_INFO("Scene cache '{}' is stale: '{}' changed, re-importing", cachePath, path);
+            return nullptr;
+        }
+        sourceFiles.push_back(std::move(path));
+    }
+
+    ref<Scene> scene = make_ref<Scene>(pDevice);
+    scene->name = sourcePath;
+    scene->sourceFiles = std::move(sourceFiles);
+    scene->getTextureManager()->setCompression(compressedTextures);
+    copySection(file, header.vertices, scene->vertices);
+    copySection(file, header.indices, scene->indices);
+    copySection(file, header.meshes, scene->meshes);
+    copySection(file, header.instances, scene->instances);
+    copySection(file, header.materials, scene->materials);
+
+    // Textures are restored in cache order so engine texture IDs match the materials.
+    const TextureRecord* records = reinterpret_cast<const TextureRecord*>(file.data() + header.textures.offset);
+    auto textureManager = scene->getTextureManager();
+    for (uint64_t i = 0; i < header.textures.count; i++)
+    {
+        const TextureRecord& record = records[i];
+        if (record.nameOffset + record.nameLength > header.names.count || record.dataOffset > file.size() ||
+            record.dataSize > file.size() - record.dataOffset)
+        {
+            LOG_WARN("Scene cache '{}' has a corrupt texture record, re-importing", cachePath);
+            return nullptr;
+        }
+
+        std::string name(names + record.nameOffset, record.nameLength);
+        uint32_t textureId = textureManager->loadTextureData(
+            record.width,
+            record.height,
+            static_cast<nvrhi::Format>(record.format),
+            record.mipLevels,
+            file.data() + record.dataOffset,
+            record.dataSize,
+            name
+        );
+        if (textureId != static_cast<uint32_t>(i))
+        {
+            LOG_WARN("Failed to restore cached texture '{}', re-importing", name);
+            return nullptr;
+        }
+    }
+    textureManager->flush();
+
+    if (header.hasCamera)
+    {
+        float3 position(header.cameraPosition[0], header.cameraPosition[1], header.cameraPosition[2]);
+        float3 target(header.cameraTarget[0], header.cameraTarget[1], header.cameraTarget[2]);
+        scene->camera = make_ref<Camera>(position, target, header.cameraFovY, header.cameraWidth, header.cameraHeight);
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    LOG_INFO(
+        "Loaded scene cache '{}' in {:.1f} ms: {} vertices, {} indices, {} meshes, {} instances, {} materials, {} textures",
+        cachePath,
+        elapsedMs,
+        scene->vertices.size(),
+        scene->indices.size(),
+        scene->meshes.size(),
+        scene->instances.size(),
+        scene->materials.size(),
+        header.textures.count
+    );
+    return scene;
+}
+
+bool save(const std::string& sourcePath, const Scene& scene)
+{
+    const auto& payloads = scene.getTextureManager()->getRecordedPayloads();
+    if (!scene.getTextureManager()->areRecordedPayloadsValid())
+    {
+        LOG_WARN("Scene cache not written for '{}': a texture failed to load during import", sourcePath);
+        return false;
+    }
+    if (payloads.size() != scene.getTextureCount())
+    {
+        LOG_WARN("Scene cache not written for '{}': texture payloads were not recorded during import", sourcePath);
+        return false;
+    }
+
+    CacheHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.formatVersion = kFormatVersion;
+    header.importerVersion = kImporterVersion;
+    header.vertexStride = sizeof(Vertex);
+    header.meshStride = sizeof(MeshDesc);
+    header.instanceStride = sizeof(MeshInstance);
+    header.materialStride = sizeof(Material);
+    if (!hashSourceFile(sourcePath, header.sourceHash, header.sourceSize))
+    {
+        LOG_WARN("Scene cache not written: failed to read source '{}'", sourcePath);
+        return false;
+    }
+
+    std::vector<DependencyRecord> dependencies(scene.sourceFiles.size());
+    for (size_t i = 0; i < scene.sourceFiles.size(); i++)
+    {
+        if (!hashSourceFile(scene.sourceFiles[i], dependencies[i].hash, dependencies[i].size))
+        {
+            LOG_WARN("Scene cache not written: failed to read dependency '{}'", scene.sourceFiles[i]);
+            return false;
+        }
+    }
+
+    if (scene.camera)
+    {
+        const CameraData& cameraData = scene.camera->getCameraData();
+        header.hasCamera = 1;
+        header.cameraWidth = cameraData.frameWidth;
+        header.cameraHeight = cameraData.frameHeight;
+        header.cameraFovY = cameraData.fovY;
+        std::memcpy(header.cameraPosition, &cameraData.posW, sizeof(header.cameraPosition));
+        std::memcpy(header.cameraTarget, &cameraData.target, sizeof(header.cameraTarget));
+    }
+
+    const std::string cachePath = getCachePath(sourcePath, scene.getTextureManager()->isCompressionEnabled());
+    const std::string tempPath = cachePath + ".tmp";
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+
+    CacheWriter writer(tempPath);
+    if (!writer.isValid())
+    {
+        LOG_WARN("Scene cache not written: cannot open '{}'", tempPath);
+        return false;
+    }
+
+    writer.write(&header, sizeof(header));
+    header.vertices = writer.writeSection(scene.vertices);
+    header.indices = writer.writeSection(scene.indices);
+    header.meshes = writer.writeSection(scene.meshes);
+    header.instances = writer.writeSection(scene.instances);
+    header.materials = writer.writeSection(scene.materials);
+
+    std::vector<TextureRecord> records(payloads.size());
+    std::string names;
+    for (size_t i = 0; i < payloads.size(); i++)
+    {
+        const TexturePayload& payload = payloads[i];
+        writer.align();
+        TextureRecord& record = records[i];
+        record.width = payload.width;
+        record.height = payload.height;
+        record.format = static_cast<uint32_t>(payload.format);
+        record.mipLevels = payload.mipLevels;
+        record.nameLength = static_cast<uint32_t>(payload.name.size());
+        record.nameOffset = names.size();
+        record.dataOffset = writer.cursor();
+        record.dataSize = payload.data.size();
+        names += payload.name;
+        writer.write(payload.data.data(), payload.data.size());
+    }
+
+    header.textures = writer.writeSection(records);
+    for (size_t i = 0; i < dependencies.size(); i++)
+    {
+        dependencies[i].pathLength = static_cast<uint32_t>(scene.sourceFiles[i].size());
+        dependencies[i].pathOffset = names.size();
+        names += scene.sourceFiles[i];
+    }
+    header.dependencies = writer.writeSection(dependencies);
+    header.names = writer.writeSection(std::vector<char>(names.begin(), names.end()));
+    uint64_t totalBytes = writer.cursor();
+    writer.rewriteHeader(header);
+    if (!writer.finish())
+    {
+        LOG_WARN("Scene cache not written: failed writing '{}'", tempPath);
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    // Publish atomically so an interrupted write never leaves a half-written cache behind.
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        LOG_WARN("Scene cache not written: failed to move '{}' into place: {}", tempPath, ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    LOG_INFO("Wrote scene cache '{}' ({:.1f} MB)", cachePath, totalBytes / (1024.0 * 1024.0));
+    return true;
+}
+} // namespace SceneCache
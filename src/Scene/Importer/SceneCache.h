@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Scene/Scene.h"
+#include "Core/Pointer.h"
+#include "Core/Device.h"
+
+/*
+    Binary scene cache. Stores the final Scene arrays and the processed texture payloads
+    next to a header keyed by the source file's content hash and kImporterVersion, so a
+    warm load is one file mapping plus bulk copies instead of a full USD/Assimp import.
+    The size and content hash of every file in Scene::sourceFiles is stored as well; editing
+    or replacing any of them makes the cache stale.
+*/
+namespace SceneCache
+{
+// Bump whenever importer output changes (geometry layout, material extraction, texture
+// processing) so caches written by older builds are rejected and rebuilt.
+inline constexpr uint32_t kImporterVersion = 7;
+
+// Cache file location for a source scene: <PROJECT_CACHE_DIR>/scenes/<stem>-<path hash>[-bc].scache
+std::string getCachePath(const std::string& sourcePath, bool compressedTextures = false);
+
+/*
+    Load a scene from its cache file
+    \param sourcePath Path of the original scene file; its contents must match the cached hash
+    \param pDevice The graphics device handle
+    \param compressedTextures Load the cache written by an import with block-compressed textures
+    \return The restored scene, or nullptr if the cache is missing, stale or corrupt
+*/
+ref<Scene> load(const std::string& sourcePath, ref<Device> pDevice, bool compressedTextures = false);
+
+/*
+    Write a freshly imported scene to the cache
+    \param sourcePath Path of the original scene file
+    \param scene Scene whose texture manager recorded payloads for every texture
+    \return True if the cache file was written
+*/
+bool save(const std::string& sourcePath, const Scene& scene);
+} // namespace SceneCache
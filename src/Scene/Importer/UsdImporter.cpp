@@ -8,13 +8,19 @@
 #include <usdShade.hh>
 #include <value-pprint.hh>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <filesystem>
 #include <optional>
 #include <map>
 
 #include "UsdImporter.h"
+#include "Utils/Hash.h"
 #include "Utils/Logger.h"
+#include "Utils/ThreadPool.h"
 
 #include <DirectXTex.h>
 
@@ -112,6 +118,87 @@ bool ddsTextureLoader(
     return true;
 }
 
+// Exact (bitwise) vertex identity used to weld face-varying vertices into a shared pool.
+struct VertexBitsHash
+{
+    size_t operator()(const Vertex& v) const { return static_cast<size_t>(Hash::hash64(&v, sizeof(Vertex))); }
+};
+
+struct VertexBitsEqual
+{
+    bool operator()(const Vertex& a, const Vertex& b) const { return std::memcmp(&a, &b, sizeof(Vertex)) == 0; }
+};
+
+// UVs from the first recognised primvar, flattened so indexed primvars expand to one entry per face-vertex.
+std::vector<tinyusdz::value::texcoord2f> getMeshUVs(const tinyusdz::GeomMesh* geomMesh)
+{
+    std::vector<tinyusdz::value::texcoord2f> uvCoords;
+    for (const auto& uvName : {"st", "uv", "st0", "uv0"})
+    {
+        if (geomMesh->has_primvar(uvName))
+        {
+            tinyusdz::GeomPrimvar uvPrimvar;
+            std::string uvErr;
+            if (geomMesh->get_primvar(uvName, &uvPrimvar, &uvErr) && uvPrimvar.flatten_with_indices(&uvCoords, &uvErr))
+                break;
+        }
+    }
+    return uvCoords;
+}
+
+template<typename T>
+uint64_t hashArray(uint64_t seed, const std::vector<T>& values)
+{
+    return Hash::combine(seed, Hash::hash64(values.data(), values.size() * sizeof(T)));
+}
+
+// Content key for mesh-local geometry; identical prototypes placed by different Xforms collide on purpose.
+uint64_t hashMeshSource(const tinyusdz::GeomMesh* geomMesh, const std::vector<int32_t>* subsetFaces)
+{
+    uint64_t key = hashArray(0, geomMesh->get_points());
+    key = hashArray(key, geomMesh->get_faceVertexIndices());
+    key = hashArray(key, geomMesh->get_faceVertexCounts());
+    key = hashArray(key, geomMesh->get_normals());
+    key = hashArray(key, getMeshUVs(geomMesh));
+    if (subsetFaces)
+        key = hashArray(key, *subsetFaces);
+    return key;
+}
+
+template<typename T>
+bool arraysEqual(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+// Exact comparison behind a hashMeshSource match, so a 64-bit collision never instances the wrong geometry
+bool isSameMeshSource(
+    const tinyusdz::GeomMesh* a,
+    const std::vector<int32_t>* aSubsetFaces,
+    const tinyusdz::GeomMesh* b,
+    const std::vector<int32_t>* bSubsetFaces
+)
+{
+    if ((aSubsetFaces != nullptr) != (bSubsetFaces != nullptr) || (aSubsetFaces && !arraysEqual(*aSubsetFaces, *bSubsetFaces)))
+        return false;
+    if (a == b)
+        return true;
+    return arraysEqual(a->get_points(), b->get_points()) && arraysEqual(a->get_faceVertexIndices(), b->get_faceVertexIndices()) &&
+           arraysEqual(a->get_faceVertexCounts(), b->get_faceVertexCounts()) && arraysEqual(a->get_normals(), b->get_normals()) &&
+           arraysEqual(getMeshUVs(a), getMeshUVs(b));
+}
+
+// USD matrices act on row vectors (p' = p * M) while glm acts on column vectors,
+// so the element order of M already matches glm's column-major storage.
+glm::mat4 toGlmMatrix(const tinyusdz::value::matrix4d& m)
+{
+    glm::mat4 result;
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            result[i][j] = static_cast<float>(m.m[i][j]);
+    return result;
+}
+
 size_t uvChannelIndex(tinyusdz::tydra::UVTexture::Channel ch)
 {
     using Ch = tinyusdz::tydra::UVTexture::Channel;
@@ -136,9 +223,13 @@ using PrimvarReader_float2Map = std::map<std::string, std::pair<const tinyusdz::
 
 ref<Scene> UsdImporter::loadScene(const std::string& fileName)
 {
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
     std::string warn;
     std::string err;
 
+    auto stageStart = Clock::now();
     bool ret = tinyusdz::LoadUSDFromFile(fileName, &mStage, &warn, &err);
     if (warn.size())
         LOG_WARN("USD Importer warning: {}", warn);
@@ -148,9 +239,10 @@ ref<Scene> UsdImporter::loadScene(const std::string& fileName)
         return nullptr;
     }
     LOG_DEBUG("Successfully loaded USD file: {}", fileName);
+    const double parseMs = elapsedMs(stageStart);
 
-    ref<Scene> scene = make_ref<Scene>(mpDevice);
-    scene->name = fileName;
+    stageStart = Clock::now();
+    ref<Scene> scene = createScene(fileName);
 
     tinyusdz::tydra::XformNode rootXformNode;
     double t = tinyusdz::value::TimeCode::Default();
@@ -172,11 +264,10 @@ ref<Scene> UsdImporter::loadScene(const std::string& fileName)
     LOG_INFO("USD base directory for asset search: '{}'", usdBaseDir);
     LOG_INFO("USD file path: '{}'", fileName);
 
-    // Set search paths for texture loading
+    // Texture assets are decoded after conversion on the thread pool (loadRequestedTextures); tydra
+    // would decode them one by one inside ConvertToRenderScene.
     env.set_search_paths({usdBaseDir});
-    env.scene_config.load_texture_assets = true;
-    env.material_config.linearize_color_space = true;
-    env.material_config.texture_image_loader_function = ddsTextureLoader;
+    env.scene_config.load_texture_assets = false;
 
     if (!converter.ConvertToRenderScene(env, &mRenderScene))
     {
@@ -201,7 +292,7 @@ ref<Scene> UsdImporter::loadScene(const std::string& fileName)
 
     for (const auto& renderMaterial : mRenderScene.materials)
     {
-        Material material = extractMaterial(renderMaterial, scene);
+        Material material = extractMaterial(renderMaterial);
         scene->materials.push_back(material);
         uint32_t materialIndex = static_cast<uint32_t>(scene->materials.size() - 1);
         mMaterialPathToIndex[renderMaterial.abs_path] = materialIndex;
@@ -209,12 +300,37 @@ ref<Scene> UsdImporter::loadScene(const std::string& fileName)
 
     for (const auto& child : rootXformNode.children)
         traverseXformNode(child, scene);
+    const double convertMs = elapsedMs(stageStart);
+
+    stageStart = Clock::now();
+    const size_t imageCount = loadRequestedTextures(scene, usdBaseDir);
+    const double decodeMs = elapsedMs(stageStart);
+
+    // Waits for the mip/compression workers still running and submits the last upload batch
+    stageStart = Clock::now();
+    scene->getTextureManager()->flush();
+    const double uploadMs = elapsedMs(stageStart);
+
+    LOG_INFO(
+        "USD import timings: parse {:.1f} ms, convert {:.1f} ms, decode {:.1f} ms ({} images, {} textures, {} threads), upload {:.1f} ms",
+        parseMs,
+        convertMs,
+        decodeMs,
+        imageCount,
+        mTextureRequests.size(),
+        ThreadPool::get().getThreadCount() + 1,
+        uploadMs
+    );
 
     LOG_INFO(
-        "Scene conversion completed. Found {} vertices, {} indices, {} meshes, {} materials",
+        "Scene conversion completed. Found {} vertices (welded from {} face-vertices), {} indices, {} meshes, {} instances ({} reuse a "
+        "prototype), {} materials",
         scene->vertices.size(),
+        mFaceVertexCount,
         scene->indices.size(),
         scene->meshes.size(),
+        scene->instances.size(),
+        mPrototypeReuseCount,
         scene->materials.size()
     );
     return scene;
@@ -227,13 +343,12 @@ void UsdImporter::traverseXformNode(const tinyusdz::tydra::XformNode& node, ref<
         const tinyusdz::value::matrix4d& worldMatrix = node.get_world_matrix();
         if (const tinyusdz::GeomMesh* geomMesh = node.prim->as<tinyusdz::GeomMesh>())
         {
+            glm::mat4 localToWorld = toGlmMatrix(worldMatrix);
             auto subsets = tinyusdz::tydra::GetGeomSubsets(mStage, node.absolute_path, tinyusdz::value::token("materialBind"));
 
             if (subsets.empty())
             {
-                uint32_t indexOffset = static_cast<uint32_t>(scene->indices.size());
-                extractMeshGeometry(geomMesh, worldMatrix, scene);
-                uint32_t indexCount = static_cast<uint32_t>(scene->indices.size()) - indexOffset;
+                uint32_t meshID = getOrExtractMesh(geomMesh, scene);
 
                 tinyusdz::Path matPath;
                 const tinyusdz::Material* material{nullptr};
@@ -246,7 +361,7 @@ void UsdImporter::traverseXformNode(const tinyusdz::tydra::XformNode& node, ref<
                 auto matIt = mMaterialPathToIndex.find(tinyusdz::to_string(matPath));
                 if (matIt != mMaterialPathToIndex.end())
                     materialIndex = matIt->second;
-                scene->addMeshInstance(indexOffset, indexCount, materialIndex);
+                scene->addInstance(meshID, materialIndex, localToWorld);
             }
             else
             {
@@ -258,11 +373,7 @@ void UsdImporter::traverseXformNode(const tinyusdz::tydra::XformNode& node, ref<
                     if (rawFaces.empty())
                         continue;
 
-                    std::unordered_set<int32_t> faceSet(rawFaces.begin(), rawFaces.end());
-
-                    uint32_t indexOffset = static_cast<uint32_t>(scene->indices.size());
-                    extractMeshGeometry(geomMesh, worldMatrix, scene, &faceSet);
-                    uint32_t indexCount = static_cast<uint32_t>(scene->indices.size()) - indexOffset;
+                    uint32_t meshID = getOrExtractMesh(geomMesh, scene, &rawFaces);
 
                     std::string subsetPathStr = tinyusdz::to_string(node.absolute_path) + "/" + subset->name;
                     tinyusdz::Path subsetPath(subsetPathStr, "");
@@ -277,7 +388,7 @@ void UsdImporter::traverseXformNode(const tinyusdz::tydra::XformNode& node, ref<
                         materialIndex = matIt->second;
                     else
                         LOG_WARN("No material found for subset {}", subsetPathStr);
-                    scene->addMeshInstance(indexOffset, indexCount, materialIndex);
+                    scene->addInstance(meshID, materialIndex, localToWorld);
                 }
             }
         }
@@ -314,12 +425,35 @@ void UsdImporter::extractCamera(const tinyusdz::GeomCamera* geomCamera, const ti
     );
 }
 
-void UsdImporter::extractMeshGeometry(
-    const tinyusdz::GeomMesh* geomMesh,
-    const tinyusdz::value::matrix4d& worldMatrix,
-    ref<Scene> scene,
-    const std::unordered_set<int32_t>* faceFilter
-)
+uint32_t UsdImporter::getOrExtractMesh(const tinyusdz::GeomMesh* geomMesh, ref<Scene> scene, const std::vector<int32_t>* subsetFaces)
+{
+    // The hash only groups candidates; reuse needs an exact match
+    std::vector<PrototypeMesh>& candidates = mPrototypeMeshes[hashMeshSource(geomMesh, subsetFaces)];
+    for (const PrototypeMesh& prototype : candidates)
+    {
+        if (isSameMeshSource(geomMesh, subsetFaces, prototype.geomMesh, prototype.hasSubset ? &prototype.subsetFaces : nullptr))
+        {
+            mPrototypeReuseCount++;
+            return prototype.meshID;
+        }
+    }
+    if (!candidates.empty())
+        LOG_DEBUG("Mesh source hash collision; extracting a separate prototype");
+
+    std::unordered_set<int32_t> faceSet;
+    if (subsetFaces)
+        faceSet.insert(subsetFaces->begin(), subsetFaces->end());
+
+    uint32_t indexOffset = static_cast<uint32_t>(scene->indices.size());
+    extractMeshGeometry(geomMesh, scene, subsetFaces ? &faceSet : nullptr);
+    uint32_t indexCount = static_cast<uint32_t>(scene->indices.size()) - indexOffset;
+
+    uint32_t meshID = scene->addMesh(indexOffset, indexCount);
+    candidates.push_back({geomMesh, subsetFaces ? *subsetFaces : std::vector<int32_t>(), subsetFaces != nullptr, meshID});
+    return meshID;
+}
+
+void UsdImporter::extractMeshGeometry(const tinyusdz::GeomMesh* geomMesh, ref<Scene> scene, const std::unordered_set<int32_t>* faceFilter)
 {
     auto points = geomMesh->get_points();
     auto faceVertexIndices = geomMesh->get_faceVertexIndices();
@@ -330,28 +464,16 @@ void UsdImporter::extractMeshGeometry(
     // Determine normal interpolation by comparing count: faceVarying == one per face-vertex
     bool normalsFaceVarying = hasNormals && (normals.size() == faceVertexIndices.size());
 
-    // Get UV coordinates from primvars.
-    // Use flatten_with_indices so indexed primvars are expanded to one entry per face-vertex.
-    std::vector<tinyusdz::value::texcoord2f> uvCoords;
-    for (const auto& uvName : {"st", "uv", "st0", "uv0"})
-    {
-        if (geomMesh->has_primvar(uvName))
-        {
-            tinyusdz::GeomPrimvar uvPrimvar;
-            std::string uvErr;
-            if (geomMesh->get_primvar(uvName, &uvPrimvar, &uvErr) && uvPrimvar.flatten_with_indices(&uvCoords, &uvErr))
-                break;
-        }
-    }
+    std::vector<tinyusdz::value::texcoord2f> uvCoords = getMeshUVs(geomMesh);
     // After flatten_with_indices: face-varying → size == faceVertexIndices.size(), vertex → size == points.size()
     bool uvFaceVarying = uvCoords.size() == faceVertexIndices.size();
 
+    // Vertices stay in mesh-local space; the instance transform is applied by the TLAS and shaders.
     // faceVertexIdx = faceOffset + localIdx (for FaceVarying data like UVs/normals)
-    tinyusdz::value::matrix4d normalMatrix = hasNormals ? tinyusdz::inverse(tinyusdz::transpose(worldMatrix)) : tinyusdz::value::matrix4d{};
     auto createVertex = [&](int32_t pointIdx, int32_t faceVertexIdx) -> Vertex
     {
         Vertex v;
-        auto pos = tinyusdz::transform(worldMatrix, points[pointIdx]);
+        const auto& pos = points[pointIdx];
         v.position[0] = pos[0];
         v.position[1] = pos[1];
         v.position[2] = pos[2];
@@ -371,8 +493,7 @@ void UsdImporter::extractMeshGeometry(
         int32_t normalIdx = normalsFaceVarying ? faceVertexIdx : pointIdx;
         if (hasNormals && normalIdx < static_cast<int32_t>(normals.size()))
         {
-            auto n = tinyusdz::transform_dir(normalMatrix, normals[normalIdx]);
-            n = tinyusdz::vnormalize(n); // re-normalize after transform
+            auto n = tinyusdz::vnormalize(normals[normalIdx]);
             v.normal[0] = n[0];
             v.normal[1] = n[1];
             v.normal[2] = n[2];
@@ -387,15 +508,23 @@ void UsdImporter::extractMeshGeometry(
         return v;
     };
 
+    // Face-vertices with bit-identical attributes share one entry in this mesh's vertex pool.
+    std::unordered_map<Vertex, uint32_t, VertexBitsHash, VertexBitsEqual> weldedVertices;
+    weldedVertices.reserve(points.size());
+
     size_t faceOffset = 0;
     auto addVertex = [&](int32_t localIdx) -> uint32_t
     {
         int32_t pointIdx = faceVertexIndices[faceOffset + localIdx];
         int32_t faceVertexIdx = static_cast<int32_t>(faceOffset + localIdx);
-        scene->vertices.push_back(createVertex(pointIdx, faceVertexIdx));
-        uint32_t idx = static_cast<uint32_t>(scene->vertices.size()) - 1;
-        scene->indices.push_back(idx);
-        return idx;
+        Vertex vertex = createVertex(pointIdx, faceVertexIdx);
+        mFaceVertexCount++;
+
+        auto [it, inserted] = weldedVertices.try_emplace(vertex, static_cast<uint32_t>(scene->vertices.size()));
+        if (inserted)
+            scene->vertices.push_back(vertex);
+        scene->indices.push_back(it->second);
+        return it->second;
     };
 
     int32_t faceIdx = 0;
@@ -438,7 +567,7 @@ static UVTransform extractUVTransform(const tinyusdz::tydra::UVTexture& uvTex)
     return t;
 }
 
-Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usdMaterial, ref<Scene> scene)
+Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usdMaterial)
 {
     Material material;
     const auto& surfaceShader = usdMaterial.surfaceShader;
@@ -452,7 +581,7 @@ Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usd
     else
     {
         int32_t texId = surfaceShader.diffuseColor.texture_id;
-        material.baseColorTextureId = loadTextureFromRenderScene(texId, scene);
+        material.baseColorTextureId = requestTexture(texId, TextureUsage::Color);
         material.baseColorUV = extractUVTransform(mRenderScene.textures[texId]);
     }
 
@@ -462,7 +591,7 @@ Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usd
     else
     {
         int32_t texId = surfaceShader.metallic.texture_id;
-        material.metallicTextureId = loadTextureFromRenderScene(texId, scene);
+        material.metallicTextureId = requestTexture(texId, TextureUsage::Data);
         material.metallicUV = extractUVTransform(mRenderScene.textures[texId]);
     }
 
@@ -472,7 +601,7 @@ Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usd
     else
     {
         int32_t texId = surfaceShader.roughness.texture_id;
-        material.roughnessTextureId = loadTextureFromRenderScene(texId, scene);
+        material.roughnessTextureId = requestTexture(texId, TextureUsage::Data);
         material.roughnessUV = extractUVTransform(mRenderScene.textures[texId]);
     }
 
@@ -485,7 +614,7 @@ Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usd
     else
     {
         int32_t texId = surfaceShader.emissiveColor.texture_id;
-        material.emissiveTextureId = loadTextureFromRenderScene(texId, scene);
+        material.emissiveTextureId = requestTexture(texId, TextureUsage::Color);
         material.emissiveUV = extractUVTransform(mRenderScene.textures[texId]);
         material.emissiveFactor = glm::vec3(1000.f);
     }
@@ -494,7 +623,7 @@ Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usd
     if (surfaceShader.normal.is_texture())
     {
         int32_t texId = surfaceShader.normal.texture_id;
-        material.normalTextureId = loadTextureFromRenderScene(texId, scene);
+        material.normalTextureId = requestTexture(texId, TextureUsage::Normal);
         material.normalUV = extractUVTransform(mRenderScene.textures[texId]);
     }
 
@@ -509,47 +638,9 @@ Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usd
         // For textured opacity, invert each texel (1 - opacity) at load time so the
         // shader can sample transmission directly without runtime inversion.
         int32_t texId = surfaceShader.opacity.texture_id;
-        const auto& uvTexture = mRenderScene.textures[texId];
-        const auto& texImage = mRenderScene.images[uvTexture.texture_image_id];
-        const auto& buffer = mRenderScene.buffers[texImage.buffer_id];
-
-        std::string cacheKey = texImage.asset_identifier + "_transmission";
-        auto cacheIt = mTransmissionTextureCache.find(cacheKey);
-        if (cacheIt != mTransmissionTextureCache.end())
-        {
-            material.transmissionTextureId = cacheIt->second;
-            material.transmissionUV = extractUVTransform(uvTexture);
-            material.transmissionFactor = 1.0f;
-        }
-        else if (!buffer.data.empty())
-        {
-            size_t nCh = static_cast<size_t>(texImage.channels);
-            size_t pixelCount = static_cast<size_t>(texImage.width) * texImage.height;
-            size_t expectedUint8Size = pixelCount * nCh * sizeof(uint8_t);
-            size_t expectedFloat32Size = pixelCount * nCh * sizeof(float);
-
-            size_t srcCh = uvChannelIndex(uvTexture.connectedOutputChannel);
-
-            std::vector<float> transmissionData(pixelCount);
-
-            if (buffer.data.size() == expectedFloat32Size)
-            {
-                const float* floatData = reinterpret_cast<const float*>(buffer.data.data());
-                for (size_t i = 0; i < pixelCount; ++i)
-                    transmissionData[i] = 1.0f - floatData[i * nCh + srcCh];
-            }
-            else if (buffer.data.size() == expectedUint8Size)
-            {
-                for (size_t i = 0; i < pixelCount; ++i)
-                    transmissionData[i] = 1.0f - buffer.data[i * nCh + srcCh] / 255.0f;
-            }
-
-            uint32_t engineTexId = scene->loadTexture(transmissionData.data(), texImage.width, texImage.height, 1, cacheKey);
-            mTransmissionTextureCache[cacheKey] = engineTexId;
-            material.transmissionTextureId = engineTexId;
-            material.transmissionUV = extractUVTransform(uvTexture);
-            material.transmissionFactor = 1.0f;
-        }
+        material.transmissionTextureId = requestTexture(texId, TextureUsage::Data, true);
+        material.transmissionUV = extractUVTransform(mRenderScene.textures[texId]);
+        material.transmissionFactor = 1.0f;
     }
 
     // IOR
@@ -558,83 +649,358 @@ Material UsdImporter::extractMaterial(const tinyusdz::tydra::RenderMaterial& usd
     return material;
 }
 
-uint32_t UsdImporter::loadTextureFromRenderScene(int32_t textureId, ref<Scene> scene)
+uint32_t UsdImporter::requestTexture(int32_t textureId, TextureUsage usage, bool invert)
 {
-    const auto& uvTexture = mRenderScene.textures[textureId];
-    int channelKey = static_cast<int>(uvTexture.connectedOutputChannel);
-    auto cacheKey = std::make_pair(textureId, channelKey);
-
-    auto it = mUsdTextureIdChannelToEngineId.find(cacheKey);
-    if (it != mUsdTextureIdChannelToEngineId.end())
+    int channelKey = static_cast<int>(mRenderScene.textures[textureId].connectedOutputChannel);
+    auto key = std::make_tuple(textureId, channelKey, usage, invert);
+    auto it = mTextureRequestIds.find(key);
+    if (it != mTextureRequestIds.end())
         return it->second;
 
-    const auto& texImage = mRenderScene.images[uvTexture.texture_image_id];
-    const auto& buffer = mRenderScene.buffers[texImage.buffer_id];
+    uint32_t requestId = static_cast<uint32_t>(mTextureRequests.size());
+    mTextureRequests.push_back({textureId, usage, invert});
+    mTextureRequestIds.emplace(key, requestId);
+    return requestId;
+}
+
+size_t UsdImporter::loadRequestedTextures(ref<Scene> scene, const std::string& baseDir)
+{
+    using Ch = tinyusdz::tydra::UVTexture::Channel;
 
-    if (buffer.data.empty())
+    // Only images some request refers to are decoded
+    std::vector<int32_t> imageIds;
+    std::vector<int32_t> imageSlots(mRenderScene.images.size(), -1);
+    for (const TextureRequest& request : mTextureRequests)
     {
-        LOG_ERROR("Texture buffer is empty for '{}'. Asset may not have been loaded.", texImage.asset_identifier);
-        return kInvalidTextureId;
+        int32_t imageId = static_cast<int32_t>(mRenderScene.textures[request.textureId].texture_image_id);
+        if (imageId >= 0 && imageId < static_cast<int32_t>(imageSlots.size()) && imageSlots[imageId] < 0)
+        {
+            imageSlots[imageId] = static_cast<int32_t>(imageIds.size());
+            imageIds.push_back(imageId);
+        }
     }
 
-    size_t pixelCount = static_cast<size_t>(texImage.width) * texImage.height * texImage.channels;
-    size_t expectedFloat32Size = pixelCount * sizeof(float);
-    size_t expectedUint8Size = pixelCount * sizeof(uint8_t);
-
-    const float* floatData = nullptr;
-    std::vector<float> convertedData;
+    tinyusdz::AssetResolutionResolver resolver;
+    resolver.set_search_paths({baseDir});
 
-    if (buffer.data.size() == expectedFloat32Size)
-        floatData = reinterpret_cast<const float*>(buffer.data.data());
-    else if (buffer.data.size() == expectedUint8Size)
+    // The scene cache is only valid while these files are unchanged
+    for (int32_t imageId : imageIds)
     {
-        convertedData.resize(pixelCount);
-        for (size_t i = 0; i < pixelCount; ++i)
-            convertedData[i] = buffer.data[i] / 255.0f;
-        floatData = convertedData.data();
+        std::string resolvedPath = resolver.resolve(mRenderScene.images[imageId].asset_identifier);
+        if (!resolvedPath.empty())
+            scene->sourceFiles.push_back(std::filesystem::absolute(resolvedPath).lexically_normal().string());
     }
-    else
+
+    // Decode (DDS included) and linearize sRGB 8-bit images, the conversion tydra did with linearize_color_space
+    std::vector<DecodedImage> images(imageIds.size());
+    ThreadPool::get().parallelFor(
+        imageIds.size(),
+        1,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const tinyusdz::tydra::TextureImage& texImage = mRenderScene.images[imageIds[i]];
+                const std::string& assetPath = texImage.asset_identifier;
+                tinyusdz::tydra::TextureImage decodedInfo;
+                std::vector<uint8_t> data;
+                std::string warn, err;
+                tinyusdz::value::AssetPath asset(assetPath);
+                if (!ddsTextureLoader(asset, tinyusdz::AssetInfo(), resolver, &decodedInfo, &data, nullptr, &warn, &err))
+                {
+                    LOG_ERROR("Failed to decode texture '{}': {}", assetPath, err);
+                    continue;
+                }
+
+                DecodedImage& image = images[i];
+                image.width = static_cast<uint32_t>(decodedInfo.width);
+                image.height = static_cast<uint32_t>(decodedInfo.height);
+                image.channels = static_cast<uint32_t>(decodedInfo.channels);
+                const size_t valueCount = static_cast<size_t>(image.width) * image.height * image.channels;
+
+                using Component = tinyusdz::tydra::ComponentType;
+                const Component component = decodedInfo.assetTexelComponentType;
+                if (component == Component::UInt8 && data.size() >= valueCount)
+                {
+                    if (texImage.usdColorSpace != tinyusdz::tydra::ColorSpace::sRGB)
+                    {
+                        data.resize(valueCount);
+                        image.bytes = std::move(data);
+                        continue;
+                    }
+                    // Alpha stays linear
+                    image.floats.resize(valueCount);
+                    for (size_t v = 0; v < valueCount; ++v)
+                    {
+                        float c = data[v] / 255.0f;
+                        if (image.channels == 4 && v % 4 == 3)
+                            image.floats[v] = c;
+                        else
+                            image.floats[v] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                    }
+                }
+                else if (component == Component::UInt16 && data.size() >= valueCount * sizeof(uint16_t))
+                {
+                    const uint16_t* values = reinterpret_cast<const uint16_t*>(data.data());
+                    image.floats.resize(valueCount);
+                    for (size_t v = 0; v < valueCount; ++v)
+                        image.floats[v] = values[v] / 65535.0f;
+                }
+                else if (component == Component::Float && data.size() >= valueCount * sizeof(float))
+                {
+                    image.floats.resize(valueCount);
+                    std::memcpy(image.floats.data(), data.data(), valueCount * sizeof(float));
+                }
+                else
+                {
+                    LOG_ERROR(
+                        "Unsupported texel layout in '{}' ({}x{}x{}, {} bytes)", assetPath, image.width, image.height, image.channels, data.size()
+                    );
+                    image = DecodedImage();
+                }
+            }
+        }
+    );
+
+    // Channel extraction and opacity inversion per request; the result is a loadTexture-ready image
+    std::vector<DecodedImage> converted(mTextureRequests.size());
+    ThreadPool::get().parallelFor(
+        mTextureRequests.size(),
+        1,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t r = begin; r < end; ++r)
+            {
+                const TextureRequest& request = mTextureRequests[r];
+                const auto& uvTexture = mRenderScene.textures[request.textureId];
+                const int32_t imageId = static_cast<int32_t>(uvTexture.texture_image_id);
+                if (imageId < 0 || imageId >= static_cast<int32_t>(imageSlots.size()) || imageSlots[imageId] < 0)
+                    continue;
+                const DecodedImage& image = images[imageSlots[imageId]];
+                if (image.channels == 0)
+                    continue;
+
+                const bool isSingleChannel =
+                    (uvTexture.connectedOutputChannel == Ch::R || uvTexture.connectedOutputChannel == Ch::G ||
+                     uvTexture.connectedOutputChannel == Ch::B || uvTexture.connectedOutputChannel == Ch::A);
+                const size_t srcCh = std::min<size_t>(uvChannelIndex(uvTexture.connectedOutputChannel), image.channels - 1);
+                const size_t nCh = image.channels;
+                const size_t numPixels = static_cast<size_t>(image.width) * image.height;
+                const bool isUint8 = !image.bytes.empty();
+
+                DecodedImage& result = converted[r];
+                result.width = image.width;
+                result.height = image.height;
+                if (request.invert)
+                {
+                    // Transmission = 1 - opacity, sampled through .r
+                    result.channels = 1;
+                    if (isUint8)
+                    {
+                        result.bytes.resize(numPixels);
+                        for (size_t i = 0; i < numPixels; ++i)
+                            result.bytes[i] = 255 - image.bytes[i * nCh + srcCh];
+                    }
+                    else
+                    {
+                        result.floats.resize(numPixels);
+                        for (size_t i = 0; i < numPixels; ++i)
+                            result.floats[i] = 1.0f - image.floats[i * nCh + srcCh];
+                    }
+                }
+                else if (isSingleChannel && nCh > 1)
+                {
+                    // For scalar parameters (metallic, roughness, etc.) that reference a single channel
+                    // of a multi-channel texture (e.g., ORM packing), extract that channel into a
+                    // 1-channel texture so the shader can always sample .r correctly.
+                    const float scale = uvTexture.scale[srcCh];
+                    const float bias = uvTexture.bias[srcCh];
+                    result.channels = 1;
+                    if (isUint8 && scale == 1.0f && bias == 0.0f)
+                    {
+                        result.bytes.resize(numPixels);
+                        for (size_t i = 0; i < numPixels; ++i)
+                            result.bytes[i] = image.bytes[i * nCh + srcCh];
+                    }
+                    else
+                    {
+                        result.floats.resize(numPixels);
+                        for (size_t i = 0; i < numPixels; ++i)
+                        {
+                            float value = isUint8 ? image.bytes[i * nCh + srcCh] / 255.0f : image.floats[i * nCh + srcCh];
+                            result.floats[i] = value * scale + bias;
+                        }
+                    }
+                }
+                else
+                {
+                    // 8-bit data is passed through as-is so it stays 8-bit on the GPU
+                    result.channels = image.channels;
+                    result.bytes = image.bytes;
+                    result.floats = image.floats;
+                }
+            }
+        }
+    );
+    images.clear();
+
+    // Pack the single-channel scalar textures of each material (metallic, roughness, transmission) of equal size into
+    // one two-channel texture; the material then selects its channel. Two channels cost the same bytes as two separate
+    // textures and compress to BC5, which keeps each channel at BC4 precision. A third channel would pad to RGBA and
+    // compress to BC1, whose shared 5:6:5 endpoints lose far more precision than separate BC4 textures.
+    const uint32_t requestCount = static_cast<uint32_t>(mTextureRequests.size());
+    constexpr size_t maxPackedChannels = 2;
+    auto isScalar = [&](uint32_t r)
     {
-        LOG_ERROR(
-            "Unexpected texture buffer size {} for '{}' ({}x{}x{}) — expected {} (float32) or {} (uint8)",
-            buffer.data.size(),
-            texImage.asset_identifier,
-            texImage.width,
-            texImage.height,
-            texImage.channels,
-            expectedFloat32Size,
-            expectedUint8Size
-        );
-        return kInvalidTextureId;
-    }
+        return r < requestCount && mTextureRequests[r].usage == TextureUsage::Data && converted[r].channels == 1;
+    };
+    auto isPackable = [&](uint32_t a, uint32_t b)
+    {
+        return converted[a].width == converted[b].width && converted[a].height == converted[b].height &&
+               converted[a].bytes.empty() == converted[b].bytes.empty();
+    };
 
-    using Ch = tinyusdz::tydra::UVTexture::Channel;
-    bool isSingleChannel =
-        (uvTexture.connectedOutputChannel == Ch::R || uvTexture.connectedOutputChannel == Ch::G || uvTexture.connectedOutputChannel == Ch::B ||
-         uvTexture.connectedOutputChannel == Ch::A);
+    // Packed textures get IDs after the requests: requestCount + pack index
+    std::map<std::vector<uint32_t>, uint32_t> packIds;
+    std::vector<std::vector<uint32_t>> packs;
+    for (Material& material : scene->materials)
+    {
+        std::pair<uint32_t*, MaterialScalarSlot> slots[] = {
+            {&material.metallicTextureId, MaterialScalarSlot::Metallic},
+            {&material.roughnessTextureId, MaterialScalarSlot::Roughness},
+            {&material.transmissionTextureId, MaterialScalarSlot::Transmission},
+        };
+        std::vector<uint32_t> members;
+        for (const auto& slot : slots)
+        {
+            const uint32_t r = *slot.first;
+            if (isScalar(r) && (members.empty() || isPackable(members[0], r)) && members.size() < maxPackedChannels &&
+                std::find(members.begin(), members.end(), r) == members.end())
+                members.push_back(r);
+        }
+        if (members.size() < 2)
+            continue;
 
-    uint32_t engineTextureId;
+        auto [it, inserted] = packIds.emplace(members, requestCount + static_cast<uint32_t>(packs.size()));
+        if (inserted)
+            packs.push_back(members);
+        for (const auto& slot : slots)
+        {
+            auto member = std::find(members.begin(), members.end(), *slot.first);
+            if (*slot.first == kInvalidTextureId || member == members.end())
+                continue;
+            *slot.first = it->second;
+            material.setScalarChannel(slot.second, static_cast<uint>(member - members.begin()));
+        }
+    }
 
-    // For scalar parameters (metallic, roughness, etc.) that reference a single channel
-    // of a multi-channel texture (e.g., ORM packing), extract that channel into a
-    // 1-channel texture so the shader can always sample .r correctly.
-    if (isSingleChannel && texImage.channels > 1)
+    // Requests no material refers to any more (all their uses were packed) are not loaded
+    std::vector<bool> isReferenced(requestCount, false);
+    for (const Material& material : scene->materials)
     {
-        size_t srcCh = uvChannelIndex(uvTexture.connectedOutputChannel);
-        float scale = uvTexture.scale[srcCh];
-        float bias = uvTexture.bias[srcCh];
+        for (uint32_t id : {material.baseColorTextureId,
+                            material.metallicTextureId,
+                            material.roughnessTextureId,
+                            material.emissiveTextureId,
+                            material.normalTextureId,
+                            material.transmissionTextureId})
+        {
+            if (id < requestCount)
+                isReferenced[id] = true;
+        }
+    }
+
+    std::vector<DecodedImage> packed(packs.size());
+    ThreadPool::get().parallelFor(
+        packs.size(),
+        1,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t p = begin; p < end; ++p)
+            {
+                const std::vector<uint32_t>& members = packs[p];
+                const DecodedImage& first = converted[members[0]];
+                const size_t numPixels = static_cast<size_t>(first.width) * first.height;
+                const size_t nCh = members.size();
+                DecodedImage& result = packed[p];
+                result.width = first.width;
+                result.height = first.height;
+                result.channels = static_cast<uint32_t>(nCh);
+                if (!first.bytes.empty())
+                    result.bytes.resize(numPixels * nCh);
+                else
+                    result.floats.resize(numPixels * nCh);
+                for (size_t c = 0; c < nCh; ++c)
+                {
+                    const DecodedImage& source = converted[members[c]];
+                    for (size_t i = 0; i < numPixels; ++i)
+                    {
+                        if (!first.bytes.empty())
+                            result.bytes[i * nCh + c] = source.bytes[i];
+                        else
+                            result.floats[i * nCh + c] = source.floats[i];
+                    }
+                }
+            }
+        }
+    );
 
-        size_t nCh = static_cast<size_t>(texImage.channels);
-        size_t numPixels = static_cast<size_t>(texImage.width) * texImage.height;
-        std::vector<float> extracted(numPixels);
-        for (size_t i = 0; i < numPixels; ++i)
-            extracted[i] = floatData[i * nCh + srcCh] * scale + bias;
+    // Load in request order, then packs, so engine texture IDs are the same for every run and thread count
+    auto getRequestName = [&](uint32_t r)
+    {
+        const TextureRequest& request = mTextureRequests[r];
+        const auto& texImage = mRenderScene.images[mRenderScene.textures[request.textureId].texture_image_id];
+        return request.invert ? texImage.asset_identifier + "_transmission" : texImage.asset_identifier;
+    };
+    auto load = [&](const DecodedImage& image, TextureUsage usage, const std::string& name)
+    {
+        if (!image.bytes.empty())
+            return scene->loadTexture(image.bytes.data(), image.width, image.height, image.channels, usage, name);
+        return scene->loadTexture(image.floats.data(), image.width, image.height, image.channels, usage, name);
+    };
 
-        engineTextureId = scene->loadTexture(extracted.data(), texImage.width, texImage.height, 1, texImage.asset_identifier);
+    std::vector<uint32_t> engineIds(requestCount + packs.size(), kInvalidTextureId);
+    size_t packedRequestCount = 0;
+    for (uint32_t r = 0; r < requestCount; ++r)
+    {
+        if (!isReferenced[r])
+        {
+            packedRequestCount++;
+            continue;
+        }
+        const DecodedImage& image = converted[r];
+        if (image.bytes.empty() && image.floats.empty())
+        {
+            LOG_ERROR("Texture {} could not be loaded; its asset may be missing", mTextureRequests[r].textureId);
+            continue;
+        }
+        engineIds[r] = load(image, mTextureRequests[r].usage, getRequestName(r));
     }
-    else
-        engineTextureId = scene->loadTexture(floatData, texImage.width, texImage.height, texImage.channels, texImage.asset_identifier);
+    for (size_t p = 0; p < packs.size(); ++p)
+    {
+        std::string name = getRequestName(packs[p][0]);
+        for (size_t c = 1; c < packs[p].size(); ++c)
+            name += "+" + getRequestName(packs[p][c]);
+        engineIds[requestCount + p] = load(packed[p], TextureUsage::Data, name);
+    }
+    if (!packs.empty())
+        LOG_INFO("Packed {} single-channel textures into {} multi-channel textures", packedRequestCount, packs.size());
 
-    mUsdTextureIdChannelToEngineId[cacheKey] = engineTextureId;
-    return engineTextureId;
+    auto resolve = [&](uint32_t& textureId)
+    {
+        if (textureId != kInvalidTextureId)
+            textureId = engineIds[textureId];
+    };
+    for (Material& material : scene->materials)
+    {
+        resolve(material.baseColorTextureId);
+        resolve(material.metallicTextureId);
+        resolve(material.roughnessTextureId);
+        resolve(material.emissiveTextureId);
+        resolve(material.normalTextureId);
+        if (material.transmissionTextureId != kInvalidTextureId && engineIds[material.transmissionTextureId] == kInvalidTextureId)
+            material.transmissionFactor = Material().transmissionFactor; // No opacity texels: keep the untextured default
+        resolve(material.transmissionTextureId);
+    }
+    return imageIds.size();
 }
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
+#include <tuple>
 
 #include "Importer.h"
 
@@ -22,20 +23,57 @@ private:
 
     void extractCamera(const tinyusdz::GeomCamera* geomCamera, const tinyusdz::value::matrix4d& worldMatrix, ref<Scene> scene);
 
-    void extractMeshGeometry(
-        const tinyusdz::GeomMesh* geomMesh,
-        const tinyusdz::value::matrix4d& worldMatrix,
-        ref<Scene> scene,
-        const std::unordered_set<int32_t>* faceFilter = nullptr
-    );
+    // Scene mesh for a GeomMesh (or one of its material subsets). Geometry identical to an
+    // already extracted prototype reuses that mesh, so placements only add instances.
+    uint32_t getOrExtractMesh(const tinyusdz::GeomMesh* geomMesh, ref<Scene> scene, const std::vector<int32_t>* subsetFaces = nullptr);
 
-    Material extractMaterial(const tinyusdz::tydra::RenderMaterial& usdMaterial, ref<Scene> scene);
+    // Append the mesh-local vertices/indices of a GeomMesh to the scene buffers
+    void extractMeshGeometry(const tinyusdz::GeomMesh* geomMesh, ref<Scene> scene, const std::unordered_set<int32_t>* faceFilter = nullptr);
 
-    uint32_t loadTextureFromRenderScene(int32_t textureId, ref<Scene> scene);
+    // Texture IDs in the returned material are indices into mTextureRequests until loadRequestedTextures
+    Material extractMaterial(const tinyusdz::tydra::RenderMaterial& usdMaterial);
+
+    // Texture load recorded during material extraction; decoded and converted in parallel afterwards
+    struct TextureRequest
+    {
+        int32_t textureId;    // Index into mRenderScene.textures
+        TextureUsage usage;
+        bool invert = false; // Transmission from opacity: 1 - the connected channel
+    };
+
+    // Pixels of a RenderScene image, decoded and linearized
+    struct DecodedImage
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t channels = 0;
+        std::vector<uint8_t> bytes; // 8-bit sources without color space conversion
+        std::vector<float> floats;  // Everything else
+    };
+
+    uint32_t requestTexture(int32_t textureId, TextureUsage usage, bool invert = false);
+
+    // Decode all images and convert all requests on the thread pool, pack each material's single-channel
+    // scalars into one texture, then load in request order and patch the material texture IDs and channel
+    // selectors. Returns the number of images decoded.
+    size_t loadRequestedTextures(ref<Scene> scene, const std::string& baseDir);
 
     std::unordered_map<std::string, uint32_t> mMaterialPathToIndex;
-    // Cache keyed by (textureId, channelKey) to handle ORM-packed textures where
+    // Request index keyed by (textureId, channelKey, usage, invert) to handle ORM-packed textures where
     // the same image is referenced with different channel selectors (e.g., .g / .b)
-    std::map<std::pair<int32_t, int>, uint32_t> mUsdTextureIdChannelToEngineId;
-    std::unordered_map<std::string, uint32_t> mTransmissionTextureCache;
+    std::map<std::tuple<int32_t, int, TextureUsage, bool>, uint32_t> mTextureRequestIds;
+    std::vector<TextureRequest> mTextureRequests;
+    // Extracted mesh and the source it came from; the GeomMesh lives in mStage for the whole import
+    struct PrototypeMesh
+    {
+        const tinyusdz::GeomMesh* geomMesh;
+        std::vector<int32_t> subsetFaces;
+        bool hasSubset;
+        uint32_t meshID;
+    };
+    // Content hash of mesh-local geometry (+ subset faces) -> prototypes with that hash
+    std::unordered_map<uint64_t, std::vector<PrototypeMesh>> mPrototypeMeshes;
+    size_t mPrototypeReuseCount = 0;
+    // Face-vertices visited before welding, reported next to the final vertex count
+    size_t mFaceVertexCount = 0;
 };
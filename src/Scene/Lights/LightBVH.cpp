@@ -0,0 +1,354 @@
+#include "LightBVH.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr float kPi = 3.14159265358979323846f;
+constexpr uint32_t kBucketCount = 12;
+constexpr float kOneMinusEpsilon = 0x1.fffffep-1f;
+
+float safeSqrt(float x)
+{
+    return std::sqrt(std::max(x, 0.f));
+}
+
+float safeAcos(float x)
+{
+    return std::acos(std::clamp(x, -1.f, 1.f));
+}
+
+// cos(max(0, a - b)) and sin(max(0, a - b)) from the sines/cosines of a and b
+float cosSubClamped(float sinA, float cosA, float sinB, float cosB)
+{
+    if (cosA > cosB)
+        return 1.f;
+    return cosA * cosB + sinA * sinB;
+}
+
+float sinSubClamped(float sinA, float cosA, float sinB, float cosB)
+{
+    if (cosA > cosB)
+        return 0.f;
+    return sinA * cosB - cosA * sinB;
+}
+
+// Cosine of the half-angle of the cone from p that bounds the box; -1 when p is inside its bounding sphere
+float boundSubtendedCos(const float3& boundsMin, const float3& boundsMax, const float3& p)
+{
+    float3 center = 0.5f * (boundsMin + boundsMax);
+    float radius2 = glm::dot(boundsMax - center, boundsMax - center);
+    float dist2 = glm::dot(p - center, p - center);
+    if (dist2 < radius2)
+        return -1.f;
+    return safeSqrt(1.f - radius2 / dist2);
+}
+
+uint32_t bucketIndex(const LightBounds& b, int dim, const float3& centroidMin, const float3& centroidMax)
+{
+    float c = 0.5f * (b.boundsMin[dim] + b.boundsMax[dim]);
+    float t = (c - centroidMin[dim]) / (centroidMax[dim] - centroidMin[dim]);
+    return std::min(static_cast<uint32_t>(kBucketCount * t), kBucketCount - 1);
+}
+
+float surfaceArea(const LightBounds& b)
+{
+    float3 d = b.boundsMax - b.boundsMin;
+    return 2.f * (d.x * d.y + d.x * d.z + d.y * d.z);
+}
+
+// Rotate v around the unit axis by angle (Rodrigues)
+float3 rotate(const float3& v, const float3& axis, float angle)
+{
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    return v * c + glm::cross(axis, v) * s + axis * glm::dot(axis, v) * (1.f - c);
+}
+
+// PBRT-v4 EvaluateCost: power x solid-angle measure of the cone x surface area, penalising thin splits
+float evaluateCost(const LightBounds& b, const float3& nodeExtent, int dim)
+{
+    float thetaO = safeAcos(b.cosThetaO);
+    float thetaE = safeAcos(b.cosThetaE);
+    float thetaW = std::min(thetaO + thetaE, kPi);
+    float sinThetaO = safeSqrt(1.f - b.cosThetaO * b.cosThetaO);
+    float mOmega = 2.f * kPi * (1.f - b.cosThetaO) +
+                   kPi / 2.f * (2.f * thetaW * sinThetaO - std::cos(thetaO - 2.f * thetaW) - 2.f * thetaO * sinThetaO + b.cosThetaO);
+    float kr = std::max({nodeExtent.x, nodeExtent.y, nodeExtent.z}) / nodeExtent[dim];
+    return b.phi * mOmega * kr * surfaceArea(b);
+}
+} // namespace
+
+float LightBounds::importance(const float3& p, const float3& n) const
+{
+    float3 pc = 0.5f * (boundsMin + boundsMax);
+    float dist2 = glm::dot(p - pc, p - pc);
+    float3 wi = dist2 > 0.f ? (p - pc) / std::sqrt(dist2) : w;
+    // Keep the receiver from getting arbitrarily close to the node's center
+    float d2 = std::max(dist2, glm::length(boundsMax - boundsMin) / 2.f);
+
+    float cosThetaW = glm::dot(w, wi);
+    if (twoSided)
+        cosThetaW = std::abs(cosThetaW);
+    float sinThetaW = safeSqrt(1.f - cosThetaW * cosThetaW);
+
+    float cosThetaB = boundSubtendedCos(boundsMin, boundsMax, p);
+    float sinThetaB = safeSqrt(1.f - cosThetaB * cosThetaB);
+
+    // Minimum angle between wi and any emitter normal, widened by the bounds' subtended angle
+    float sinThetaO = safeSqrt(1.f - cosThetaO * cosThetaO);
+    float cosThetaX = cosSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+    float sinThetaX = sinSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+    float cosThetaP = cosSubClamped(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+    if (cosThetaP <= cosThetaE)
+        return 0.f;
+
+    float importance = phi * cosThetaP / d2;
+    if (n != float3(0.f))
+    {
+        float cosThetaI = std::abs(glm::dot(wi, n));
+        float sinThetaI = safeSqrt(1.f - cosThetaI * cosThetaI);
+        importance *= cosSubClamped(sinThetaI, cosThetaI, sinThetaB, cosThetaB);
+    }
+    return std::max(importance, 0.f);
+}
+
+LightBounds LightBounds::merge(const LightBounds& a, const LightBounds& b)
+{
+    if (a.phi == 0.f)
+        return b;
+    if (b.phi == 0.f)
+        return a;
+
+    LightBounds result;
+    result.boundsMin = glm::min(a.boundsMin, b.boundsMin);
+    result.boundsMax = glm::max(a.boundsMax, b.boundsMax);
+    result.phi = a.phi + b.phi;
+    result.cosThetaE = std::min(a.cosThetaE, b.cosThetaE);
+    result.twoSided = a.twoSided || b.twoSided;
+
+    // Union of the two normal cones (PBRT-v4 DirectionCone Union)
+    float thetaA = safeAcos(a.cosThetaO);
+    float thetaB = safeAcos(b.cosThetaO);
+    float thetaD = safeAcos(glm::dot(a.w, b.w));
+    if (std::min(thetaD + thetaB, kPi) <= thetaA)
+    {
+        result.w = a.w;
+        result.cosThetaO = a.cosThetaO;
+        return result;
+    }
+    if (std::min(thetaD + thetaA, kPi) <= thetaB)
+    {
+        result.w = b.w;
+        result.cosThetaO = b.cosThetaO;
+        return result;
+    }
+
+    float thetaO = (thetaA + thetaD + thetaB) / 2.f;
+    float3 axis = glm::cross(a.w, b.w);
+    if (thetaO >= kPi || glm::dot(axis, axis) == 0.f)
+    {
+        result.w = a.w;
+        result.cosThetaO = -1.f;
+        return result;
+    }
+    result.w = glm::normalize(rotate(a.w, glm::normalize(axis), thetaO - thetaA));
+    result.cosThetaO = std::cos(thetaO);
+    return result;
+}
+
+LightBounds LightBVH::getNodeBounds(const LightBVHNode& node)
+{
+    LightBounds b;
+    b.boundsMin = node.boundsMin;
+    b.boundsMax = node.boundsMax;
+    b.phi = node.phi;
+    b.w = node.w;
+    b.cosThetaO = node.cosThetaO;
+    b.cosThetaE = node.cosThetaE;
+    b.twoSided = (node.flags & kTwoSidedFlag) != 0;
+    return b;
+}
+
+void LightBVH::build(const std::vector<LightBounds>& lights)
+{
+    mNodes.clear();
+    mBitTrails.assign(lights.size(), kInvalidBitTrail);
+    mDepthLimitHit = false;
+
+    std::vector<BuildItem> items;
+    items.reserve(lights.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(lights.size()); i++)
+    {
+        if (lights[i].phi > 0.f)
+            items.push_back({lights[i], i});
+    }
+    if (items.empty())
+        return;
+
+    mNodes.reserve(2 * items.size() - 1);
+    buildRecursive(items, 0, items.size(), 0, 0);
+    if (mDepthLimitHit)
+        LOG_WARN("Light BVH reached depth {}; some lights were left out of the hierarchy", kMaxDepth);
+}
+
+uint32_t LightBVH::addNode(const LightBounds& bounds, uint32_t childOrLight, bool isLeaf)
+{
+    LightBVHNode node = {};
+    node.boundsMin = bounds.boundsMin;
+    node.boundsMax = bounds.boundsMax;
+    node.phi = bounds.phi;
+    node.w = bounds.w;
+    node.cosThetaO = bounds.cosThetaO;
+    node.cosThetaE = bounds.cosThetaE;
+    node.childOrLight = childOrLight;
+    node.flags = (isLeaf ? kLeafFlag : 0) | (bounds.twoSided ? kTwoSidedFlag : 0);
+    mNodes.push_back(node);
+    return static_cast<uint32_t>(mNodes.size() - 1);
+}
+
+uint32_t LightBVH::buildRecursive(std::vector<BuildItem>& items, size_t begin, size_t end, uint64_t bitTrail, uint32_t depth)
+{
+    if (end - begin == 1 || depth == kMaxDepth)
+    {
+        mDepthLimitHit |= (end - begin) > 1;
+        mBitTrails[items[begin].lightIndex] = bitTrail;
+        return addNode(items[begin].bounds, items[begin].lightIndex, true);
+    }
+
+    LightBounds nodeBounds;
+    float3 centroidMin(FLT_MAX);
+    float3 centroidMax(-FLT_MAX);
+    for (size_t i = begin; i < end; i++)
+    {
+        const LightBounds& b = items[i].bounds;
+        nodeBounds = LightBounds::merge(nodeBounds, b);
+        float3 c = 0.5f * (b.boundsMin + b.boundsMax);
+        centroidMin = glm::min(centroidMin, c);
+        centroidMax = glm::max(centroidMax, c);
+    }
+    const float3 nodeExtent = nodeBounds.boundsMax - nodeBounds.boundsMin;
+
+    // Bucketed SAH-style search over all three axes, using the importance-aware cost
+    float bestCost = FLT_MAX;
+    int bestDim = -1;
+    uint32_t bestBucket = 0;
+    for (int dim = 0; dim < 3; dim++)
+    {
+        if (centroidMax[dim] == centroidMin[dim])
+            continue;
+
+        LightBounds buckets[kBucketCount];
+        for (size_t i = begin; i < end; i++)
+        {
+            uint32_t bucket = bucketIndex(items[i].bounds, dim, centroidMin, centroidMax);
+            buckets[bucket] = LightBounds::merge(buckets[bucket], items[i].bounds);
+        }
+
+        for (uint32_t split = 0; split < kBucketCount - 1; split++)
+        {
+            LightBounds below, above;
+            for (uint32_t i = 0; i <= split; i++)
+                below = LightBounds::merge(below, buckets[i]);
+            for (uint32_t i = split + 1; i < kBucketCount; i++)
+                above = LightBounds::merge(above, buckets[i]);
+
+            float cost = evaluateCost(below, nodeExtent, dim) + evaluateCost(above, nodeExtent, dim);
+            if (cost > 0.f && cost < bestCost)
+            {
+                bestCost = cost;
+                bestDim = dim;
+                bestBucket = split;
+            }
+        }
+    }
+
+    size_t mid = (begin + end) / 2;
+    if (bestDim >= 0)
+    {
+        auto it = std::partition(
+            items.begin() + begin,
+            items.begin() + end,
+            [&](const BuildItem& item) { return bucketIndex(item.bounds, bestDim, centroidMin, centroidMax) <= bestBucket; }
+        );
+        mid = static_cast<size_t>(it - items.begin());
+        if (mid == begin || mid == end)
+            mid = (begin + end) / 2;
+    }
+
+    uint32_t nodeIndex = addNode(nodeBounds, 0, false);
+    buildRecursive(items, begin, mid, bitTrail, depth + 1);
+    uint32_t secondChild = buildRecursive(items, mid, end, bitTrail | (1ull << depth), depth + 1);
+    mNodes[nodeIndex].childOrLight = secondChild;
+    return nodeIndex;
+}
+
+uint32_t LightBVH::sample(const float3& p, const float3& n, float u, float& pmf) const
+{
+    pmf = 0.f;
+    if (mNodes.empty())
+        return kInvalidLight;
+
+    float nodePmf = 1.f;
+    uint32_t nodeIndex = 0;
+    while (true)
+    {
+        const LightBVHNode& node = mNodes[nodeIndex];
+        if (node.flags & kLeafFlag)
+        {
+            if (nodeIndex > 0 || getNodeBounds(node).importance(p, n) > 0.f)
+            {
+                pmf = nodePmf;
+                return node.childOrLight;
+            }
+            return kInvalidLight;
+        }
+
+        float ci0 = getNodeBounds(mNodes[nodeIndex + 1]).importance(p, n);
+        float ci1 = getNodeBounds(mNodes[node.childOrLight]).importance(p, n);
+        if (ci0 == 0.f && ci1 == 0.f)
+            return kInvalidLight;
+
+        // Pick a child and remap u to [0, 1) within the chosen interval
+        float p0 = ci0 / (ci0 + ci1);
+        if (u < p0)
+        {
+            nodePmf *= p0;
+            u = std::min(u / p0, kOneMinusEpsilon);
+            nodeIndex = nodeIndex + 1;
+        }
+        else
+        {
+            nodePmf *= 1.f - p0;
+            u = std::min((u - p0) / (1.f - p0), kOneMinusEpsilon);
+            nodeIndex = node.childOrLight;
+        }
+    }
+}
+
+float LightBVH::evalPMF(const float3& p, const float3& n, uint32_t lightIndex) const
+{
+    if (lightIndex >= mBitTrails.size() || mBitTrails[lightIndex] == kInvalidBitTrail)
+        return 0.f;
+
+    uint64_t bitTrail = mBitTrails[lightIndex];
+    float pmf = 1.f;
+    uint32_t nodeIndex = 0;
+    while (true)
+    {
+        const LightBVHNode& node = mNodes[nodeIndex];
+        if (node.flags & kLeafFlag)
+            return (nodeIndex > 0 || getNodeBounds(node).importance(p, n) > 0.f) ? pmf : 0.f;
+
+        float ci0 = getNodeBounds(mNodes[nodeIndex + 1]).importance(p, n);
+        float ci1 = getNodeBounds(mNodes[node.childOrLight]).importance(p, n);
+        if (ci0 == 0.f && ci1 == 0.f)
+            return 0.f;
+
+        bool second = (bitTrail & 1) != 0;
+        pmf *= (second ? ci1 : ci0) / (ci0 + ci1);
+        nodeIndex = second ? node.childOrLight : nodeIndex + 1;
+        bitTrail >>= 1;
+    }
+}
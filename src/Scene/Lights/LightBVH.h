@@ -0,0 +1,93 @@
+#pragma once
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+#include "Utils/Math/Math.h"
+
+// Spatial and directional bounds of a set of emitters (PBRT-v4 LightBounds).
+struct LightBounds
+{
+    float3 boundsMin = float3(FLT_MAX);
+    float3 boundsMax = float3(-FLT_MAX);
+    float phi = 0.f;            // Emitted power
+    float3 w = float3(0, 0, 1); // Normal cone axis
+    float cosThetaO = 1.f;      // Normal cone half-angle
+    float cosThetaE = 0.f;      // Emission falloff past the normal cone (pi/2 for diffuse emitters)
+    bool twoSided = false;
+
+    // Importance for a receiver at p with normal n; n = 0 ignores the receiver orientation
+    float importance(const float3& p, const float3& n) const;
+
+    static LightBounds merge(const LightBounds& a, const LightBounds& b);
+};
+
+// Flat GPU node, depth-first order: an interior node's first child follows it directly.
+// Layout matches LightBVHNode in LightBVH.slang.
+struct LightBVHNode
+{
+    float3 boundsMin;
+    float phi;
+    float3 boundsMax;
+    float cosThetaO;
+    float3 w;
+    float cosThetaE;
+    uint32_t childOrLight; // Interior: index of the second child. Leaf: light index
+    uint32_t flags;        // LightBVH::kLeafFlag | LightBVH::kTwoSidedFlag
+    uint32_t _padding0;
+    uint32_t _padding1;
+};
+static_assert(sizeof(LightBVHNode) == 64, "LightBVHNode must match the Slang layout");
+
+/*
+    Light BVH for many-light sampling (PBRT-v4 BVHLightSampler). Nodes carry bounds, a normal
+    cone and power; traversal picks a child proportionally to LightBounds::importance, and the
+    per-light bit trail replays those choices to evaluate the pmf of a given light.
+    sample() and evalPMF() are CPU references of the shader code in LightSampler.slang.
+*/
+class LightBVH
+{
+public:
+    static constexpr uint32_t kLeafFlag = 1;
+    static constexpr uint32_t kTwoSidedFlag = 2;
+    static constexpr uint32_t kInvalidLight = 0xFFFFFFFF;
+    // Bit trails are 64 bits wide; bit 63 is never set by a valid trail so all-ones marks absent lights.
+    static constexpr uint32_t kMaxDepth = 63;
+    static constexpr uint64_t kInvalidBitTrail = ~0ull;
+
+    // Build over lights[i]; zero-power lights are left out and keep kInvalidBitTrail.
+    void build(const std::vector<LightBounds>& lights);
+
+    bool empty() const { return mNodes.empty(); }
+    const std::vector<LightBVHNode>& getNodes() const { return mNodes; }
+    const std::vector<uint64_t>& getBitTrails() const { return mBitTrails; }
+
+    /*
+        Stochastic top-down traversal
+        \param p Receiver position
+        \param n Receiver normal, or zero
+        \param u Uniform sample in [0, 1)
+        \param pmf Probability of the returned light
+        \return Light index, or kInvalidLight if no light contributes
+    */
+    uint32_t sample(const float3& p, const float3& n, float u, float& pmf) const;
+
+    // Probability that sample() returns lightIndex for the same receiver
+    float evalPMF(const float3& p, const float3& n, uint32_t lightIndex) const;
+
+    static LightBounds getNodeBounds(const LightBVHNode& node);
+
+private:
+    struct BuildItem
+    {
+        LightBounds bounds;
+        uint32_t lightIndex;
+    };
+
+    uint32_t buildRecursive(std::vector<BuildItem>& items, size_t begin, size_t end, uint64_t bitTrail, uint32_t depth);
+    uint32_t addNode(const LightBounds& bounds, uint32_t childOrLight, bool isLeaf);
+
+    std::vector<LightBVHNode> mNodes;
+    std::vector<uint64_t> mBitTrails;
+    bool mDepthLimitHit = false;
+};
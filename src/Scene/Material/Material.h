@@ -11,6 +11,14 @@ struct UVTransform
     float2 offset = {0.f, 0.f};
 };
 
+// Scalar texture slots that may read any channel of a shared multi-channel texture
+enum class MaterialScalarSlot : uint
+{
+    Metallic = 0,
+    Roughness = 1,
+    Transmission = 2,
+};
+
 struct Material
 {
     // GLTF 2.0 standard
@@ -32,7 +40,8 @@ struct Material
     uint normalTextureId = kInvalidTextureId;
     uint transmissionTextureId = kInvalidTextureId;
 
-    uint _padding2[2]; // pad to 16-byte boundary before UV transforms
+    uint scalarChannels = 0; // 2 bits per MaterialScalarSlot: channel sampled from its texture (0 = R ... 3 = A)
+    uint _padding2;          // pad to 16-byte boundary before UV transforms
 
     UVTransform baseColorUV;
     UVTransform metallicUV;
@@ -42,4 +51,11 @@ struct Material
     UVTransform transmissionUV;
 
     Material() = default;
+
+    uint getScalarChannel(MaterialScalarSlot slot) const { return (scalarChannels >> (2 * static_cast<uint>(slot))) & 3u; }
+    void setScalarChannel(MaterialScalarSlot slot, uint channel)
+    {
+        const uint shift = 2 * static_cast<uint>(slot);
+        scalarChannels = (scalarChannels & ~(3u << shift)) | ((channel & 3u) << shift);
+    }
 };
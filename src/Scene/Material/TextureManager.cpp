@@ -2,8 +2,265 @@
 #include "Core/Device.h"
 #include "Utils/Logger.h"
 #include "Utils/ResourceIO.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/UploadQueue.h"
+#include "TextureMips.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <DirectXTex.h>
 
-TextureManager::TextureManager(ref<Device> device) : mpDevice(device) {}
+namespace
+{
+// Shared by every TextureManager so a generation never matches one handed out by another scene
+std::atomic<uint64_t> sNextGeneration{1};
+
+uint64_t nextGeneration()
+{
+    return sNextGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+DXGI_FORMAT getDxgiFormat(nvrhi::Format format)
+{
+    switch (format)
+    {
+    case nvrhi::Format::R8_UNORM:
+        return DXGI_FORMAT_R8_UNORM;
+    case nvrhi::Format::RG8_UNORM:
+        return DXGI_FORMAT_R8G8_UNORM;
+    case nvrhi::Format::RGBA8_UNORM:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case nvrhi::Format::SRGBA8_UNORM:
+        return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+    case nvrhi::Format::BC1_UNORM:
+        return DXGI_FORMAT_BC1_UNORM;
+    case nvrhi::Format::BC1_UNORM_SRGB:
+        return DXGI_FORMAT_BC1_UNORM_SRGB;
+    case nvrhi::Format::BC4_UNORM:
+        return DXGI_FORMAT_BC4_UNORM;
+    case nvrhi::Format::BC5_UNORM:
+        return DXGI_FORMAT_BC5_UNORM;
+    case nvrhi::Format::BC7_UNORM:
+        return DXGI_FORMAT_BC7_UNORM;
+    case nvrhi::Format::BC7_UNORM_SRGB:
+        return DXGI_FORMAT_BC7_UNORM_SRGB;
+    default:
+        return DXGI_FORMAT_UNKNOWN;
+    }
+}
+
+// Uncompressed 8-bit format a BC format decodes to on the CPU
+nvrhi::Format getDecodedFormat(nvrhi::Format format)
+{
+    switch (format)
+    {
+    case nvrhi::Format::BC1_UNORM:
+    case nvrhi::Format::BC7_UNORM:
+        return nvrhi::Format::RGBA8_UNORM;
+    case nvrhi::Format::BC1_UNORM_SRGB:
+    case nvrhi::Format::BC7_UNORM_SRGB:
+        return nvrhi::Format::SRGBA8_UNORM;
+    case nvrhi::Format::BC4_UNORM:
+        return nvrhi::Format::R8_UNORM;
+    case nvrhi::Format::BC5_UNORM:
+        return nvrhi::Format::RG8_UNORM;
+    default:
+        return nvrhi::Format::UNKNOWN;
+    }
+}
+
+// BC1 for opaque color, BC7 when alpha is used, BC4/BC5 for one/two channels; UNKNOWN keeps the texels uncompressed.
+nvrhi::Format chooseCompressedFormat(uint32_t width, uint32_t height, nvrhi::Format format, const std::vector<uint8_t>& texels)
+{
+    // D3D12 requires the top mip of a block-compressed texture to be a whole number of blocks
+    if (width % 4 != 0 || height % 4 != 0)
+        return nvrhi::Format::UNKNOWN;
+
+    auto isOpaque = [&]()
+    {
+        for (size_t i = 3; i < texels.size(); i += 4)
+        {
+            if (texels[i] != 255)
+                return false;
+        }
+        return true;
+    };
+
+    switch (format)
+    {
+    case nvrhi::Format::R8_UNORM:
+        return nvrhi::Format::BC4_UNORM;
+    case nvrhi::Format::RG8_UNORM:
+        return nvrhi::Format::BC5_UNORM;
+    case nvrhi::Format::RGBA8_UNORM:
+        return isOpaque() ? nvrhi::Format::BC1_UNORM : nvrhi::Format::BC7_UNORM;
+    case nvrhi::Format::SRGBA8_UNORM:
+        return isOpaque() ? nvrhi::Format::BC1_UNORM_SRGB : nvrhi::Format::BC7_UNORM_SRGB;
+    default:
+        return nvrhi::Format::UNKNOWN;
+    }
+}
+
+// Size of the same texture as a single-level R32/RG32/RGBA32_FLOAT texture, the layout every texture used to get
+uint64_t getFloatEquivalentSizeBytes(uint32_t width, uint32_t height, nvrhi::Format format)
+{
+    const nvrhi::FormatInfo& info = nvrhi::getFormatInfo(format);
+    uint32_t channels = info.hasRed + info.hasGreen + info.hasBlue + info.hasAlpha;
+    uint32_t floatChannels = channels <= 2 ? std::max(channels, 1u) : 4;
+    return static_cast<uint64_t>(width) * height * floatChannels * sizeof(float);
+}
+
+// Block-compress a full mip chain; empty on failure
+std::vector<uint8_t> compressChain(
+    uint32_t width,
+    uint32_t height,
+    nvrhi::Format format,
+    uint32_t mipLevels,
+    const std::vector<uint8_t>& chain,
+    nvrhi::Format compressedFormat
+)
+{
+    DirectX::TexMetadata metadata = {};
+    metadata.width = width;
+    metadata.height = height;
+    metadata.depth = 1;
+    metadata.arraySize = 1;
+    metadata.mipLevels = mipLevels;
+    metadata.format = getDxgiFormat(format);
+    metadata.dimension = DirectX::TEX_DIMENSION_TEXTURE2D;
+
+    const uint32_t texelBytes = nvrhi::getFormatInfo(format).bytesPerBlock;
+    std::vector<DirectX::Image> levels(mipLevels);
+    size_t offset = 0;
+    for (uint32_t level = 0; level < mipLevels; ++level)
+    {
+        DirectX::Image& image = levels[level];
+        image.width = std::max(width >> level, 1u);
+        image.height = std::max(height >> level, 1u);
+        image.format = metadata.format;
+        image.rowPitch = image.width * texelBytes;
+        image.slicePitch = image.rowPitch * image.height;
+        image.pixels = const_cast<uint8_t*>(chain.data()) + offset;
+        offset += image.slicePitch;
+    }
+
+    DirectX::ScratchImage compressed;
+    const auto flags = DirectX::TEX_COMPRESS_PARALLEL | DirectX::TEX_COMPRESS_BC7_QUICK;
+    if (FAILED(DirectX::Compress(
+            levels.data(), levels.size(), metadata, getDxgiFormat(compressedFormat), flags, DirectX::TEX_THRESHOLD_DEFAULT, compressed
+        )))
+        return {};
+
+    std::vector<uint8_t> blocks;
+    blocks.reserve(TextureMips::getChainSizeBytes(width, height, compressedFormat, mipLevels));
+    for (uint32_t level = 0; level < mipLevels; ++level)
+    {
+        const DirectX::Image* pLevel = compressed.GetImage(level, 0, 0);
+        blocks.insert(blocks.end(), pLevel->pixels, pLevel->pixels + pLevel->slicePitch);
+    }
+    return blocks;
+}
+
+// Average a fixed 4x4 grid of source texels per thumbnail texel, so the cost stays bounded for 4K+ textures.
+// Block-compressed textures gather the blocks under those taps into one small image and decode only that.
+TextureThumbnail buildThumbnail(uint32_t width, uint32_t height, nvrhi::Format format, const uint8_t* pData)
+{
+    constexpr uint32_t kTaps = 4;
+    TextureThumbnail thumbnail;
+    const nvrhi::FormatInfo& info = nvrhi::getFormatInfo(format);
+    const bool isCompressed = info.blockSize > 1;
+    const nvrhi::Format texelFormat = isCompressed ? getDecodedFormat(format) : format;
+    if (!TextureMips::isSupportedFormat(texelFormat))
+        return thumbnail;
+
+    thumbnail.width = std::min(width, TextureThumbnail::kMaxSize);
+    thumbnail.height = std::min(height, TextureThumbnail::kMaxSize);
+    const uint32_t tapsX = thumbnail.width * kTaps;
+    const uint32_t tapsY = thumbnail.height * kTaps;
+    std::vector<uint32_t> tapX(tapsX), tapY(tapsY);
+    for (uint32_t i = 0; i < tapsX; ++i)
+        tapX[i] = std::min(static_cast<uint32_t>((i / kTaps + (i % kTaps + 0.5f) / kTaps) * width / thumbnail.width), width - 1);
+    for (uint32_t j = 0; j < tapsY; ++j)
+        tapY[j] = std::min(static_cast<uint32_t>((j / kTaps + (j % kTaps + 0.5f) / kTaps) * height / thumbnail.height), height - 1);
+
+    // Source of tap (i, j): the texel itself, or its texel inside the gathered copy of its block
+    const uint32_t bytesPerTexel = nvrhi::getFormatInfo(texelFormat).bytesPerBlock;
+    const uint8_t* pTexels = pData;
+    size_t rowPitch = static_cast<size_t>(width) * bytesPerTexel;
+    DirectX::ScratchImage decoded;
+    if (isCompressed)
+    {
+        const uint32_t blockSize = info.blockSize;
+        const uint32_t blocksPerRow = (width + blockSize - 1) / blockSize;
+        std::vector<uint8_t> gathered(static_cast<size_t>(tapsX) * tapsY * info.bytesPerBlock);
+        for (uint32_t j = 0; j < tapsY; ++j)
+        {
+            for (uint32_t i = 0; i < tapsX; ++i)
+            {
+                size_t srcBlock = static_cast<size_t>(tapY[j] / blockSize) * blocksPerRow + tapX[i] / blockSize;
+                size_t dstBlock = static_cast<size_t>(j) * tapsX + i;
+                std::memcpy(&gathered[dstBlock * info.bytesPerBlock], pData + srcBlock * info.bytesPerBlock, info.bytesPerBlock);
+            }
+        }
+
+        DirectX::Image image = {};
+        image.width = tapsX * blockSize;
+        image.height = tapsY * blockSize;
+        image.format = getDxgiFormat(format);
+        image.rowPitch = static_cast<size_t>(tapsX) * info.bytesPerBlock;
+        image.slicePitch = gathered.size();
+        image.pixels = gathered.data();
+        if (FAILED(DirectX::Decompress(image, getDxgiFormat(texelFormat), decoded)))
+        {
+            LOG_WARN("Failed to decode block-compressed texture for its thumbnail");
+            return TextureThumbnail();
+        }
+        pTexels = decoded.GetImage(0, 0, 0)->pixels;
+        rowPitch = decoded.GetImage(0, 0, 0)->rowPitch;
+        for (uint32_t i = 0; i < tapsX; ++i)
+            tapX[i] = i * blockSize + tapX[i] % blockSize;
+        for (uint32_t j = 0; j < tapsY; ++j)
+            tapY[j] = j * blockSize + tapY[j] % blockSize;
+    }
+
+    thumbnail.texels.resize(static_cast<size_t>(thumbnail.width) * thumbnail.height);
+    for (uint32_t ty = 0; ty < thumbnail.height; ++ty)
+    {
+        for (uint32_t tx = 0; tx < thumbnail.width; ++tx)
+        {
+            float3 sum(0.f);
+            for (uint32_t j = ty * kTaps; j < (ty + 1) * kTaps; ++j)
+            {
+                for (uint32_t i = tx * kTaps; i < (tx + 1) * kTaps; ++i)
+                {
+                    const uint8_t* pTexel = pTexels + tapY[j] * rowPitch + static_cast<size_t>(tapX[i]) * bytesPerTexel;
+                    sum += float3(TextureMips::decodeTexel(texelFormat, pTexel));
+                }
+            }
+            thumbnail.texels[static_cast<size_t>(ty) * thumbnail.width + tx] = sum / float(kTaps * kTaps);
+        }
+    }
+    return thumbnail;
+}
+} // namespace
+
+float3 TextureThumbnail::fetch(float2 uv) const
+{
+    if (texels.empty())
+        return float3(1.f);
+    float u = uv.x - std::floor(uv.x);
+    float v = uv.y - std::floor(uv.y);
+    uint32_t x = std::min(static_cast<uint32_t>(u * width), width - 1);
+    uint32_t y = std::min(static_cast<uint32_t>(v * height), height - 1);
+    return texels[static_cast<size_t>(y) * width + x];
+}
+
+TextureManager::TextureManager(ref<Device> device)
+    : mpDevice(device), mpUploadQueue(make_ref<UploadQueue>(device)), mGeneration(nextGeneration())
+{
+}
 
 void TextureManager::initialize()
 {
@@ -30,104 +287,324 @@ void TextureManager::initialize()
     }
 }
 
-uint32_t TextureManager::loadTexture(const float* data, uint32_t width, uint32_t height, uint32_t channels, const std::string& debugName)
+uint32_t TextureManager::loadTexture(
+    const uint8_t* data,
+    uint32_t width,
+    uint32_t height,
+    uint32_t channels,
+    TextureUsage usage,
+    const std::string& debugName
+)
+{
+    if (!data || width == 0 || height == 0 || channels == 0 || channels > 4)
+    {
+        LOG_ERROR("Invalid texture parameters for '{}'", debugName);
+        return kInvalidTextureId;
+    }
+
+    // Normal maps only need RG; RGB is padded to RGBA since there is no 3-channel 8-bit format
+    uint32_t gpuChannels = channels == 3 ? 4 : channels;
+    if (usage == TextureUsage::Normal)
+        gpuChannels = std::min(channels, 2u);
+    const nvrhi::Format format = gpuChannels == 1   ? nvrhi::Format::R8_UNORM
+                                 : gpuChannels == 2 ? nvrhi::Format::RG8_UNORM
+                                                    : nvrhi::Format::RGBA8_UNORM;
+
+    const size_t texelCount = static_cast<size_t>(width) * height;
+    std::vector<uint8_t> texels(texelCount * gpuChannels);
+    if (gpuChannels == channels)
+        std::memcpy(texels.data(), data, texels.size());
+    else
+    {
+        for (size_t i = 0; i < texelCount; ++i)
+        {
+            for (uint32_t c = 0; c < gpuChannels; ++c)
+                texels[i * gpuChannels + c] = c < channels ? data[i * channels + c] : 255;
+        }
+    }
+
+    return loadUncompressedTexels(width, height, format, std::move(texels), usage, debugName);
+}
+
+uint32_t TextureManager::loadTexture(
+    const float* data,
+    uint32_t width,
+    uint32_t height,
+    uint32_t channels,
+    TextureUsage usage,
+    const std::string& debugName
+)
 {
-    if (!data || width == 0 || height == 0 || channels == 0)
+    if (!data || width == 0 || height == 0 || channels == 0 || channels > 4)
     {
         LOG_ERROR("Invalid texture parameters for '{}'", debugName);
         return kInvalidTextureId;
     }
 
-    uint32_t gpuChannels = channels;
-    nvrhi::Format format = determineFormat(channels, gpuChannels);
+    const size_t texelCount = static_cast<size_t>(width) * height;
+    const size_t valueCount = texelCount * channels;
+    if (usage == TextureUsage::Color && channels >= 3)
+    {
+        bool isLowDynamicRange = true;
+        for (size_t i = 0; i < valueCount && isLowDynamicRange; ++i)
+            isLowDynamicRange = data[i] >= 0.f && data[i] <= 1.f;
 
+        if (isLowDynamicRange)
+        {
+            std::vector<uint8_t> texels(texelCount * 4);
+            for (size_t i = 0; i < texelCount; ++i)
+            {
+                const float* pValue = data + i * channels;
+                float4 value(pValue[0], pValue[1], pValue[2], channels == 4 ? pValue[3] : 1.f);
+                TextureMips::encodeTexel(nvrhi::Format::SRGBA8_UNORM, value, &texels[i * 4]);
+            }
+            return loadUncompressedTexels(width, height, nvrhi::Format::SRGBA8_UNORM, std::move(texels), usage, debugName);
+        }
+    }
+
+    uint32_t gpuChannels = channels == 3 ? 4 : channels;
+    if (usage == TextureUsage::Normal)
+        gpuChannels = std::min(channels, 2u);
+    const nvrhi::Format format = gpuChannels == 1   ? nvrhi::Format::R16_FLOAT
+                                 : gpuChannels == 2 ? nvrhi::Format::RG16_FLOAT
+                                                    : nvrhi::Format::RGBA16_FLOAT;
+
+    const size_t texelBytes = gpuChannels * sizeof(uint16_t);
+    std::vector<uint8_t> texels(texelCount * texelBytes);
+    for (size_t i = 0; i < texelCount; ++i)
+    {
+        float4 value(0.f, 0.f, 0.f, 1.f);
+        for (uint32_t c = 0; c < channels; ++c)
+            value[c] = data[i * channels + c];
+        TextureMips::encodeTexel(format, value, &texels[i * texelBytes]);
+    }
+    return loadUncompressedTexels(width, height, format, std::move(texels), usage, debugName);
+}
+
+uint32_t TextureManager::loadUncompressedTexels(
+    uint32_t width,
+    uint32_t height,
+    nvrhi::Format format,
+    std::vector<uint8_t> texels,
+    TextureUsage usage,
+    const std::string& debugName
+)
+{
+    // The key covers everything that shapes the prepared texture, so a match can share the GPU texture as-is
+    uint64_t seed = Hash::combine(Hash::combine(width, height), static_cast<uint64_t>(format));
+    seed = Hash::combine(seed, (usage == TextureUsage::Normal ? 2u : 0u) | (mCompress ? 1u : 0u));
+    const Hash::Hash128 contentHash = Hash::hash128(texels.data(), texels.size(), seed);
+    auto it = mContentIds.find(contentHash);
+    if (it != mContentIds.end())
+    {
+        LOG_DEBUG("Texture '{}' matches texture {}, reusing it", debugName, it->second);
+        mDuplicateIds.push_back(it->second);
+        return it->second;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(mTextures.size());
+    mTextures.emplace_back();
+    mThumbnails.emplace_back();
+    mContentIds.emplace(contentHash, id);
+
+    const bool compress = mCompress;
+    auto prepare = [width, height, format, texels = std::move(texels), usage, compress, debugName]()
+    {
+        PreparedTexture prepared;
+        prepared.name = debugName;
+        prepared.width = width;
+        prepared.height = height;
+        prepared.format = format;
+        prepared.mipLevels = TextureMips::getLevelCount(width, height);
+        prepared.data = TextureMips::generate(width, height, format, texels.data(), prepared.mipLevels, usage == TextureUsage::Normal);
+
+        const nvrhi::Format compressedFormat = compress ? chooseCompressedFormat(width, height, format, texels) : nvrhi::Format::UNKNOWN;
+        if (compressedFormat != nvrhi::Format::UNKNOWN)
+        {
+            std::vector<uint8_t> blocks = compressChain(width, height, format, prepared.mipLevels, prepared.data, compressedFormat);
+            if (!blocks.empty())
+            {
+                prepared.format = compressedFormat;
+                prepared.data = std::move(blocks);
+            }
+            else
+                LOG_WARN("Failed to block-compress texture '{}', keeping {}", debugName, nvrhi::getFormatInfo(format).name);
+        }
+        prepared.thumbnail = buildThumbnail(width, height, prepared.format, prepared.data.data());
+        return prepared;
+    };
+    mPendingTextures.push_back({id, ThreadPool::get().submit(std::move(prepare))});
+
+    // Upload whatever is already done, and bound the texels held by in-flight preparations
+    const size_t maxPending = 2 * static_cast<size_t>(ThreadPool::get().getThreadCount()) + 2;
+    finishPendingTextures(false);
+    while (mPendingTextures.size() > maxPending)
+    {
+        mPendingTextures.front().prepared.wait();
+        finishPendingTextures(false);
+    }
+    return id;
+}
+
+void TextureManager::finishPendingTextures(bool wait)
+{
+    while (!mPendingTextures.empty())
+    {
+        PendingTexture& pending = mPendingTextures.front();
+        if (!wait && pending.prepared.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        PreparedTexture prepared = pending.prepared.get();
+        const uint32_t id = pending.id;
+        mPendingTextures.pop_front();
+        if (!finishTexture(
+                id,
+                prepared.width,
+                prepared.height,
+                prepared.format,
+                prepared.mipLevels,
+                prepared.data.data(),
+                prepared.data.size(),
+                std::move(prepared.thumbnail),
+                prepared.name
+            ))
+        {
+            // The ID was handed out already; point it at the default texture rather than at nothing
+            mTextures[id] = mDefaultTexture;
+            mGeneration = nextGeneration();
+            // No payload was recorded for this ID, so later payloads no longer line up with texture IDs
+            mRecordedPayloadsValid = false;
+        }
+    }
+}
+
+void TextureManager::flush()
+{
+    finishPendingTextures(true);
+    mpUploadQueue->submit();
+}
+
+uint32_t TextureManager::loadTextureData(
+    uint32_t width,
+    uint32_t height,
+    nvrhi::Format format,
+    uint32_t mipLevels,
+    const void* pData,
+    size_t sizeBytes,
+    const std::string& debugName
+)
+{
+    if (!pData || width == 0 || height == 0 || mipLevels == 0 || sizeBytes == 0)
+    {
+        LOG_ERROR("Invalid texture parameters for '{}'", debugName);
+        return kInvalidTextureId;
+    }
+
+    finishPendingTextures(true);
+    const uint32_t id = static_cast<uint32_t>(mTextures.size());
+    mTextures.emplace_back();
+    mThumbnails.emplace_back();
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(pData);
+    if (!finishTexture(id, width, height, format, mipLevels, bytes, sizeBytes, buildThumbnail(width, height, format, bytes), debugName))
+    {
+        mTextures.pop_back();
+        mThumbnails.pop_back();
+        return kInvalidTextureId;
+    }
+    return id;
+}
+
+bool TextureManager::finishTexture(
+    uint32_t id,
+    uint32_t width,
+    uint32_t height,
+    nvrhi::Format format,
+    uint32_t mipLevels,
+    const uint8_t* pData,
+    size_t sizeBytes,
+    TextureThumbnail thumbnail,
+    const std::string& debugName
+)
+{
     auto textureDesc = nvrhi::TextureDesc()
                            .setDimension(nvrhi::TextureDimension::Texture2D)
                            .setWidth(width)
                            .setHeight(height)
-                           .setMipLevels(1)
+                           .setMipLevels(mipLevels)
                            .setFormat(format)
                            .setInitialState(nvrhi::ResourceStates::ShaderResource)
                            .setKeepInitialState(true)
                            .setDebugName(debugName);
 
-    auto nvrhiDevice = mpDevice->getDevice();
-    nvrhi::TextureHandle texture = nvrhiDevice->createTexture(textureDesc);
+    nvrhi::TextureHandle texture = mpDevice->getDevice()->createTexture(textureDesc);
     if (!texture)
     {
         LOG_ERROR("Failed to create texture '{}'", debugName);
-        return kInvalidTextureId;
+        return false;
     }
 
-    std::vector<float> uploadData = prepareUploadData(data, width, height, channels, gpuChannels);
-
-    size_t dataSize = width * height * gpuChannels * sizeof(float);
-    if (!ResourceIO::uploadTexture(mpDevice, texture, uploadData.data(), dataSize))
+    if (!mpUploadQueue->enqueueTexture(texture, pData, sizeBytes))
     {
         LOG_ERROR("Failed to upload texture '{}'", debugName);
-        return kInvalidTextureId;
+        return false;
     }
 
-    mTextures.push_back(texture);
-    LOG_DEBUG("Loaded texture '{}' ({}x{}, {} channels)", debugName, width, height, channels);
-    return static_cast<uint32_t>(mTextures.size() - 1);
-}
+    if (mRecordPayloads)
+    {
+        TexturePayload payload;
+        payload.name = debugName;
+        payload.width = width;
+        payload.height = height;
+        payload.format = format;
+        payload.mipLevels = mipLevels;
+        payload.data.assign(pData, pData + sizeBytes);
+        mRecordedPayloads.push_back(std::move(payload));
+    }
 
-nvrhi::TextureHandle TextureManager::getTexture(uint32_t textureId) const
-{
-    if (textureId < mTextures.size())
-        return mTextures[textureId];
-    return nullptr;
+    mTextureBytes += TextureMips::getChainSizeBytes(width, height, format, mipLevels);
+    mFloatEquivalentBytes += getFloatEquivalentSizeBytes(width, height, format);
+    mThumbnails[id] = std::move(thumbnail);
+    mTextures[id] = texture;
+    mGeneration = nextGeneration();
+    LOG_DEBUG("Loaded texture '{}' ({}x{}, {}, {} mips)", debugName, width, height, nvrhi::getFormatInfo(format).name, mipLevels);
+    return true;
 }
 
-nvrhi::Format TextureManager::determineFormat(uint32_t channels, uint32_t& outGpuChannels) const
+uint64_t TextureManager::getDeduplicatedBytes() const
 {
-    nvrhi::Format format;
-    outGpuChannels = channels;
-
-    if (channels == 1)
-        format = nvrhi::Format::R32_FLOAT;
-    else if (channels == 2)
-        format = nvrhi::Format::RG32_FLOAT;
-    else if (channels == 3 || channels == 4)
-    {
-        format = nvrhi::Format::RGBA32_FLOAT;
-        outGpuChannels = 4;
-    }
-    else
+    uint64_t total = 0;
+    for (uint32_t id : mDuplicateIds)
     {
-        LOG_WARN("Unsupported channel count: {}, defaulting to RGBA", channels);
-        format = nvrhi::Format::RGBA32_FLOAT;
-        outGpuChannels = 4;
+        if (!mTextures[id] || mTextures[id] == mDefaultTexture)
+            continue;
+        const nvrhi::TextureDesc& desc = mTextures[id]->getDesc();
+        total += TextureMips::getChainSizeBytes(desc.width, desc.height, desc.format, desc.mipLevels);
     }
-
-    return format;
+    return total;
 }
 
-std::vector<float> TextureManager::prepareUploadData(
-    const float* data,
-    uint32_t width,
-    uint32_t height,
-    uint32_t channels,
-    uint32_t gpuChannels
-) const
+void TextureManager::setPayloadRecording(bool enable)
 {
-    std::vector<float> uploadData;
-
-    // RGB needs conversion to RGBA
-    if (channels == 3 && gpuChannels == 4)
+    mRecordPayloads = enable;
+    mRecordedPayloadsValid = true;
+    if (!enable)
     {
-        uploadData.resize(width * height * 4);
-        for (uint32_t i = 0; i < width * height; ++i)
-        {
-            uploadData[i * 4] = data[i * 3];
-            uploadData[i * 4 + 1] = data[i * 3 + 1];
-            uploadData[i * 4 + 2] = data[i * 3 + 2];
-            uploadData[i * 4 + 3] = 1.0f;
-        }
+        mRecordedPayloads.clear();
+        mRecordedPayloads.shrink_to_fit();
     }
-    else
-        uploadData.assign(data, data + width * height * channels);
+}
+
+const TextureThumbnail* TextureManager::getThumbnail(uint32_t textureId) const
+{
+    if (textureId < mThumbnails.size() && !mThumbnails[textureId].texels.empty())
+        return &mThumbnails[textureId];
+    return nullptr;
+}
 
-    return uploadData;
+nvrhi::TextureHandle TextureManager::getTexture(uint32_t textureId) const
+{
+    if (textureId >= mTextures.size())
+        return nullptr;
+    return mTextures[textureId] ? mTextures[textureId] : mDefaultTexture;
 }
@@ -1,29 +1,148 @@
 #pragma once
+#include <deque>
+#include <future>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <nvrhi/nvrhi.h>
 
 #include "Core/Pointer.h"
+#include "Utils/Hash.h"
+#include "Utils/Math/Math.h"
 
 class Device;
+class UploadQueue;
 
 static const uint32_t kInvalidTextureId = 0xFFFFFFFF;
 
-// Manages texture resources and handles CPU-to-GPU texture uploads
+// How the shaders read a texture; selects its GPU storage format (see TextureSampler.slang)
+enum class TextureUsage
+{
+    Color,  // Linear RGB(A) sampled through .rgb, e.g. base color or emission
+    Data,   // Linear scalars sampled through .r, e.g. metallic, roughness or transmission
+    Normal, // Tangent-space normal map; only .rg is sampled and z is reconstructed
+};
+
+// CPU copy of a texture exactly as it was uploaded (after format conversion and mip generation).
+// Recorded during import so the scene cache can restore textures without the importer.
+struct TexturePayload
+{
+    std::string name;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    nvrhi::Format format = nvrhi::Format::UNKNOWN;
+    uint32_t mipLevels = 1;
+    std::vector<uint8_t> data; // All mip levels, finest first
+};
+
+// Low-resolution RGB copy of a texture kept on the CPU, e.g. to estimate emitted power per triangle.
+// Each texel is the box-filtered average of its source footprint.
+struct TextureThumbnail
+{
+    static constexpr uint32_t kMaxSize = 32;
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float3> texels;
+
+    // Nearest lookup with repeat addressing (matches the material sampler's wrap mode)
+    float3 fetch(float2 uv) const;
+};
+
+/*
+    Manages texture resources and handles CPU-to-GPU texture uploads.
+    loadTexture converts the source texels on the calling thread, then generates mips, block-compresses
+    and builds the thumbnail on worker threads. Finished textures are uploaded in load order through a
+    batched UploadQueue while later ones are still being prepared. IDs are valid immediately; texture
+    handles, thumbnails, payloads and memory statistics cover a texture once it has been flushed.
+    Converted texels are hashed before preparation; a load whose payload matches an earlier one returns
+    the earlier ID instead of creating another GPU texture.
+*/
 class TextureManager
 {
 public:
     TextureManager(ref<Device> device);
     ~TextureManager() = default;
 
-    // Load texture from CPU memory to GPU
-    uint32_t loadTexture(const float* data, uint32_t width, uint32_t height, uint32_t channels, const std::string& debugName = "");
+    /*
+        Load 8-bit texels, stored as-is in R8/RG8/RGBA8_UNORM (or block-compressed when enabled).
+        Both loadTexture overloads generate a full mip chain asynchronously; call flush() before use.
+        \param data Tightly packed texels with `channels` bytes each
+        \param usage How the shaders sample the texture; normal maps keep only RG
+        \return Texture ID, or kInvalidTextureId on failure
+    */
+    uint32_t loadTexture(
+        const uint8_t* data,
+        uint32_t width,
+        uint32_t height,
+        uint32_t channels,
+        TextureUsage usage,
+        const std::string& debugName = ""
+    );
+
+    /*
+        Load floating-point texels. Color data within [0, 1] is stored as RGBA8_UNORM_SRGB, which is
+        lossless for 8-bit sources linearized on import; anything else is stored as 16-bit float.
+        \param data Tightly packed texels with `channels` floats each
+        \param usage How the shaders sample the texture; normal maps keep only RG
+        \return Texture ID, or kInvalidTextureId on failure
+    */
+    uint32_t loadTexture(
+        const float* data,
+        uint32_t width,
+        uint32_t height,
+        uint32_t channels,
+        TextureUsage usage,
+        const std::string& debugName = ""
+    );
 
-    // Get texture by ID
+    // Load texture data that is already laid out in its GPU format (e.g. restored from the scene cache).
+    // pData holds mipLevels levels back to back, finest first. Finishes pending loads first, so IDs stay in
+    // load order, and creates the texture before returning; the upload itself is batched until flush().
+    uint32_t loadTextureData(
+        uint32_t width,
+        uint32_t height,
+        nvrhi::Format format,
+        uint32_t mipLevels,
+        const void* pData,
+        size_t sizeBytes,
+        const std::string& debugName = ""
+    );
+
+    // Wait for every pending load, create and upload the finished textures, and submit the upload batch
+    void flush();
+
+    // Encode 8-bit textures to BC1/BC4/BC5/BC7 on load. Payloads record the compressed blocks, so the
+    // scene cache stores the encoded result and warm loads skip the encoder.
+    void setCompression(bool enable) { mCompress = enable; }
+    bool isCompressionEnabled() const { return mCompress; }
+
+    // GPU bytes of all loaded textures (mips included), and what they would occupy as single-level 32-bit float textures
+    uint64_t getTextureMemoryBytes() const { return mTextureBytes; }
+    uint64_t getFloatEquivalentMemoryBytes() const { return mFloatEquivalentBytes; }
+
+    // Loads answered with an existing texture because their converted texels matched, and the GPU bytes they would have taken
+    uint32_t getDeduplicatedTextureCount() const { return static_cast<uint32_t>(mDuplicateIds.size()); }
+    uint64_t getDeduplicatedBytes() const;
+
+    // Keep a CPU copy of every uploaded texture; disabling releases recorded payloads
+    void setPayloadRecording(bool enable);
+    const std::vector<TexturePayload>& getRecordedPayloads() const { return mRecordedPayloads; }
+    // False once a texture failed to load while recording; its ID has no payload and the rest are misaligned
+    bool areRecordedPayloadsValid() const { return mRecordedPayloadsValid; }
+
+    // CPU thumbnail of a texture; nullptr for invalid IDs or formats the CPU cannot decode
+    const TextureThumbnail* getThumbnail(uint32_t textureId) const;
+
+    // Get texture by ID; the default texture while the load is still pending (until flush()), null for invalid IDs
     nvrhi::TextureHandle getTexture(uint32_t textureId) const;
 
     // Get all textures
     const std::vector<nvrhi::TextureHandle>& getAllTextures() const { return mTextures; }
+
+    // Changes whenever a texture handle is added or replaced; lets bindless tables skip unchanged frames.
+    // Drawn from a process-wide counter, so two managers never report the same generation.
+    uint64_t getGeneration() const { return mGeneration; }
     size_t getTextureCount() const { return mTextures.size(); }
 
     // Get default 1x1 white texture for unused slots
@@ -33,13 +152,63 @@ public:
     void initialize();
 
 private:
+    // Texture prepared for upload on a worker thread
+    struct PreparedTexture
+    {
+        std::string name;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        nvrhi::Format format = nvrhi::Format::UNKNOWN;
+        uint32_t mipLevels = 1;
+        std::vector<uint8_t> data; // All mip levels, finest first
+        TextureThumbnail thumbnail;
+    };
+
+    struct PendingTexture
+    {
+        uint32_t id;
+        std::future<PreparedTexture> prepared;
+    };
+
     ref<Device> mpDevice;
+    ref<UploadQueue> mpUploadQueue;
+    std::deque<PendingTexture> mPendingTextures; // In ID order
     std::vector<nvrhi::TextureHandle> mTextures;
+    std::vector<TextureThumbnail> mThumbnails; // Parallel to mTextures; empty texels if undecodable
     nvrhi::TextureHandle mDefaultTexture;
+    bool mRecordPayloads = false;
+    std::vector<TexturePayload> mRecordedPayloads;
+    bool mRecordedPayloadsValid = true;
+    bool mCompress = false;
+    uint64_t mTextureBytes = 0;
+    uint64_t mFloatEquivalentBytes = 0;
+    uint64_t mGeneration;
+    std::unordered_map<Hash::Hash128, uint32_t, Hash::Hash128Hasher> mContentIds; // Converted texels -> texture ID
+    std::vector<uint32_t> mDuplicateIds;                                          // ID returned for each deduplicated load
+
+    // Reserve an ID and prepare the texels on a worker thread (mip chain, optional block compression, thumbnail)
+    uint32_t loadUncompressedTexels(
+        uint32_t width,
+        uint32_t height,
+        nvrhi::Format format,
+        std::vector<uint8_t> texels,
+        TextureUsage usage,
+        const std::string& debugName
+    );
 
-    // Helper: determine GPU format based on channel count
-    nvrhi::Format determineFormat(uint32_t channels, uint32_t& outGpuChannels) const;
+    // Finish pending loads in ID order; wait = false stops at the first one still being prepared
+    void finishPendingTextures(bool wait);
 
-    // Helper: prepare upload data (handle RGB->RGBA conversion)
-    std::vector<float> prepareUploadData(const float* data, uint32_t width, uint32_t height, uint32_t channels, uint32_t gpuChannels) const;
+    // Create the texture for a reserved ID, queue its upload and record payload, thumbnail and statistics
+    bool finishTexture(
+        uint32_t id,
+        uint32_t width,
+        uint32_t height,
+        nvrhi::Format format,
+        uint32_t mipLevels,
+        const uint8_t* pData,
+        size_t sizeBytes,
+        TextureThumbnail thumbnail,
+        const std::string& debugName
+    );
 };
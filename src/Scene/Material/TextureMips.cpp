@@ -0,0 +1,261 @@
+#include "TextureMips.h"
+#include "Utils/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/gtc/packing.hpp>
+
+namespace
+{
+constexpr size_t kRowsPerBlock = 16;
+constexpr uint32_t kMaxTaps = 4;
+
+float srgbToLinear(float c)
+{
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb(float c)
+{
+    c = std::clamp(c, 0.f, 1.f);
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.f / 2.4f) - 0.055f;
+}
+
+uint8_t toUnorm8(float c)
+{
+    return static_cast<uint8_t>(std::clamp(c, 0.f, 1.f) * 255.f + 0.5f);
+}
+
+struct Tap
+{
+    uint32_t index;
+    float weight;
+};
+
+// Source texels covered by destination texel `dst` when srcSize texels shrink to dstSize, with
+// weights proportional to the overlap. Odd sizes give fractional footprints instead of dropping texels.
+uint32_t computeFootprint(uint32_t dst, uint32_t srcSize, uint32_t dstSize, Tap* pTaps)
+{
+    const double begin = double(dst) * srcSize / dstSize;
+    const double end = double(dst + 1) * srcSize / dstSize;
+    uint32_t count = 0;
+    for (uint32_t s = static_cast<uint32_t>(begin); s < srcSize && s < end && count < kMaxTaps; ++s)
+    {
+        double overlap = std::min(end, double(s + 1)) - std::max(begin, double(s));
+        if (overlap > 0.0)
+            pTaps[count++] = {s, static_cast<float>(overlap / (end - begin))};
+    }
+    return count;
+}
+
+// Tangent-space normals are averaged as unit vectors rather than as encoded RG values
+float4 decodeNormal(const float4& texel)
+{
+    float2 xy = float2(texel.x, texel.y) * 2.f - 1.f;
+    return float4(xy, std::sqrt(std::max(0.f, 1.f - glm::dot(xy, xy))), texel.w);
+}
+
+float4 normalizeNormal(const float4& n)
+{
+    float len = glm::length(float3(n));
+    return len > 0.f ? float4(float3(n) / len, n.w) : float4(0.f, 0.f, 1.f, n.w);
+}
+
+float4 encodeNormal(const float4& n)
+{
+    return float4(float3(n) * 0.5f + 0.5f, n.w);
+}
+} // namespace
+
+namespace TextureMips
+{
+bool isSupportedFormat(nvrhi::Format format)
+{
+    switch (format)
+    {
+    case nvrhi::Format::R8_UNORM:
+    case nvrhi::Format::RG8_UNORM:
+    case nvrhi::Format::RGBA8_UNORM:
+    case nvrhi::Format::SRGBA8_UNORM:
+    case nvrhi::Format::R16_FLOAT:
+    case nvrhi::Format::RG16_FLOAT:
+    case nvrhi::Format::RGBA16_FLOAT:
+    case nvrhi::Format::R32_FLOAT:
+    case nvrhi::Format::RG32_FLOAT:
+    case nvrhi::Format::RGBA32_FLOAT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+float4 decodeTexel(nvrhi::Format format, const uint8_t* pTexel)
+{
+    const float* f = reinterpret_cast<const float*>(pTexel);
+    const uint16_t* h = reinterpret_cast<const uint16_t*>(pTexel);
+    switch (format)
+    {
+    case nvrhi::Format::R8_UNORM:
+        return float4(pTexel[0] / 255.f, 0.f, 0.f, 1.f);
+    case nvrhi::Format::RG8_UNORM:
+        return float4(pTexel[0] / 255.f, pTexel[1] / 255.f, 0.f, 1.f);
+    case nvrhi::Format::RGBA8_UNORM:
+        return float4(pTexel[0], pTexel[1], pTexel[2], pTexel[3]) / 255.f;
+    case nvrhi::Format::SRGBA8_UNORM:
+        return float4(
+            srgbToLinear(pTexel[0] / 255.f), srgbToLinear(pTexel[1] / 255.f), srgbToLinear(pTexel[2] / 255.f), pTexel[3] / 255.f
+        );
+    case nvrhi::Format::R16_FLOAT:
+        return float4(glm::unpackHalf1x16(h[0]), 0.f, 0.f, 1.f);
+    case nvrhi::Format::RG16_FLOAT:
+        return float4(glm::unpackHalf1x16(h[0]), glm::unpackHalf1x16(h[1]), 0.f, 1.f);
+    case nvrhi::Format::RGBA16_FLOAT:
+        return float4(glm::unpackHalf1x16(h[0]), glm::unpackHalf1x16(h[1]), glm::unpackHalf1x16(h[2]), glm::unpackHalf1x16(h[3]));
+    case nvrhi::Format::R32_FLOAT:
+        return float4(f[0], 0.f, 0.f, 1.f);
+    case nvrhi::Format::RG32_FLOAT:
+        return float4(f[0], f[1], 0.f, 1.f);
+    case nvrhi::Format::RGBA32_FLOAT:
+        return float4(f[0], f[1], f[2], f[3]);
+    default:
+        return float4(0.f, 0.f, 0.f, 1.f);
+    }
+}
+
+void encodeTexel(nvrhi::Format format, const float4& value, uint8_t* pTexel)
+{
+    float* f = reinterpret_cast<float*>(pTexel);
+    uint16_t* h = reinterpret_cast<uint16_t*>(pTexel);
+    const nvrhi::FormatInfo& info = nvrhi::getFormatInfo(format);
+    const uint32_t channels = info.hasRed + info.hasGreen + info.hasBlue + info.hasAlpha;
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        switch (format)
+        {
+        case nvrhi::Format::SRGBA8_UNORM:
+            pTexel[c] = toUnorm8(c < 3 ? linearToSrgb(value[c]) : value[c]);
+            break;
+        case nvrhi::Format::R8_UNORM:
+        case nvrhi::Format::RG8_UNORM:
+        case nvrhi::Format::RGBA8_UNORM:
+            pTexel[c] = toUnorm8(value[c]);
+            break;
+        case nvrhi::Format::R16_FLOAT:
+        case nvrhi::Format::RG16_FLOAT:
+        case nvrhi::Format::RGBA16_FLOAT:
+            h[c] = glm::packHalf1x16(value[c]);
+            break;
+        case nvrhi::Format::R32_FLOAT:
+        case nvrhi::Format::RG32_FLOAT:
+        case nvrhi::Format::RGBA32_FLOAT:
+            f[c] = value[c];
+            break;
+        default:
+            return;
+        }
+    }
+}
+
+uint32_t getLevelCount(uint32_t width, uint32_t height)
+{
+    uint32_t levels = 1;
+    while (width > 1 || height > 1)
+    {
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+        levels++;
+    }
+    return levels;
+}
+
+uint64_t getChainSizeBytes(uint32_t width, uint32_t height, nvrhi::Format format, uint32_t levelCount)
+{
+    const nvrhi::FormatInfo& info = nvrhi::getFormatInfo(format);
+    uint64_t total = 0;
+    for (uint32_t level = 0; level < levelCount; ++level)
+    {
+        uint64_t blocksX = (std::max(width >> level, 1u) + info.blockSize - 1) / info.blockSize;
+        uint64_t blocksY = (std::max(height >> level, 1u) + info.blockSize - 1) / info.blockSize;
+        total += blocksX * blocksY * info.bytesPerBlock;
+    }
+    return total;
+}
+
+std::vector<uint8_t> generate(
+    uint32_t width,
+    uint32_t height,
+    nvrhi::Format format,
+    const uint8_t* pLevel0,
+    uint32_t levelCount,
+    bool isNormalMap
+)
+{
+    const uint32_t texelBytes = nvrhi::getFormatInfo(format).bytesPerBlock;
+    const size_t level0Bytes = static_cast<size_t>(width) * height * texelBytes;
+    std::vector<uint8_t> chain(getChainSizeBytes(width, height, format, levelCount));
+    std::memcpy(chain.data(), pLevel0, level0Bytes);
+
+    // Levels below the top are filtered from an unquantized float copy of the previous level
+    std::vector<float4> src, dst;
+    uint32_t srcWidth = width;
+    uint32_t srcHeight = height;
+    size_t offset = level0Bytes;
+    for (uint32_t level = 1; level < levelCount; ++level)
+    {
+        const uint32_t dstWidth = std::max(srcWidth / 2, 1u);
+        const uint32_t dstHeight = std::max(srcHeight / 2, 1u);
+        dst.resize(static_cast<size_t>(dstWidth) * dstHeight);
+
+        std::vector<Tap> tapsX(static_cast<size_t>(dstWidth) * kMaxTaps);
+        std::vector<uint32_t> tapCountsX(dstWidth);
+        for (uint32_t x = 0; x < dstWidth; ++x)
+            tapCountsX[x] = computeFootprint(x, srcWidth, dstWidth, &tapsX[static_cast<size_t>(x) * kMaxTaps]);
+
+        auto fetch = [&](uint32_t x, uint32_t y) -> float4
+        {
+            if (level > 1)
+                return src[static_cast<size_t>(y) * srcWidth + x];
+            float4 texel = decodeTexel(format, pLevel0 + (static_cast<size_t>(y) * width + x) * texelBytes);
+            return isNormalMap ? decodeNormal(texel) : texel;
+        };
+
+        uint8_t* pLevel = chain.data() + offset;
+        ThreadPool::get().parallelFor(
+            dstHeight,
+            kRowsPerBlock,
+            [&](size_t begin, size_t end)
+            {
+                Tap tapsY[kMaxTaps];
+                for (size_t y = begin; y < end; ++y)
+                {
+                    uint32_t tapCountY = computeFootprint(static_cast<uint32_t>(y), srcHeight, dstHeight, tapsY);
+                    for (uint32_t x = 0; x < dstWidth; ++x)
+                    {
+                        float4 sum(0.f);
+                        for (uint32_t j = 0; j < tapCountY; ++j)
+                        {
+                            for (uint32_t i = 0; i < tapCountsX[x]; ++i)
+                            {
+                                const Tap& tapX = tapsX[static_cast<size_t>(x) * kMaxTaps + i];
+                                sum += fetch(tapX.index, tapsY[j].index) * (tapX.weight * tapsY[j].weight);
+                            }
+                        }
+                        if (isNormalMap)
+                            sum = normalizeNormal(sum);
+
+                        const size_t texel = y * dstWidth + x;
+                        dst[texel] = sum;
+                        encodeTexel(format, isNormalMap ? encodeNormal(sum) : sum, pLevel + texel * texelBytes);
+                    }
+                }
+            }
+        );
+
+        std::swap(src, dst);
+        srcWidth = dstWidth;
+        srcHeight = dstHeight;
+        offset += static_cast<size_t>(dstWidth) * dstHeight * texelBytes;
+    }
+    return chain;
+}
+} // namespace TextureMips
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <nvrhi/nvrhi.h>
+
+#include "Utils/Math/Math.h"
+
+/*
+    CPU mip chain generation for uncompressed texture formats. Levels are stored back to back,
+    finest first, each tightly packed (rows of 4x4 blocks for BC formats).
+    Filtering happens in linear space: sRGB texels are decoded before averaging, and normal
+    maps average the decoded unit vectors and renormalize them before re-encoding RG.
+*/
+namespace TextureMips
+{
+// Formats decodeTexel/encodeTexel and generate() handle (8-bit UNORM/sRGB, 16- and 32-bit float)
+bool isSupportedFormat(nvrhi::Format format);
+
+// Texel value as the shader sees it; missing channels read as (0, 0, 0, 1)
+float4 decodeTexel(nvrhi::Format format, const uint8_t* pTexel);
+void encodeTexel(nvrhi::Format format, const float4& value, uint8_t* pTexel);
+
+// Full chain down to 1x1
+uint32_t getLevelCount(uint32_t width, uint32_t height);
+
+// Bytes of levels [0, levelCount) for any format, including block-compressed ones
+uint64_t getChainSizeBytes(uint32_t width, uint32_t height, nvrhi::Format format, uint32_t levelCount);
+
+/*
+    Build a mip chain from its top level with a box filter (exact fractional footprints for odd sizes)
+    \param pLevel0 Top level, tightly packed in `format`
+    \param levelCount Number of levels to produce, including level 0
+    \param isNormalMap RG holds a tangent-space normal encoded as n * 0.5 + 0.5
+    \return All levels, finest first
+*/
+std::vector<uint8_t> generate(
+    uint32_t width,
+    uint32_t height,
+    nvrhi::Format format,
+    const uint8_t* pLevel0,
+    uint32_t levelCount,
+    bool isNormalMap
+);
+} // namespace TextureMips
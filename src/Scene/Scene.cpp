@@ -1,34 +1,199 @@
 #include "Scene.h"
 #include "Utils/Logger.h"
+#include "Utils/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// Upper bound on the scratch memory one batch of BLAS builds may reference. Small meshes are
+// grouped until the budget is hit; a mesh larger than the budget gets a batch of its own.
+constexpr uint64_t kBlasBatchScratchBudget = 256ull * 1024 * 1024;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Same inputs nvrhi uses when sizing the BLAS; only counts and formats matter for prebuild info.
+D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO queryBlasPrebuildInfo(ID3D12Device5* pDevice5, const MeshDesc& md, uint32_t vertexCount)
+{
+    D3D12_RAYTRACING_GEOMETRY_DESC geometry = {};
+    geometry.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+    geometry.Flags = D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+    geometry.Triangles.IndexFormat = DXGI_FORMAT_R32_UINT;
+    geometry.Triangles.IndexCount = md.indexCount;
+    geometry.Triangles.VertexFormat = DXGI_FORMAT_R32G32B32_FLOAT;
+    geometry.Triangles.VertexCount = vertexCount;
+    geometry.Triangles.VertexBuffer.StrideInBytes = sizeof(Vertex);
+
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs = {};
+    inputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
+    inputs.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION |
+                   D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+    inputs.NumDescs = 1;
+    inputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+    inputs.pGeometryDescs = &geometry;
+
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info = {};
+    pDevice5->GetRaytracingAccelerationStructurePrebuildInfo(&inputs, &info);
+    return info;
+}
+
+float luminance(const float3& rgb)
+{
+    return glm::dot(rgb, float3(0.2126f, 0.7152f, 0.0722f));
+}
+
+// Mean texture value over a triangle's UV footprint. Stratified barycentric samples on the thumbnail,
+// with the sample count following the footprint size in thumbnail texels (1 .. 64 samples).
+float3 averageTextureOverTriangle(const TextureThumbnail& thumbnail, float2 uv0, float2 uv1, float2 uv2)
+{
+    float2 e1 = uv1 - uv0;
+    float2 e2 = uv2 - uv0;
+    float texelArea = 0.5f * std::abs(e1.x * e2.y - e1.y * e2.x) * thumbnail.width * thumbnail.height;
+    uint32_t n = std::clamp(static_cast<uint32_t>(std::ceil(std::sqrt(texelArea))), 1u, 8u);
+
+    float3 sum(0.f);
+    for (uint32_t j = 0; j < n; j++)
+    {
+        for (uint32_t i = 0; i < n; i++)
+        {
+            // Same warp as the shader's uniform triangle sampling (Turk 1990)
+            float su = std::sqrt((i + 0.5f) / n);
+            float b1 = 1.f - su;
+            float b2 = (j + 0.5f) / n * su;
+            sum += thumbnail.fetch(uv0 + b1 * e1 + b2 * e2);
+        }
+    }
+    return sum / float(n * n);
+}
+
+// Work partition for the emissive light pipeline; fixed so results do not depend on the thread count
+constexpr size_t kInstanceBlockSize = 1024;
+constexpr size_t kTriangleBlockSize = 4096;
+
+// Affine transform of a position; skips the projective row a full mat4 * vec4 would compute
+float3 transformPoint(const glm::mat4& m, const float p[3])
+{
+    return float3(m[0]) * p[0] + float3(m[1]) * p[1] + float3(m[2]) * p[2] + float3(m[3]);
+}
+
+// Blocked exclusive prefix sum in place: block totals in parallel, a short serial scan over the
+// block totals, then each block writes its offsets in parallel. Returns the grand total.
+uint64_t exclusiveScan(ThreadPool& pool, std::vector<uint32_t>& values, bool parallel)
+{
+    constexpr size_t kScanBlockSize = 16384;
+    std::vector<uint64_t> blockSums((values.size() + kScanBlockSize - 1) / kScanBlockSize, 0);
+    pool.parallelFor(
+        values.size(),
+        kScanBlockSize,
+        [&](size_t begin, size_t end)
+        {
+            uint64_t sum = 0;
+            for (size_t i = begin; i < end; i++)
+                sum += values[i];
+            blockSums[begin / kScanBlockSize] = sum;
+        },
+        parallel
+    );
+
+    uint64_t running = 0;
+    for (uint64_t& blockSum : blockSums)
+    {
+        uint64_t sum = blockSum;
+        blockSum = running;
+        running += sum;
+    }
+
+    pool.parallelFor(
+        values.size(),
+        kScanBlockSize,
+        [&](size_t begin, size_t end)
+        {
+            uint64_t offset = blockSums[begin / kScanBlockSize];
+            for (size_t i = begin; i < end; i++)
+            {
+                uint32_t value = values[i];
+                values[i] = static_cast<uint32_t>(offset);
+                offset += value;
+            }
+        },
+        parallel
+    );
+    return running;
+}
+
+// Size of the buffer currently backing an acceleration structure
+uint64_t getAccelStructBytes(nvrhi::rt::IAccelStruct* pAccelStruct, uint64_t fallbackBytes)
+{
+    auto* pResource = static_cast<ID3D12Resource*>(pAccelStruct->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource));
+    return pResource ? pResource->GetDesc().Width : fallbackBytes;
+}
+} // namespace
+
 Scene::Scene(ref<Device> pDevice) : mpDevice(pDevice)
 {
     mTextureManager = make_ref<TextureManager>(pDevice);
     mTextureManager->initialize();
 }
 
-void Scene::addMeshInstance(uint32_t indexOffset, uint32_t indexCount, uint32_t materialIndex, const glm::mat4& localToWorld)
+uint32_t Scene::addMesh(uint32_t indexOffset, uint32_t indexCount)
 {
     // Zero-index BLAS builds fail; drop empty meshes (e.g. USD n-gon subsets) at the source.
     if (indexCount == 0)
-        return;
+        return kInvalidMeshId;
 
     MeshDesc md;
     md.indexOffset = indexOffset;
     md.indexCount = indexCount;
     meshes.push_back(md);
+    return static_cast<uint32_t>(meshes.size() - 1);
+}
+
+void Scene::addInstance(uint32_t meshID, uint32_t materialIndex, const glm::mat4& localToWorld)
+{
+    if (meshID >= meshes.size())
+        return;
 
     MeshInstance mi;
-    mi.meshID = static_cast<uint32_t>(meshes.size() - 1);
+    mi.meshID = meshID;
     mi.materialIndex = materialIndex;
     mi.localToWorld = localToWorld;
     instances.push_back(mi);
 }
 
-uint32_t Scene::loadTexture(const float* data, uint32_t width, uint32_t height, uint32_t channels, const std::string& debugName)
+void Scene::addMeshInstance(uint32_t indexOffset, uint32_t indexCount, uint32_t materialIndex, const glm::mat4& localToWorld)
+{
+    addInstance(addMesh(indexOffset, indexCount), materialIndex, localToWorld);
+}
+
+uint32_t Scene::loadTexture(
+    const uint8_t* data,
+    uint32_t width,
+    uint32_t height,
+    uint32_t channels,
+    TextureUsage usage,
+    const std::string& debugName
+)
+{
+    return mTextureManager->loadTexture(data, width, height, channels, usage, debugName);
+}
+
+uint32_t Scene::loadTexture(
+    const float* data,
+    uint32_t width,
+    uint32_t height,
+    uint32_t channels,
+    TextureUsage usage,
+    const std::string& debugName
+)
 {
-    return mTextureManager->loadTexture(data, width, height, channels, debugName);
+    return mTextureManager->loadTexture(data, width, height, channels, usage, debugName);
 }
 
 nvrhi::TextureHandle Scene::getTexture(uint32_t textureId) const
@@ -56,6 +221,9 @@ void Scene::buildAccelStructs()
     auto nvrhiDevice = mpDevice->getDevice();
     auto commandList = mpDevice->getCommandList();
 
+    // Emissive light collection reads texture thumbnails, and rendering needs the uploads submitted
+    mTextureManager->flush();
+
     if (instances.empty())
     {
         LOG_WARN("Scene has no geometry to build acceleration structures");
@@ -115,6 +283,8 @@ void Scene::buildAccelStructs()
     if (!mMaterialBuffer)
         LOG_ERROR_RETURN("Failed to create material buffer for scene");
 
+    collectEmissiveLights();
+
     std::vector<InstanceData> instanceData(instances.size());
     for (size_t i = 0; i < instances.size(); i++)
     {
@@ -126,6 +296,7 @@ void Scene::buildAccelStructs()
         id.row2 = mt[2];
         id.meshID = mi.meshID;
         id.materialID = mi.materialIndex;
+        id.emissiveOffset = mInstanceEmissiveOffsets[i];
     }
 
     size_t instanceBufferSize = instanceData.size() * sizeof(InstanceData);
@@ -140,34 +311,21 @@ void Scene::buildAccelStructs()
     if (!mInstanceBuffer)
         LOG_ERROR_RETURN("Failed to create instance buffer for scene");
 
-    // Build per-mesh BLAS descs. Each BLAS references only its own index slice
-    // of the shared vertex/index buffers. PrimitiveIndex() in closest-hit is
-    // therefore mesh-local (0 .. triangleCount-1 per BLAS).
-    mBlases.clear();
-    mBlases.reserve(meshes.size());
-    std::vector<nvrhi::rt::GeometryDesc> blasGeomDescs(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++)
-    {
-        const MeshDesc& md = meshes[i];
-        auto triangles = nvrhi::rt::GeometryTriangles()
-                             .setVertexBuffer(mVertexBuffer)
-                             .setVertexFormat(nvrhi::Format::RGB32_FLOAT)
-                             .setVertexCount(static_cast<uint32_t>(vertices.size()))
-                             .setVertexStride(sizeof(Vertex))
-                             .setIndexBuffer(mIndexBuffer)
-                             .setIndexFormat(nvrhi::Format::R32_UINT)
-                             .setIndexCount(md.indexCount)
-                             .setIndexOffset(static_cast<uint64_t>(md.indexOffset) * sizeof(uint32_t));
-
-        blasGeomDescs[i] = nvrhi::rt::GeometryDesc().setTriangles(triangles).setFlags(nvrhi::rt::GeometryFlags::Opaque);
+    // Upload geometry first; BLAS builds on the same queue are ordered after this submission.
+    Clock::time_point stageStart = Clock::now();
+    commandList->open();
+    commandList->writeBuffer(mVertexBuffer, vertices.data(), vertexBufferSize);
+    commandList->writeBuffer(mIndexBuffer, indices.data(), indexBufferSize);
+    commandList->writeBuffer(mMeshBuffer, meshes.data(), meshBufferSize);
+    commandList->writeBuffer(mMaterialBuffer, materials.data(), materialBufferSize);
+    commandList->writeBuffer(mInstanceBuffer, instanceData.data(), instanceBufferSize);
+    commandList->close();
+    nvrhiDevice->executeCommandList(commandList);
+    mAccelStructStats = AccelStructStats();
+    mAccelStructStats.uploadMs = elapsedMs(stageStart);
 
-        auto blasDesc = nvrhi::rt::AccelStructDesc().setDebugName("BLAS_" + std::to_string(i)).setIsTopLevel(false);
-        blasDesc.addBottomLevelGeometry(blasGeomDescs[i]);
-        auto blas = nvrhiDevice->createAccelStruct(blasDesc);
-        if (!blas)
-            LOG_ERROR_RETURN("Failed to create BLAS for mesh {}", i);
-        mBlases.push_back(blas);
-    }
+    if (!buildBottomLevelAccelStructs())
+        return;
 
     auto tlasDesc =
         nvrhi::rt::AccelStructDesc().setDebugName("TLAS").setIsTopLevel(true).setTopLevelMaxInstances(static_cast<uint32_t>(instances.size()));
@@ -175,16 +333,8 @@ void Scene::buildAccelStructs()
     if (!mTlas)
         LOG_ERROR_RETURN("Failed to create TLAS");
 
+    stageStart = Clock::now();
     commandList->open();
-    commandList->writeBuffer(mVertexBuffer, vertices.data(), vertexBufferSize);
-    commandList->writeBuffer(mIndexBuffer, indices.data(), indexBufferSize);
-    commandList->writeBuffer(mMeshBuffer, meshes.data(), meshBufferSize);
-    commandList->writeBuffer(mMaterialBuffer, materials.data(), materialBufferSize);
-    commandList->writeBuffer(mInstanceBuffer, instanceData.data(), instanceBufferSize);
-
-    for (size_t i = 0; i < meshes.size(); i++)
-        commandList->buildBottomLevelAccelStruct(mBlases[i], &blasGeomDescs[i], 1);
-
     // InstanceData::row{0,1,2} packs 12 contiguous floats in row-major order — identical
     // to nvrhi::rt::AffineTransform's layout (float[12]), so we copy the 48B straight across.
     static_assert(sizeof(nvrhi::rt::AffineTransform) == 3 * sizeof(glm::vec4), "InstanceData rows must match AffineTransform layout");
@@ -203,56 +353,7 @@ void Scene::buildAccelStructs()
     }
     commandList->buildTopLevelAccelStruct(mTlas, instanceDescs.data(), instanceDescs.size());
 
-    // --- Collect emissive triangles (world-space area) and build area-weighted CDF ---
-    emissiveTriangles.clear();
-    totalEmissiveArea = 0.f;
-    for (uint32_t instIdx = 0; instIdx < static_cast<uint32_t>(instances.size()); instIdx++)
-    {
-        const MeshInstance& inst = instances[instIdx];
-        const Material& mat = materials[instanceData[instIdx].materialID];
-        bool isEmissive = (mat.emissiveFactor.r > 0.f || mat.emissiveFactor.g > 0.f || mat.emissiveFactor.b > 0.f);
-        if (!isEmissive)
-            continue;
-
-        const MeshDesc& md = meshes[inst.meshID];
-        uint32_t triangleCount = md.indexCount / 3;
-        for (uint32_t localTri = 0; localTri < triangleCount; localTri++)
-        {
-            uint32_t i0 = indices[md.indexOffset + localTri * 3 + 0];
-            uint32_t i1 = indices[md.indexOffset + localTri * 3 + 1];
-            uint32_t i2 = indices[md.indexOffset + localTri * 3 + 2];
-            glm::vec3 p0(vertices[i0].position[0], vertices[i0].position[1], vertices[i0].position[2]);
-            glm::vec3 p1(vertices[i1].position[0], vertices[i1].position[1], vertices[i1].position[2]);
-            glm::vec3 p2(vertices[i2].position[0], vertices[i2].position[1], vertices[i2].position[2]);
-            glm::vec3 p0w = glm::vec3(inst.localToWorld * glm::vec4(p0, 1.f));
-            glm::vec3 p1w = glm::vec3(inst.localToWorld * glm::vec4(p1, 1.f));
-            glm::vec3 p2w = glm::vec3(inst.localToWorld * glm::vec4(p2, 1.f));
-            float area = 0.5f * glm::length(glm::cross(p1w - p0w, p2w - p0w));
-            if (area > 0.f)
-            {
-                EmissiveTriangle et;
-                et.instanceID = instIdx;
-                et.localTriangleIndex = localTri;
-                et.area = area;
-                et.cdfUpper = 0.f;
-                emissiveTriangles.push_back(et);
-                totalEmissiveArea += area;
-            }
-        }
-    }
-
-    if (!emissiveTriangles.empty() && totalEmissiveArea > 0.f)
-    {
-        float runningSum = 0.f;
-        for (auto& et : emissiveTriangles)
-        {
-            runningSum += et.area;
-            et.cdfUpper = runningSum / totalEmissiveArea;
-        }
-        emissiveTriangles.back().cdfUpper = 1.f;
-    }
-
-    // Always create the buffer (shader reflection expects the binding even if empty).
+    // Always create the buffers (shader reflection expects the bindings even if empty).
     std::vector<EmissiveTriangle> dummyVec = {EmissiveTriangle{}};
     const auto* pBufferData = emissiveTriangles.empty() ? &dummyVec : &emissiveTriangles;
 
@@ -269,16 +370,344 @@ void Scene::buildAccelStructs()
         LOG_ERROR_RETURN("Failed to create emissive triangle buffer");
     commandList->writeBuffer(mEmissiveTriangleBuffer, pBufferData->data(), emissiveBufferSize);
 
+    std::vector<AliasEntry> dummyAlias = {AliasEntry{1.f, 0}};
+    const auto* pAliasData = emissiveTriangles.empty() ? &dummyAlias : &mEmissiveAliasTable.getEntries();
+
+    size_t aliasBufferSize = pAliasData->size() * sizeof(AliasEntry);
+    nvrhi::BufferDesc aliasBufferDesc = nvrhi::BufferDesc()
+                                            .setByteSize(aliasBufferSize)
+                                            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+                                            .setKeepInitialState(true)
+                                            .setDebugName("Scene Emissive Alias Table")
+                                            .setCanHaveRawViews(true)
+                                            .setStructStride(sizeof(AliasEntry));
+    mEmissiveAliasBuffer = nvrhiDevice->createBuffer(aliasBufferDesc);
+    if (!mEmissiveAliasBuffer)
+        LOG_ERROR_RETURN("Failed to create emissive alias table buffer");
+    commandList->writeBuffer(mEmissiveAliasBuffer, pAliasData->data(), aliasBufferSize);
+
+    std::vector<LightBVHNode> dummyNodes = {LightBVHNode{}};
+    const auto* pNodeData = mLightBVH.empty() ? &dummyNodes : &mLightBVH.getNodes();
+
+    size_t nodeBufferSize = pNodeData->size() * sizeof(LightBVHNode);
+    nvrhi::BufferDesc nodeBufferDesc = nvrhi::BufferDesc()
+                                           .setByteSize(nodeBufferSize)
+                                           .setInitialState(nvrhi::ResourceStates::ShaderResource)
+                                           .setKeepInitialState(true)
+                                           .setDebugName("Scene Light BVH Nodes")
+                                           .setCanHaveRawViews(true)
+                                           .setStructStride(sizeof(LightBVHNode));
+    mLightBVHNodeBuffer = nvrhiDevice->createBuffer(nodeBufferDesc);
+    if (!mLightBVHNodeBuffer)
+        LOG_ERROR_RETURN("Failed to create light BVH node buffer");
+    commandList->writeBuffer(mLightBVHNodeBuffer, pNodeData->data(), nodeBufferSize);
+
+    std::vector<uint64_t> dummyTrails = {LightBVH::kInvalidBitTrail};
+    const auto* pTrailData = mLightBVH.getBitTrails().empty() ? &dummyTrails : &mLightBVH.getBitTrails();
+
+    size_t trailBufferSize = pTrailData->size() * sizeof(uint64_t);
+    nvrhi::BufferDesc trailBufferDesc = nvrhi::BufferDesc()
+                                            .setByteSize(trailBufferSize)
+                                            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+                                            .setKeepInitialState(true)
+                                            .setDebugName("Scene Light BVH Bit Trails")
+                                            .setCanHaveRawViews(true)
+                                            .setStructStride(sizeof(uint64_t));
+    mLightBVHBitTrailBuffer = nvrhiDevice->createBuffer(trailBufferDesc);
+    if (!mLightBVHBitTrailBuffer)
+        LOG_ERROR_RETURN("Failed to create light BVH bit trail buffer");
+    commandList->writeBuffer(mLightBVHBitTrailBuffer, pTrailData->data(), trailBufferSize);
+
     commandList->close();
     nvrhiDevice->executeCommandList(commandList);
+    nvrhiDevice->waitForIdle();
+    mAccelStructStats.tlasMs = elapsedMs(stageStart);
+
+    const AccelStructStats& stats = mAccelStructStats;
     LOG_INFO(
-        "Scene AS built: {} verts, {} indices, {} meshes ({} BLAS), {} instances, {} materials, {} emissive triangles",
+        "Scene AS built: {} verts, {} indices, {} meshes ({} BLAS), {} instances, {} materials, {} emissive triangles ({:.1f} total power)",
         vertices.size(),
         indices.size(),
         meshes.size(),
         mBlases.size(),
         instances.size(),
         materials.size(),
-        emissiveTriangles.size()
+        emissiveTriangles.size(),
+        totalEmissivePower
+    );
+    LOG_INFO(
+        "Scene AS timings: upload {:.2f} ms, BLAS build {:.2f} ms ({} BLAS in {} batches), compaction {:.2f} ms, TLAS + lights {:.2f} ms",
+        stats.uploadMs,
+        stats.blasBuildMs,
+        stats.blasCount,
+        stats.blasBatchCount,
+        stats.compactionMs,
+        stats.tlasMs
+    );
+    LOG_INFO(
+        "Scene BLAS memory: {:.2f} MB -> {:.2f} MB after compaction ({} of {} compacted), scratch peak {:.2f} MB per batch",
+        stats.blasBytesBeforeCompaction / (1024.0 * 1024.0),
+        stats.blasBytesAfterCompaction / (1024.0 * 1024.0),
+        stats.compactedBlasCount,
+        mBlases.size(),
+        stats.peakBatchScratchBytes / (1024.0 * 1024.0)
+    );
+}
+
+void Scene::collectEmissiveLights(bool parallel)
+{
+    ThreadPool& pool = ThreadPool::get();
+    const uint32_t instanceCount = static_cast<uint32_t>(instances.size());
+    Clock::time_point stageStart = Clock::now();
+
+    // Count: triangles contributed by each instance (all of them for emissive materials, else none)
+    std::vector<uint32_t> counts(instanceCount, 0);
+    pool.parallelFor(
+        instanceCount,
+        kInstanceBlockSize,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const Material& mat = materials[instances[i].materialIndex];
+                if (mat.emissiveFactor.r > 0.f || mat.emissiveFactor.g > 0.f || mat.emissiveFactor.b > 0.f)
+                    counts[i] = meshes[instances[i].meshID].indexCount / 3;
+            }
+        },
+        parallel
+    );
+
+    // Scan: counts become each instance's first EmissiveTriangle
+    std::vector<uint32_t> offsets = counts;
+    const uint32_t triangleTotal = static_cast<uint32_t>(exclusiveScan(pool, offsets, parallel));
+    std::vector<uint32_t> emissiveInstances;
+    mInstanceEmissiveOffsets.assign(instanceCount, kInvalidEmissiveOffset);
+    for (uint32_t i = 0; i < instanceCount; i++)
+    {
+        if (counts[i] == 0)
+            continue;
+        mInstanceEmissiveOffsets[i] = offsets[i];
+        emissiveInstances.push_back(i);
+    }
+    const double scanMs = elapsedMs(stageStart);
+
+    // Fill: every triangle is independent, so blocks of the flattened triangle range run in parallel.
+    // Zero-area or black triangles stay with zero weight so the offset lookup stays dense;
+    // BSDF sampling alone (MIS weight 1) then covers them.
+    stageStart = Clock::now();
+    emissiveTriangles.assign(triangleTotal, EmissiveTriangle{});
+    std::vector<float> flux(triangleTotal);
+    std::vector<LightBounds> lightBounds(triangleTotal);
+    std::vector<double> blockAreas((triangleTotal + kTriangleBlockSize - 1) / kTriangleBlockSize, 0.0);
+    pool.parallelFor(
+        triangleTotal,
+        kTriangleBlockSize,
+        [&](size_t begin, size_t end)
+        {
+            // Locate the emissive instance holding `begin`, then walk forward through the block
+            size_t k = std::upper_bound(
+                           emissiveInstances.begin(),
+                           emissiveInstances.end(),
+                           static_cast<uint32_t>(begin),
+                           [&](uint32_t triangle, uint32_t instIdx) { return triangle < mInstanceEmissiveOffsets[instIdx]; }
+                       ) -
+                       emissiveInstances.begin() - 1;
+
+            double blockArea = 0.0;
+            for (size_t t = begin; t < end; t++)
+            {
+                while (t >= mInstanceEmissiveOffsets[emissiveInstances[k]] + counts[emissiveInstances[k]])
+                    k++;
+                const uint32_t instIdx = emissiveInstances[k];
+                const uint32_t localTri = static_cast<uint32_t>(t - mInstanceEmissiveOffsets[instIdx]);
+                const MeshInstance& inst = instances[instIdx];
+                const Material& mat = materials[inst.materialIndex];
+                const MeshDesc& md = meshes[inst.meshID];
+
+                const Vertex& v0 = vertices[indices[md.indexOffset + localTri * 3 + 0]];
+                const Vertex& v1 = vertices[indices[md.indexOffset + localTri * 3 + 1]];
+                const Vertex& v2 = vertices[indices[md.indexOffset + localTri * 3 + 2]];
+                float3 p0w = transformPoint(inst.localToWorld, v0.position);
+                float3 p1w = transformPoint(inst.localToWorld, v1.position);
+                float3 p2w = transformPoint(inst.localToWorld, v2.position);
+                float3 faceNormal = glm::cross(p1w - p0w, p2w - p0w);
+                float area = 0.5f * glm::length(faceNormal);
+
+                float3 radiance = mat.emissiveFactor;
+                if (const TextureThumbnail* pThumbnail = mTextureManager->getThumbnail(mat.emissiveTextureId))
+                {
+                    float2 uv0 = float2(v0.texCoord[0], v0.texCoord[1]) * mat.emissiveUV.scale + mat.emissiveUV.offset;
+                    float2 uv1 = float2(v1.texCoord[0], v1.texCoord[1]) * mat.emissiveUV.scale + mat.emissiveUV.offset;
+                    float2 uv2 = float2(v2.texCoord[0], v2.texCoord[1]) * mat.emissiveUV.scale + mat.emissiveUV.offset;
+                    radiance *= averageTextureOverTriangle(*pThumbnail, uv0, uv1, uv2);
+                }
+
+                EmissiveTriangle& et = emissiveTriangles[t];
+                et.instanceID = instIdx;
+                et.localTriangleIndex = localTri;
+                et.area = area;
+                et.pdf = 0.f;
+                flux[t] = area > 0.f ? area * luminance(radiance) : 0.f;
+                blockArea += area;
+
+                // Double-sided diffuse emitter: the normal cone is just the face normal, falloff reaches pi/2
+                LightBounds& lb = lightBounds[t];
+                lb.boundsMin = glm::min(p0w, glm::min(p1w, p2w));
+                lb.boundsMax = glm::max(p0w, glm::max(p1w, p2w));
+                lb.phi = flux[t];
+                lb.w = area > 0.f ? faceNormal / (2.f * area) : float3(0.f, 0.f, 1.f);
+                lb.cosThetaO = 1.f;
+                lb.cosThetaE = 0.f;
+                lb.twoSided = true;
+            }
+            blockAreas[begin / kTriangleBlockSize] = blockArea;
+        },
+        parallel
     );
+
+    // Per-block partial sums combined in block order: identical for serial and parallel runs
+    double areaSum = 0.0;
+    for (double blockArea : blockAreas)
+        areaSum += blockArea;
+    totalEmissiveArea = static_cast<float>(areaSum);
+    const double fillMs = elapsedMs(stageStart);
+
+    stageStart = Clock::now();
+    mEmissiveAliasTable = AliasTable(flux);
+    totalEmissivePower = static_cast<float>(mEmissiveAliasTable.getWeightSum());
+    if (totalEmissivePower > 0.f)
+    {
+        // pdf_area = P(pick triangle) / area: the per-triangle density both NEE and evalLightPdf use.
+        pool.parallelFor(
+            triangleTotal,
+            kTriangleBlockSize,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    EmissiveTriangle& et = emissiveTriangles[i];
+                    float p = mEmissiveAliasTable.getProbability(static_cast<uint32_t>(i));
+                    et.pdf = (et.area > 0.f && p > 0.f) ? p / et.area : 0.f;
+                }
+            },
+            parallel
+        );
+    }
+    const double aliasMs = elapsedMs(stageStart);
+
+    stageStart = Clock::now();
+    mLightBVH.build(lightBounds);
+    const double bvhMs = elapsedMs(stageStart);
+
+    if (triangleTotal > 0)
+        LOG_INFO(
+            "Emissive lights: {} triangles over {} instances | count+scan {:.2f} ms, fill {:.2f} ms, alias table {:.2f} ms, "
+            "light BVH {:.2f} ms ({} nodes)",
+            triangleTotal,
+            emissiveInstances.size(),
+            scanMs,
+            fillMs,
+            aliasMs,
+            bvhMs,
+            mLightBVH.getNodes().size()
+        );
+}
+
+bool Scene::buildBottomLevelAccelStructs()
+{
+    auto nvrhiDevice = mpDevice->getDevice();
+    auto commandList = mpDevice->getCommandList();
+    AccelStructStats& stats = mAccelStructStats;
+
+    ComPtr<ID3D12Device5> pDevice5;
+    if (FAILED(mpDevice->getD3D12Device().As(&pDevice5)))
+    {
+        LOG_ERROR("D3D12 device does not support ray tracing (ID3D12Device5 unavailable)");
+        return false;
+    }
+
+    const auto buildFlags = nvrhi::rt::AccelStructBuildFlags::AllowCompaction | nvrhi::rt::AccelStructBuildFlags::PreferFastTrace;
+    const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+    // Each BLAS references only its own index slice of the shared vertex/index buffers.
+    // PrimitiveIndex() in closest-hit is therefore mesh-local (0 .. triangleCount-1 per BLAS).
+    mBlases.clear();
+    mBlases.reserve(meshes.size());
+    std::vector<nvrhi::rt::GeometryDesc> geomDescs(meshes.size());
+    std::vector<uint64_t> scratchBytes(meshes.size());
+    std::vector<uint64_t> resultBytes(meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        const MeshDesc& md = meshes[i];
+        auto triangles = nvrhi::rt::GeometryTriangles()
+                             .setVertexBuffer(mVertexBuffer)
+                             .setVertexFormat(nvrhi::Format::RGB32_FLOAT)
+                             .setVertexCount(vertexCount)
+                             .setVertexStride(sizeof(Vertex))
+                             .setIndexBuffer(mIndexBuffer)
+                             .setIndexFormat(nvrhi::Format::R32_UINT)
+                             .setIndexCount(md.indexCount)
+                             .setIndexOffset(static_cast<uint64_t>(md.indexOffset) * sizeof(uint32_t));
+        geomDescs[i] = nvrhi::rt::GeometryDesc().setTriangles(triangles).setFlags(nvrhi::rt::GeometryFlags::Opaque);
+
+        auto prebuild = queryBlasPrebuildInfo(pDevice5.Get(), md, vertexCount);
+        scratchBytes[i] = prebuild.ScratchDataSizeInBytes;
+        resultBytes[i] = prebuild.ResultDataMaxSizeInBytes;
+
+        auto blasDesc = nvrhi::rt::AccelStructDesc().setDebugName("BLAS_" + std::to_string(i)).setIsTopLevel(false).setBuildFlags(buildFlags);
+        blasDesc.addBottomLevelGeometry(geomDescs[i]);
+        auto blas = nvrhiDevice->createAccelStruct(blasDesc);
+        if (!blas)
+        {
+            LOG_ERROR("Failed to create BLAS for mesh {}", i);
+            return false;
+        }
+        mBlases.push_back(blas);
+        stats.blasBytesBeforeCompaction += getAccelStructBytes(blas, resultBytes[i]);
+    }
+    stats.blasCount = static_cast<uint32_t>(mBlases.size());
+
+    // Record builds in batches bounded by kBlasBatchScratchBudget. Builds inside a batch have no
+    // barriers between them and overlap on the GPU; nvrhi sub-allocates their scratch from its
+    // pooled per-command-list chunks, which are recycled once the previous batch retires.
+    Clock::time_point stageStart = Clock::now();
+    size_t next = 0;
+    while (next < meshes.size())
+    {
+        uint64_t batchScratch = 0;
+        commandList->open();
+        do
+        {
+            batchScratch += scratchBytes[next];
+            commandList->buildBottomLevelAccelStruct(mBlases[next], &geomDescs[next], 1, buildFlags);
+            next++;
+        } while (next < meshes.size() && batchScratch + scratchBytes[next] <= kBlasBatchScratchBudget);
+        commandList->close();
+        nvrhiDevice->executeCommandList(commandList);
+
+        stats.blasBatchCount++;
+        stats.peakBatchScratchBytes = std::max(stats.peakBatchScratchBytes, batchScratch);
+    }
+    // Compacted sizes are read back on the CPU, so the builds must have retired first.
+    nvrhiDevice->waitForIdle();
+    stats.blasBuildMs = elapsedMs(stageStart);
+
+    // Copy every BLAS into a buffer of its compacted size; nvrhi swaps the handle's storage and
+    // releases the original once the copy retires, so instance descs below see the compacted BLAS.
+    stageStart = Clock::now();
+    commandList->open();
+    commandList->compactBottomLevelAccelStructs();
+    commandList->close();
+    nvrhiDevice->executeCommandList(commandList);
+    nvrhiDevice->waitForIdle();
+    nvrhiDevice->runGarbageCollection();
+    stats.compactionMs = elapsedMs(stageStart);
+
+    for (size_t i = 0; i < mBlases.size(); i++)
+    {
+        if (mBlases[i]->isCompacted())
+            stats.compactedBlasCount++;
+        stats.blasBytesAfterCompaction += getAccelStructBytes(mBlases[i], resultBytes[i]);
+    }
+    return true;
 }
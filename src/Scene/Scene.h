@@ -8,6 +8,8 @@
 #include "Scene/Material/Material.h"
 #include "Scene/Material/TextureManager.h"
 #include "Core/Pointer.h"
+#include "Scene/Lights/LightBVH.h"
+#include "Utils/Sampling/AliasTable.h"
 
 struct Vertex
 {
@@ -16,6 +18,9 @@ struct Vertex
     float normal[3];
 };
 
+static const uint32_t kInvalidMeshId = 0xFFFFFFFF;
+static const uint32_t kInvalidEmissiveOffset = 0xFFFFFFFF;
+
 struct MeshDesc
 {
     uint32_t indexOffset;
@@ -37,17 +42,37 @@ struct InstanceData
     glm::vec4 row2;
     uint32_t meshID;
     uint32_t materialID;
-    uint32_t _padding0;
+    uint32_t emissiveOffset; // First EmissiveTriangle of this instance, or kInvalidEmissiveOffset
     uint32_t _padding1;
 };
 static_assert(sizeof(InstanceData) == 64, "InstanceData must be 64 B to match Slang row-major float3x4 + 16-byte tail");
 
+// Emissive instances contribute every triangle, in mesh order, so a hit finds its entry at
+// InstanceData::emissiveOffset + PrimitiveIndex().
 struct EmissiveTriangle
 {
     uint32_t instanceID;
     uint32_t localTriangleIndex;
     float area;
-    float cdfUpper;
+    float pdf; // Area-measure pdf of the flux-weighted light sampler: (flux / totalFlux) / area
+};
+static_assert(sizeof(AliasEntry) == 8, "AliasEntry must match EmissiveAlias in Scene.slang");
+
+// Per-stage cost of the last buildAccelStructs() call; times include GPU completion.
+// Every mesh keeps its own BLAS, since the hit shaders take PrimitiveIndex() as mesh-local; small meshes
+// are grouped into shared build batches (and scratch budgets), not merged into shared BLASes.
+struct AccelStructStats
+{
+    double uploadMs = 0.0;
+    double blasBuildMs = 0.0;
+    double compactionMs = 0.0;
+    double tlasMs = 0.0;
+    uint32_t blasCount = 0;      // One per mesh
+    uint32_t blasBatchCount = 0; // Command lists the BLAS builds were grouped into
+    uint32_t compactedBlasCount = 0;
+    uint64_t peakBatchScratchBytes = 0;
+    uint64_t blasBytesBeforeCompaction = 0;
+    uint64_t blasBytesAfterCompaction = 0;
 };
 
 class Scene
@@ -60,16 +85,31 @@ public:
     std::vector<Material> materials;
     std::vector<EmissiveTriangle> emissiveTriangles;
     float totalEmissiveArea = 0.f;
+    float totalEmissivePower = 0.f; // Sum of triangle flux weights (area x luminance of average emission)
     ref<Camera> camera;
     std::string name;
+    std::vector<std::string> sourceFiles; // Files the import read besides the scene file (textures); the scene cache checks them
 
     Scene(ref<Device> pDevice);
 
+    // Register a mesh over an index range; returns kInvalidMeshId for empty ranges
+    uint32_t addMesh(uint32_t indexOffset, uint32_t indexCount);
+
+    // Place an existing mesh; many instances may share one mesh (and its BLAS)
+    void addInstance(uint32_t meshID, uint32_t materialIndex, const glm::mat4& localToWorld = glm::mat4(1.0f));
+
     void addMeshInstance(uint32_t indexOffset, uint32_t indexCount, uint32_t materialIndex, const glm::mat4& localToWorld = glm::mat4(1.0f));
 
     void buildAccelStructs();
 
+    // Rebuild emissiveTriangles, the flux-weighted alias table and the light BVH as a count / scan / fill
+    // pipeline on the thread pool. parallel = false runs the same block schedule on the calling thread and
+    // produces bit-identical results. Called by buildAccelStructs; does no GPU work.
+    void collectEmissiveLights(bool parallel = true);
+    const std::vector<uint32_t>& getInstanceEmissiveOffsets() const { return mInstanceEmissiveOffsets; }
+
     nvrhi::rt::AccelStructHandle getTLAS() const { return mTlas; }
+    const AccelStructStats& getAccelStructStats() const { return mAccelStructStats; }
 
     // Get geometry buffers for shader access
     nvrhi::BufferHandle getVertexBuffer() const { return mVertexBuffer; }
@@ -78,11 +118,31 @@ public:
     nvrhi::BufferHandle getMeshBuffer() const { return mMeshBuffer; }
     nvrhi::BufferHandle getInstanceBuffer() const { return mInstanceBuffer; }
     nvrhi::BufferHandle getEmissiveTriangleBuffer() const { return mEmissiveTriangleBuffer; }
+    nvrhi::BufferHandle getEmissiveAliasBuffer() const { return mEmissiveAliasBuffer; }
+    const AliasTable& getEmissiveAliasTable() const { return mEmissiveAliasTable; }
+    nvrhi::BufferHandle getLightBVHNodeBuffer() const { return mLightBVHNodeBuffer; }
+    nvrhi::BufferHandle getLightBVHBitTrailBuffer() const { return mLightBVHBitTrailBuffer; }
+    const LightBVH& getLightBVH() const { return mLightBVH; }
     uint32_t getEmissiveTriangleCount() const { return static_cast<uint32_t>(emissiveTriangles.size()); }
     uint64_t getTriangleCount() const { return indices.size() / 3; }
 
     // Texture management
-    uint32_t loadTexture(const float* data, uint32_t width, uint32_t height, uint32_t channels, const std::string& debugName = "");
+    uint32_t loadTexture(
+        const uint8_t* data,
+        uint32_t width,
+        uint32_t height,
+        uint32_t channels,
+        TextureUsage usage,
+        const std::string& debugName = ""
+    );
+    uint32_t loadTexture(
+        const float* data,
+        uint32_t width,
+        uint32_t height,
+        uint32_t channels,
+        TextureUsage usage,
+        const std::string& debugName = ""
+    );
     nvrhi::TextureHandle getTexture(uint32_t textureId) const;
     const std::vector<nvrhi::TextureHandle>& getTextures() const;
     size_t getTextureCount() const;
@@ -92,6 +152,9 @@ public:
     ref<TextureManager> getTextureManager() const { return mTextureManager; }
 
 private:
+    // Batched BLAS builds followed by compaction; fills mBlases and the BLAS fields of mAccelStructStats
+    bool buildBottomLevelAccelStructs();
+
     ref<Device> mpDevice;
     ref<TextureManager> mTextureManager;
     nvrhi::BufferHandle mVertexBuffer;
@@ -100,6 +163,13 @@ private:
     nvrhi::BufferHandle mMeshBuffer;
     nvrhi::BufferHandle mInstanceBuffer;
     nvrhi::BufferHandle mEmissiveTriangleBuffer;
+    nvrhi::BufferHandle mEmissiveAliasBuffer;
+    AliasTable mEmissiveAliasTable;
+    std::vector<uint32_t> mInstanceEmissiveOffsets; // Per instance: first EmissiveTriangle or kInvalidEmissiveOffset
+    nvrhi::BufferHandle mLightBVHNodeBuffer;
+    nvrhi::BufferHandle mLightBVHBitTrailBuffer;
+    LightBVH mLightBVH;
     std::vector<nvrhi::rt::AccelStructHandle> mBlases;
     nvrhi::rt::AccelStructHandle mTlas;
+    AccelStructStats mAccelStructStats;
 };
@@ -1,74 +1,88 @@
 #include "ComputePass.h"
 #include "Core/Program/Program.h"
+#include "ShaderHotReload.h"
 
-ComputePass::ComputePass(ref<Device> pDevice, const std::string& shaderPath, const std::string& entryPoint) : Pass(pDevice)
+ComputePass::ComputePass(ref<Device> pDevice, const std::string& shaderPath, const std::string& entryPoint)
+    : Pass(pDevice), mShaderPath(std::string(PROJECT_DIR) + shaderPath), mEntryPoint(entryPoint)
 {
-    auto pNvrhiDevice = pDevice->getDevice();
-    std::unordered_map<std::string, nvrhi::ShaderType> entryPoints;
-    entryPoints[entryPoint] = nvrhi::ShaderType::Compute;
-
-    std::string shaderVersion = getLatestComputeShaderVersion();
-    Program program(pNvrhiDevice, std::string(PROJECT_DIR) + shaderPath, entryPoints, shaderVersion);
+    mProfile = getLatestComputeShaderVersion();
+    Program program(pDevice->getDevice(), mShaderPath, {{mEntryPoint, nvrhi::ShaderType::Compute}}, mProfile);
     mShader = program.getShader(entryPoint);
 
     mpBindingSetManager = make_ref<BindingSetManager>(pDevice, program.getReflectionInfo());
-    auto pProgramLayout = program.getProgramLayout();
-    if (pProgramLayout && pProgramLayout->getEntryPointCount() > 0)
-    {
-        auto pEntryPointReflection = pProgramLayout->getEntryPointByIndex(0);
-        if (pEntryPointReflection)
-        {
-            SlangUInt workGroupSize[3] = {1, 1, 1};
-            pEntryPointReflection->getComputeThreadGroupSize(3, workGroupSize);
-            mWorkGroupSizeX = static_cast<uint32_t>(workGroupSize[0]);
-            mWorkGroupSizeY = static_cast<uint32_t>(workGroupSize[1]);
-            mWorkGroupSizeZ = static_cast<uint32_t>(workGroupSize[2]);
-        }
-    }
+    mBindingLayouts = mpBindingSetManager->getBindingLayouts();
+    const uint32_t* workGroupSize = program.getThreadGroupSize();
+    mWorkGroupSizeX = workGroupSize[0];
+    mWorkGroupSizeY = workGroupSize[1];
+    mWorkGroupSizeZ = workGroupSize[2];
+
+    mPipeline = createPipeline(mShader);
+    ShaderHotReload::get().watch(this, program.getDependencies());
+}
+
+ComputePass::~ComputePass()
+{
+    ShaderHotReload::get().unwatch(this);
+}
 
-    // Create compute pipeline
+nvrhi::ComputePipelineHandle ComputePass::createPipeline(nvrhi::ShaderHandle shader) const
+{
     nvrhi::ComputePipelineDesc pipelineDesc;
-    std::vector<nvrhi::BindingLayoutHandle> bindingLayouts = mpBindingSetManager->getBindingLayouts();
-    for (const auto& pLayout : bindingLayouts)
+    for (const auto& pLayout : mBindingLayouts)
         if (pLayout)
             pipelineDesc.addBindingLayout(pLayout);
 
-    pipelineDesc.setComputeShader(mShader);
-    mPipeline = pNvrhiDevice->createComputePipeline(pipelineDesc);
-    if (!mPipeline)
+    pipelineDesc.setComputeShader(shader);
+    nvrhi::ComputePipelineHandle pipeline = mpDevice->getDevice()->createComputePipeline(pipelineDesc);
+    if (!pipeline)
         LOG_ERROR_THROW("[ComputePass] Failed to create compute pipeline");
     LOG_DEBUG("[ComputePass] Compute pipeline created successfully");
+    return pipeline;
 }
 
-void ComputePass::dispatch(uint32_t width, uint32_t height, uint32_t depth)
+Pass::Reload ComputePass::recompile()
 {
-    auto pNvrhiDevice = mpDevice->getDevice();
-    auto pCommandList = mpDevice->getCommandList();
-    pCommandList->open();
+    Program program(mpDevice->getDevice(), mShaderPath, {{mEntryPoint, nvrhi::ShaderType::Compute}}, mProfile, {}, {}, false);
 
-    nvrhi::ComputeState state;
-    state.pipeline = mPipeline;
-    for (const auto& cbTex : mConstantBuffers)
-        if (cbTex.buffer && cbTex.pData && cbTex.sizeBytes > 0)
-            pCommandList->writeBuffer(cbTex.buffer, cbTex.pData, cbTex.sizeBytes);
-    std::vector<nvrhi::BindingSetHandle> bindingSets = mpBindingSetManager->getBindingSets();
-    for (const auto& pBindingSet : bindingSets)
-        if (pBindingSet)
-            state.addBindingSet(pBindingSet);
-    pCommandList->setComputeState(state);
-    pCommandList->dispatch(width, height, depth);
-    pCommandList->close();
-    pNvrhiDevice->executeCommandList(pCommandList);
+    Reload reload;
+    reload.name = mShaderPath;
+    reload.dependencies = program.getDependencies();
+    if (!mpBindingSetManager->isCompatible(program.getReflectionInfo()))
+    {
+        LOG_WARN("[ComputePass] Bindings of '{}' changed; restart to pick up the edit", mShaderPath);
+        return reload;
+    }
+
+    nvrhi::ShaderHandle shader = program.getShader(mEntryPoint);
+    nvrhi::ComputePipelineHandle pipeline = createPipeline(shader);
+    const uint32_t* workGroupSize = program.getThreadGroupSize();
+    reload.install = [this, shader, pipeline, x = workGroupSize[0], y = workGroupSize[1], z = workGroupSize[2]]()
+    {
+        mShader = shader;
+        mPipeline = pipeline;
+        mWorkGroupSizeX = x;
+        mWorkGroupSizeY = y;
+        mWorkGroupSizeZ = z;
+    };
+    return reload;
 }
 
-void ComputePass::execute(uint32_t width, uint32_t height, uint32_t depth)
+void ComputePass::record(nvrhi::ICommandList* pCommandList, uint32_t width, uint32_t height, uint32_t depth)
 {
     uint32_t threadGroupX = (width + mWorkGroupSizeX - 1) / mWorkGroupSizeX;
     uint32_t threadGroupY = (height + mWorkGroupSizeY - 1) / mWorkGroupSizeY;
     uint32_t threadGroupZ = (depth + mWorkGroupSizeZ - 1) / mWorkGroupSizeZ;
-
     LOG_TRACE("[ComputePass] Total threads: {}x{}x{}, Thread groups: {}x{}x{}", width, height, depth, threadGroupX, threadGroupY, threadGroupZ);
-    dispatch(threadGroupX, threadGroupY, threadGroupZ);
+
+    nvrhi::ComputeState state;
+    state.pipeline = mPipeline;
+    uploadConstantBuffers(pCommandList);
+    const std::vector<nvrhi::BindingSetHandle>& bindingSets = mpBindingSetManager->getBindingSets();
+    for (const auto& pBindingSet : bindingSets)
+        if (pBindingSet)
+            state.addBindingSet(pBindingSet);
+    pCommandList->setComputeState(state);
+    pCommandList->dispatch(threadGroupX, threadGroupY, threadGroupZ);
 }
 
 std::string ComputePass::getLatestComputeShaderVersion()
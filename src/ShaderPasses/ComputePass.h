@@ -5,14 +5,21 @@ class ComputePass : public Pass
 {
 public:
     ComputePass(ref<Device> pDevice, const std::string& shaderPath, const std::string& entryPoint);
+    ~ComputePass() override;
 
-    void execute(uint32_t width, uint32_t height, uint32_t depth) override;
+    Reload recompile() override;
+
+protected:
+    void record(nvrhi::ICommandList* pCommandList, uint32_t width, uint32_t height, uint32_t depth) override;
 
 private:
-    void dispatch(uint32_t width, uint32_t height, uint32_t depth);
+    nvrhi::ComputePipelineHandle createPipeline(nvrhi::ShaderHandle shader) const;
 
     std::string getLatestComputeShaderVersion();
 
+    std::string mShaderPath;
+    std::string mEntryPoint;
+    std::string mProfile;
     nvrhi::ShaderHandle mShader;
     nvrhi::ComputePipelineHandle mPipeline;
     uint32_t mWorkGroupSizeX = 1;
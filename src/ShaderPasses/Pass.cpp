@@ -0,0 +1,59 @@
+#include "Pass.h"
+#include "Utils/FrameStats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace
+{
+std::atomic<bool> sSkipUnchangedConstantBuffers{true};
+} // namespace
+
+void Pass::addConstantBuffer(const ref<ConstantBuffer>& pConstantBuffer)
+{
+    auto it = std::find_if(
+        mConstantBuffers.begin(),
+        mConstantBuffers.end(),
+        [&](const ref<ConstantBuffer>& pOther) { return pOther->buffer == pConstantBuffer->buffer; }
+    );
+    if (it != mConstantBuffers.end())
+        *it = pConstantBuffer;
+    else
+        mConstantBuffers.push_back(pConstantBuffer);
+}
+
+void Pass::execute(uint32_t width, uint32_t height, uint32_t depth)
+{
+    nvrhi::CommandListHandle pCommandList = mpDevice->getCommandList();
+    pCommandList->open();
+    record(pCommandList, width, height, depth);
+    pCommandList->close();
+    mpDevice->getDevice()->executeCommandList(pCommandList);
+    FrameStats::addCommandListSubmission();
+}
+
+void Pass::setSkipUnchangedConstantBuffers(bool enabled)
+{
+    sSkipUnchangedConstantBuffers = enabled;
+}
+
+void Pass::uploadConstantBuffers(nvrhi::ICommandList* pCommandList)
+{
+    for (const ref<ConstantBuffer>& pConstantBuffer : mConstantBuffers)
+    {
+        ConstantBuffer& cb = *pConstantBuffer;
+        if (!cb.buffer || !cb.pData || cb.sizeBytes == 0)
+            continue;
+
+        // The buffers are not volatile, so the GPU copy from the last upload is still valid
+        const uint8_t* pBytes = static_cast<const uint8_t*>(cb.pData);
+        if (sSkipUnchangedConstantBuffers && cb.uploaded.size() == cb.sizeBytes && std::memcmp(cb.uploaded.data(), pBytes, cb.sizeBytes) == 0)
+        {
+            FrameStats::addConstantBufferSkip();
+            continue;
+        }
+        pCommandList->writeBuffer(cb.buffer, pBytes, cb.sizeBytes);
+        cb.uploaded.assign(pBytes, pBytes + cb.sizeBytes);
+        FrameStats::addConstantBufferUpload(cb.sizeBytes);
+    }
+}
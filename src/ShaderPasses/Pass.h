@@ -2,52 +2,125 @@
 #include "Core/Device.h"
 #include "Core/Program/BindingSetManager.h"
 #include "Core/Pointer.h"
+#include "Core/RenderContext.h"
+#include "Utils/Logger.h"
+#include <functional>
+#include <string>
+#include <vector>
 
+// CPU data mirrored into a (non-volatile) constant buffer. Passes that share a buffer must share this
+// object too, so the record of what the GPU holds stays right whichever of them uploads.
 struct ConstantBuffer
 {
     nvrhi::BufferHandle buffer;
-    void* pData;
+    const void* pData;
     size_t sizeBytes;
+    std::vector<uint8_t> uploaded; // Contents at the last upload; empty before the first
 };
 
 class Pass
 {
 public:
     Pass(ref<Device> pDevice) : mpDevice(pDevice) {};
+    virtual ~Pass() = default;
 
-    virtual void execute(uint32_t width, uint32_t height, uint32_t depth) = 0;
+    // Record into the device's command list and submit it right away, for work outside a render graph
+    void execute(uint32_t width, uint32_t height, uint32_t depth);
 
-    void addConstantBuffer(nvrhi::BufferHandle buffer, void* pData, size_t sizeBytes) { mConstantBuffers.push_back({buffer, pData, sizeBytes}); }
+    // Record into the frame's command list; the owner of the context submits it
+    void execute(RenderContext& context, uint32_t width, uint32_t height, uint32_t depth)
+    {
+        record(context.getCommandList(), width, height, depth);
+    }
+
+    // Outcome of recompiling the pass's program for ShaderHotReload
+    struct Reload
+    {
+        std::string name;                      // Shader path, for logging
+        std::function<void()> install;         // Swaps the new pipeline in; empty if it cannot replace the current one
+        std::vector<std::string> dependencies; // Files the new program read
+    };
+
+    // Compile the program again, bypassing the ShaderCache, and build its pipeline without touching the live one.
+    // Runs on the reload thread, so it may only read state fixed at construction; throws if the program fails to compile.
+    virtual Reload recompile() = 0;
+
+    // Upload pData into buffer before each dispatch, skipped while the bytes match the last upload.
+    // Registering a buffer again replaces its entry.
+    void addConstantBuffer(nvrhi::BufferHandle buffer, const void* pData, size_t sizeBytes)
+    {
+        addConstantBuffer(make_ref<ConstantBuffer>(ConstantBuffer{buffer, pData, sizeBytes, {}}));
+    }
+    void addConstantBuffer(const ref<ConstantBuffer>& pConstantBuffer);
 
-    // Descriptor table support for bindless resources
-    void setDescriptorTable(const std::string& name, const std::vector<nvrhi::TextureHandle>& textures, nvrhi::TextureHandle defaultTexture)
+    // Disabled: every registered buffer is written on every dispatch, e.g. to measure what the skipping saves
+    static void setSkipUnchangedConstantBuffers(bool enabled);
+
+    // Descriptor table support for bindless resources; see BindingSetManager::setDescriptorTable for generation.
+    // Per-frame updates pass the table's slot; the name overload is for one-off bindings.
+    void setDescriptorTable(
+        uint32_t slot,
+        const std::vector<nvrhi::TextureHandle>& textures,
+        nvrhi::TextureHandle defaultTexture,
+        uint64_t generation = 0
+    )
+    {
+        if (mpBindingSetManager && slot != BindingSetManager::kInvalidSlot)
+            mpBindingSetManager->setDescriptorTable(slot, textures, defaultTexture, generation);
+    }
+    void setDescriptorTable(
+        const std::string& name,
+        const std::vector<nvrhi::TextureHandle>& textures,
+        nvrhi::TextureHandle defaultTexture,
+        uint64_t generation = 0
+    )
     {
         if (mpBindingSetManager)
-            mpBindingSetManager->setDescriptorTable(name, textures, defaultTexture);
+            mpBindingSetManager->setDescriptorTable(name, textures, defaultTexture, generation);
     }
 
-    // We can use pass["name"] = resourceHandle;
+    // Resolve a resource name once, e.g. in the render pass constructor; kInvalidSlot (with an error) if the shader has none
+    uint32_t getSlot(const std::string& name) const
+    {
+        uint32_t slot = mpBindingSetManager ? mpBindingSetManager->getSlot(name) : BindingSetManager::kInvalidSlot;
+        if (slot == BindingSetManager::kInvalidSlot)
+            LOG_ERROR("[Pass] Resource '{}' not found in layout", name);
+        return slot;
+    }
+
+    // We can use pass[slot] = resourceHandle; per frame, or pass["name"] = resourceHandle; for one-off bindings
     class BindingSlot
     {
     public:
-        BindingSlot(BindingSetManager* pMgr, const std::string& name) : mpManager(pMgr), mName(name) {}
+        BindingSlot(BindingSetManager* pMgr, uint32_t slot) : mpManager(pMgr), mSlot(slot) {}
 
         BindingSlot& operator=(const nvrhi::ResourceHandle& resource)
         {
-            if (mpManager)
-                mpManager->setResourceHandle(mName, resource);
+            if (mpManager && mSlot != BindingSetManager::kInvalidSlot)
+                mpManager->setResourceHandle(mSlot, resource);
             return *this;
         }
 
     private:
         BindingSetManager* mpManager;
-        std::string mName;
+        uint32_t mSlot;
     };
 
-    BindingSlot operator[](const std::string& name) { return BindingSlot(mpBindingSetManager.get(), name); }
+    BindingSlot operator[](uint32_t slot) { return BindingSlot(mpBindingSetManager.get(), slot); }
+    BindingSlot operator[](const std::string& name) { return BindingSlot(mpBindingSetManager.get(), getSlot(name)); }
+
+    BindingSetManager* getBindingSetManager() const { return mpBindingSetManager.get(); }
 
 protected:
+    // Record the constant buffer uploads, state and dispatch into an open command list
+    virtual void record(nvrhi::ICommandList* pCommandList, uint32_t width, uint32_t height, uint32_t depth) = 0;
+
+    // Record the writes of changed constant buffers; call right before the dispatch
+    void uploadConstantBuffers(nvrhi::ICommandList* pCommandList);
+
     ref<Device> mpDevice;
     ref<BindingSetManager> mpBindingSetManager; // Manages binding sets and layouts
-    std::vector<ConstantBuffer> mConstantBuffers;
+    // Copied from mpBindingSetManager at construction; recompile() builds pipelines from these off the render thread
+    std::vector<nvrhi::BindingLayoutHandle> mBindingLayouts;
+    std::vector<ref<ConstantBuffer>> mConstantBuffers;
 };
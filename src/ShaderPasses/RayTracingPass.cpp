@@ -1,29 +1,39 @@
 #include "RayTracingPass.h"
-#include "Core/Program/Program.h"
+#include "ShaderHotReload.h"
 #include "Utils/Logger.h"
 
 RayTracingPass::RayTracingPass(
     ref<Device> pDevice,
     const std::string& shaderPath,
     const std::vector<std::pair<std::string, nvrhi::ShaderType>>& entryPoints,
-    const std::vector<std::pair<std::string, std::string>>& defines
+    const std::vector<std::pair<std::string, std::string>>& defines,
+    const std::vector<LinkTimeConstant>& linkTimeConstants
 )
     : Pass(pDevice)
+    , mShaderPath(std::string(PROJECT_DIR) + shaderPath)
+    , mEntryPoints(entryPoints)
+    , mDefines(defines)
+    , mLinkTimeConstants(linkTimeConstants)
 {
-    auto pNvrhiDevice = pDevice->getDevice();
-    std::string shaderVersion = getLatestLibVersion();
-
-    std::unordered_map<std::string, nvrhi::ShaderType> entryPointMap;
-    for (const auto& [name, type] : entryPoints)
-        entryPointMap[name] = type;
-
-    Program program(pNvrhiDevice, std::string(PROJECT_DIR) + shaderPath, entryPointMap, shaderVersion, defines);
+    mProfile = getLatestLibVersion();
+    std::unordered_map<std::string, nvrhi::ShaderType> entryPointMap(mEntryPoints.begin(), mEntryPoints.end());
+    Program program(pDevice->getDevice(), mShaderPath, entryPointMap, mProfile, mDefines, mLinkTimeConstants);
     mpBindingSetManager = make_ref<BindingSetManager>(pDevice, program.getReflectionInfo());
+    mBindingLayouts = mpBindingSetManager->getBindingLayouts();
+    mPipelineState = createPipeline(program);
+    ShaderHotReload::get().watch(this, program.getDependencies());
+}
+
+RayTracingPass::~RayTracingPass()
+{
+    ShaderHotReload::get().unwatch(this);
+}
 
+RayTracingPass::PipelineState RayTracingPass::createPipeline(const Program& program) const
+{
     // Create ray tracing pipeline with proper configuration
     nvrhi::rt::PipelineDesc pipelineDesc;
-    std::vector<nvrhi::BindingLayoutHandle> bindingLayouts = mpBindingSetManager->getBindingLayouts();
-    for (const auto& pLayout : bindingLayouts)
+    for (const auto& pLayout : mBindingLayouts)
         if (pLayout)
             pipelineDesc.addBindingLayout(pLayout);
 
@@ -35,25 +45,24 @@ RayTracingPass::RayTracingPass(
     std::string rayGenName;
     std::string closestHitName;
     std::vector<std::string> missNames;
+    nvrhi::ShaderHandle closestHitShader;
 
-    for (const auto& [name, type] : entryPoints)
+    for (const auto& [name, type] : mEntryPoints)
     {
         nvrhi::ShaderHandle shader = program.getShader(name);
         if (type == nvrhi::ShaderType::RayGeneration)
         {
-            mRayGenShader = shader;
             rayGenName = name;
             pipelineDesc.addShader(nvrhi::rt::PipelineShaderDesc().setShader(shader).setExportName(name.c_str()));
         }
         else if (type == nvrhi::ShaderType::Miss)
         {
-            mMissShaders.push_back(shader);
             missNames.push_back(name);
             pipelineDesc.addShader(nvrhi::rt::PipelineShaderDesc().setShader(shader).setExportName(name.c_str()));
         }
         else if (type == nvrhi::ShaderType::ClosestHit)
         {
-            mClosestHitShader = shader;
+            closestHitShader = shader;
             closestHitName = name;
         }
     }
@@ -61,7 +70,7 @@ RayTracingPass::RayTracingPass(
     // Shadow rays reuse hit group 0 with RAY_FLAG_SKIP_CLOSEST_HIT_SHADER,
     // so no separate shadow hit group is needed.
     pipelineDesc.addHitGroup(
-        nvrhi::rt::PipelineHitGroupDesc().setClosestHitShader(mClosestHitShader).setExportName(closestHitName.c_str()).setIsProceduralPrimitive(false)
+        nvrhi::rt::PipelineHitGroupDesc().setClosestHitShader(closestHitShader).setExportName(closestHitName.c_str()).setIsProceduralPrimitive(false)
     );
 
     LOG_DEBUG(
@@ -69,47 +78,60 @@ RayTracingPass::RayTracingPass(
         pipelineDesc.maxPayloadSize,
         pipelineDesc.maxAttributeSize,
         pipelineDesc.maxRecursionDepth,
-        mMissShaders.size()
+        missNames.size()
     );
-    mPipeline = pNvrhiDevice->createRayTracingPipeline(pipelineDesc);
-    if (!mPipeline)
+    PipelineState state;
+    state.pipeline = mpDevice->getDevice()->createRayTracingPipeline(pipelineDesc);
+    if (!state.pipeline)
         LOG_ERROR_THROW("[RayTracingPass] Failed to create ray tracing pipeline");
     LOG_DEBUG("[RayTracingPass] Ray tracing pipeline created successfully");
 
     // Create shader table with matching export names
-    mShaderTable = mPipeline->createShaderTable();
-    mShaderTable->setRayGenerationShader(rayGenName.c_str());
+    state.shaderTable = state.pipeline->createShaderTable();
+    state.shaderTable->setRayGenerationShader(rayGenName.c_str());
     for (const auto& name : missNames)
-        mShaderTable->addMissShader(name.c_str());
-    mShaderTable->addHitGroup(closestHitName.c_str());
+        state.shaderTable->addMissShader(name.c_str());
+    state.shaderTable->addHitGroup(closestHitName.c_str());
+    return state;
 }
 
-void RayTracingPass::execute(uint32_t width, uint32_t height, uint32_t depth)
+Pass::Reload RayTracingPass::recompile()
+{
+    std::unordered_map<std::string, nvrhi::ShaderType> entryPointMap(mEntryPoints.begin(), mEntryPoints.end());
+    Program program(mpDevice->getDevice(), mShaderPath, entryPointMap, mProfile, mDefines, mLinkTimeConstants, false);
+
+    Reload reload;
+    reload.name = mShaderPath;
+    reload.dependencies = program.getDependencies();
+    if (!mpBindingSetManager->isCompatible(program.getReflectionInfo()))
+    {
+        LOG_WARN("[RayTracingPass] Bindings of '{}' changed; restart to pick up the edit", mShaderPath);
+        return reload;
+    }
+
+    PipelineState state = createPipeline(program);
+    reload.install = [this, state]() { mPipelineState = state; };
+    return reload;
+}
+
+void RayTracingPass::record(nvrhi::ICommandList* pCommandList, uint32_t width, uint32_t height, uint32_t depth)
 {
     nvrhi::rt::State rtState;
-    rtState.setShaderTable(mShaderTable);
-    std::vector<nvrhi::BindingSetHandle> bindingSets = mpBindingSetManager->getBindingSets();
+    rtState.setShaderTable(mPipelineState.shaderTable);
+    const std::vector<nvrhi::BindingSetHandle>& bindingSets = mpBindingSetManager->getBindingSets();
     for (const auto& pBindingSet : bindingSets)
         if (pBindingSet)
             rtState.addBindingSet(pBindingSet);
 
-    auto pCommandList = mpDevice->getCommandList();
-    auto pNvrhiDevice = mpDevice->getDevice();
-    pCommandList->open();
-
-    // Push the latest CPU-side constant buffer contents immediately before dispatch.
-    // This is how per-frame camera jitter reaches the shader without any explicit
-    // "camera upload" call in the main loop.
-    for (const auto& cbTex : mConstantBuffers)
-        if (cbTex.buffer && cbTex.pData && cbTex.sizeBytes > 0)
-            pCommandList->writeBuffer(cbTex.buffer, cbTex.pData, cbTex.sizeBytes);
+    // Push the latest CPU-side constant buffer contents immediately before dispatch; unchanged
+    // buffers are skipped. This is how per-frame camera jitter reaches the shader without any
+    // explicit "camera upload" call in the main loop.
+    uploadConstantBuffers(pCommandList);
 
     pCommandList->setRayTracingState(rtState);
     nvrhi::rt::DispatchRaysArguments args;
     args.setDimensions(width, height, depth);
     pCommandList->dispatchRays(args);
-    pCommandList->close();
-    pNvrhiDevice->executeCommandList(pCommandList);
 }
 
 std::string RayTracingPass::getLatestLibVersion()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Pass.h"
+#include "Core/Program/Program.h"
 #include <utility>
 #include <vector>
 
@@ -11,17 +12,32 @@ public:
         ref<Device> pDevice,
         const std::string& shaderPath,
         const std::vector<std::pair<std::string, nvrhi::ShaderType>>& entryPoints,
-        const std::vector<std::pair<std::string, std::string>>& defines = {}
+        const std::vector<std::pair<std::string, std::string>>& defines = {},
+        const std::vector<LinkTimeConstant>& linkTimeConstants = {}
     );
 
-    void execute(uint32_t width, uint32_t height, uint32_t depth) override;
+    ~RayTracingPass() override;
+
+    Reload recompile() override;
+
+protected:
+    void record(nvrhi::ICommandList* pCommandList, uint32_t width, uint32_t height, uint32_t depth) override;
 
 private:
+    // Everything a recompile replaces; the pipeline keeps its shaders alive
+    struct PipelineState
+    {
+        nvrhi::rt::PipelineHandle pipeline;
+        nvrhi::rt::ShaderTableHandle shaderTable;
+    };
+
     std::string getLatestLibVersion();
+    PipelineState createPipeline(const Program& program) const;
 
-    nvrhi::ShaderHandle mRayGenShader;
-    std::vector<nvrhi::ShaderHandle> mMissShaders;
-    nvrhi::ShaderHandle mClosestHitShader;
-    nvrhi::rt::ShaderTableHandle mShaderTable;
-    nvrhi::rt::PipelineHandle mPipeline;
+    std::string mShaderPath;
+    std::vector<std::pair<std::string, nvrhi::ShaderType>> mEntryPoints;
+    std::vector<std::pair<std::string, std::string>> mDefines;
+    std::vector<LinkTimeConstant> mLinkTimeConstants;
+    std::string mProfile;
+    PipelineState mPipelineState;
 };
@@ -0,0 +1,209 @@
+#include "ShaderHotReload.h"
+#include "Pass.h"
+#include "Core/Program/ShaderCompiler.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+// Slang reports dependency paths as it resolved them; compare both sides in one spelling
+std::string canonicalPath(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    return (ec ? path.lexically_normal() : canonical).generic_string();
+}
+
+bool isShaderSource(const std::filesystem::path& path)
+{
+    const std::filesystem::path extension = path.extension();
+    return extension == ".slang" || extension == ".slangh";
+}
+} // namespace
+
+ShaderHotReload& ShaderHotReload::get()
+{
+    static ShaderHotReload sHotReload;
+    return sHotReload;
+}
+
+ShaderHotReload::~ShaderHotReload()
+{
+    stop();
+}
+
+void ShaderHotReload::start(const std::string& directory, std::chrono::milliseconds interval)
+{
+    stop();
+    mStopRequested = false;
+    mThread = std::thread(
+        [this, directory, interval]()
+        {
+            std::unique_lock<std::mutex> lock(mThreadMutex);
+            while (!mStopRequested)
+            {
+                lock.unlock();
+                poll(directory);
+                lock.lock();
+                mStopCondition.wait_for(lock, interval, [this]() { return mStopRequested; });
+            }
+        }
+    );
+    LOG_INFO("[ShaderHotReload] Watching '{}' every {} ms", directory, interval.count());
+}
+
+void ShaderHotReload::stop()
+{
+    if (!mThread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mThreadMutex);
+        mStopRequested = true;
+    }
+    mStopCondition.notify_all();
+    mThread.join();
+}
+
+uint32_t ShaderHotReload::poll(const std::string& directory)
+{
+    std::vector<std::string> changed;
+    {
+        std::lock_guard<std::mutex> lock(mScanMutex);
+        const bool isFirstScan = directory != mScannedDirectory;
+        if (isFirstScan)
+        {
+            mWriteTimes.clear();
+            mScannedDirectory = directory;
+        }
+
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(directory, ec); !ec && it != std::filesystem::recursive_directory_iterator();
+             it.increment(ec))
+        {
+            if (!it->is_regular_file(ec) || !isShaderSource(it->path()))
+                continue;
+            const std::filesystem::file_time_type writeTime = it->last_write_time(ec);
+            if (ec)
+                continue;
+
+            // Files created after the first scan count as changed: an import that failed to resolve may resolve now
+            std::string path = canonicalPath(it->path());
+            auto [entry, isNew] = mWriteTimes.try_emplace(path, writeTime);
+            if (isNew ? !isFirstScan : entry->second != writeTime)
+            {
+                entry->second = writeTime;
+                changed.push_back(std::move(path));
+            }
+        }
+    }
+    if (changed.empty())
+        return 0;
+
+    for (const std::string& path : changed)
+        LOG_INFO("[ShaderHotReload] '{}' changed", path);
+
+    // Sessions cache every module they loaded as IR; start over so the edit is compiled
+    ShaderCompiler::get().resetSessions();
+
+    // Compile without mPassMutex so passes created meanwhile can still watch()
+    std::vector<Pass*> affected;
+    {
+        std::lock_guard<std::mutex> lock(mPassMutex);
+        for (const auto& [pPass, dependencies] : mPasses)
+        {
+            const bool isAffected = std::any_of(
+                changed.begin(),
+                changed.end(),
+                [&](const std::string& path) { return std::find(dependencies.begin(), dependencies.end(), path) != dependencies.end(); }
+            );
+            if (isAffected)
+                affected.push_back(pPass);
+        }
+    }
+
+    uint32_t recompiledCount = 0;
+    for (Pass* pPass : affected)
+    {
+        // unwatch() takes mCompileMutex after erasing the pass, so a pass still watched here outlives the compile
+        std::lock_guard<std::mutex> compileLock(mCompileMutex);
+        {
+            std::lock_guard<std::mutex> lock(mPassMutex);
+            if (mPasses.find(pPass) == mPasses.end())
+                continue;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            Pass::Reload reload = pPass->recompile();
+            if (!reload.install)
+                continue;
+
+            std::vector<std::string> dependencies;
+            dependencies.reserve(reload.dependencies.size());
+            for (const std::string& path : reload.dependencies)
+                dependencies.push_back(canonicalPath(path));
+            {
+                // Unwatched while compiling: its destructor is waiting on mCompileMutex, so drop the pipeline
+                std::lock_guard<std::mutex> lock(mPassMutex);
+                auto it = mPasses.find(pPass);
+                if (it == mPasses.end())
+                    continue;
+                it->second = std::move(dependencies);
+            }
+            {
+                std::lock_guard<std::mutex> pendingLock(mPendingMutex);
+                mPending.emplace_back(pPass, std::move(reload.install));
+            }
+            recompiledCount++;
+            LOG_INFO(
+                "[ShaderHotReload] Recompiled {} in {:.0f} ms",
+                reload.name,
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+            );
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("[ShaderHotReload] Recompile failed, keeping the previous pipeline: {}", e.what());
+        }
+    }
+    return recompiledCount;
+}
+
+uint32_t ShaderHotReload::applyPendingReloads()
+{
+    std::vector<std::pair<Pass*, std::function<void()>>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mPendingMutex);
+        pending.swap(mPending);
+    }
+    for (auto& [pPass, install] : pending)
+        install();
+    return static_cast<uint32_t>(pending.size());
+}
+
+void ShaderHotReload::watch(Pass* pPass, const std::vector<std::string>& dependencies)
+{
+    std::vector<std::string> paths;
+    paths.reserve(dependencies.size());
+    for (const std::string& path : dependencies)
+        paths.push_back(canonicalPath(path));
+
+    std::lock_guard<std::mutex> lock(mPassMutex);
+    mPasses[pPass] = std::move(paths);
+}
+
+void ShaderHotReload::unwatch(Pass* pPass)
+{
+    {
+        std::lock_guard<std::mutex> lock(mPassMutex);
+        mPasses.erase(pPass);
+    }
+    // Wait out a recompile that picked the pass up before it was erased
+    std::lock_guard<std::mutex> compileLock(mCompileMutex);
+    std::lock_guard<std::mutex> lock(mPendingMutex);
+    mPending.erase(
+        std::remove_if(mPending.begin(), mPending.end(), [&](const auto& entry) { return entry.first == pPass; }), mPending.end()
+    );
+}
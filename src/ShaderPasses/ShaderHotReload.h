@@ -0,0 +1,70 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Pass;
+
+/*
+    Live shader reload. A background thread polls the .slang/.slangh files under a directory; when one
+    changes, every pass whose program read that file is compiled again on that thread. The new pipeline
+    is installed by applyPendingReloads() between frames, so a frame never sees a half-swapped pass.
+    A failed compile keeps the previous pipeline, as does one whose bindings differ from the pass's
+    BindingSetManager (render passes cache binding slots); the latter still needs a restart.
+*/
+class ShaderHotReload
+{
+public:
+    static ShaderHotReload& get();
+
+    ShaderHotReload(const ShaderHotReload&) = delete;
+    ShaderHotReload& operator=(const ShaderHotReload&) = delete;
+
+    // Poll directory on the reload thread; restarts the thread if it is already running
+    void start(const std::string& directory = PROJECT_SRC_DIR, std::chrono::milliseconds interval = std::chrono::milliseconds(250));
+    void stop();
+
+    /*
+        Scan directory once and recompile, on the calling thread, the passes that read a file changed since the last scan
+        \return Number of passes with a new pipeline waiting for applyPendingReloads(); the first scan of a directory only records it
+    */
+    uint32_t poll(const std::string& directory);
+
+    // Install recompiled pipelines; call on the render thread between frames. Returns the number of passes swapped.
+    uint32_t applyPendingReloads();
+
+    // Called by ComputePass and RayTracingPass; unwatch() waits for a compile of the pass that is in flight
+    void watch(Pass* pPass, const std::vector<std::string>& dependencies);
+    void unwatch(Pass* pPass);
+
+private:
+    ShaderHotReload() = default;
+    ~ShaderHotReload();
+
+    // Held only to read or update mPasses; a compile never holds it, so watch() does not wait on Slang
+    std::mutex mPassMutex;
+    std::unordered_map<Pass*, std::vector<std::string>> mPasses; // Canonical paths of each pass's dependencies
+
+    // Held while compiling one pass; unwatch() takes it, so a pass is never destroyed under a recompile
+    std::mutex mCompileMutex;
+
+    std::mutex mPendingMutex;
+    std::vector<std::pair<Pass*, std::function<void()>>> mPending;
+
+    std::mutex mScanMutex;
+    std::unordered_map<std::string, std::filesystem::file_time_type> mWriteTimes;
+    std::string mScannedDirectory;
+
+    std::mutex mThreadMutex;
+    std::condition_variable mStopCondition;
+    bool mStopRequested = false;
+    std::thread mThread;
+};
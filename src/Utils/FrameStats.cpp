@@ -0,0 +1,42 @@
+#include "FrameStats.h"
+#include <atomic>
+
+namespace
+{
+std::atomic<uint64_t> sConstantBufferUploadBytes{0};
+std::atomic<uint32_t> sConstantBufferUploads{0};
+std::atomic<uint32_t> sConstantBufferSkips{0};
+std::atomic<uint32_t> sCommandListSubmissions{0};
+} // namespace
+
+namespace FrameStats
+{
+void addConstantBufferUpload(size_t sizeBytes)
+{
+    sConstantBufferUploadBytes += sizeBytes;
+    sConstantBufferUploads++;
+}
+
+void addConstantBufferSkip()
+{
+    sConstantBufferSkips++;
+}
+
+void addCommandListSubmission()
+{
+    sCommandListSubmissions++;
+}
+
+Counters get()
+{
+    return {sConstantBufferUploadBytes.load(), sConstantBufferUploads.load(), sConstantBufferSkips.load(), sCommandListSubmissions.load()};
+}
+
+void reset()
+{
+    sConstantBufferUploadBytes = 0;
+    sConstantBufferUploads = 0;
+    sConstantBufferSkips = 0;
+    sCommandListSubmissions = 0;
+}
+} // namespace FrameStats
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*
+    Counters of CPU-to-GPU traffic issued while recording a frame. The render loop resets them at the
+    start of each frame and the GUI shows the last one; benchmarks read them around a run of frames.
+*/
+namespace FrameStats
+{
+struct Counters
+{
+    uint64_t constantBufferUploadBytes = 0;
+    uint32_t constantBufferUploads = 0;
+    uint32_t constantBufferSkips = 0; // Registered buffers whose data matched the last upload
+    uint32_t commandListSubmissions = 0;
+};
+
+void addConstantBufferUpload(size_t sizeBytes);
+void addConstantBufferSkip();
+void addCommandListSubmission();
+
+// Totals since the last reset
+Counters get();
+void reset();
+} // namespace FrameStats
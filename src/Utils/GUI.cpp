@@ -6,6 +6,7 @@
 #include "Theme.h"
 #include "Widgets.h"
 #include "ExrUtils.h"
+#include "FrameStats.h"
 #include "Logger.h"
 #include "Core/Device.h"
 #include "Core/Window.h"
@@ -220,7 +221,7 @@ void GUIManager::renderMainLayout(ref<Scene> scene, RenderGraphEditor* pRenderGr
     const float headerHeight = Widgets::headerHeight();
     const uint64_t sceneTris = scene ? scene->getTriangleCount() : 0ull;
     const uint64_t gpuMemMB = mpDevice ? mpDevice->getVideoMemoryUsageMB() : 0ull;
-    Widgets::headerStrip({io.DeltaTime, io.Framerate, sceneTris, gpuMemMB});
+    Widgets::headerStrip({io.DeltaTime, io.Framerate, sceneTris, gpuMemMB, FrameStats::get().commandListSubmissions});
 
     // Content = TopRow + hsplitter + Editor. Each child consumes `size + ItemSpacing.y`
     // of vertical cursor, and the trailing ItemSpacing still advances after the last
@@ -377,6 +378,9 @@ uint2 GUIManager::renderRenderingPanel(ImTextureID textureId, uint32_t cameraWid
             ImGui::SameLine();
             ImGui::Text("  frame %u", frameCount);
         }
+        const FrameStats::Counters frameStats = FrameStats::get();
+        ImGui::SameLine();
+        ImGui::Text("  cb upload %llu B", static_cast<unsigned long long>(frameStats.constantBufferUploadBytes));
         ImGui::PopStyleColor();
     }
 
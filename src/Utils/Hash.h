@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+    Fast non-cryptographic hashing for cache keys and content identity.
+    Consumes 8 bytes per step; results are only meaningful on the machine that produced them.
+*/
+namespace Hash
+{
+inline constexpr uint64_t kGoldenRatio = 0x9e3779b97f4a7c15ull;
+
+// Finalizer from MurmurHash3 — full avalanche on a single 64-bit word.
+inline uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+inline uint64_t hash64(const void* pData, size_t sizeBytes, uint64_t seed = 0)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(pData);
+    uint64_t h = seed ^ (sizeBytes * kGoldenRatio);
+
+    size_t i = 0;
+    for (; i + 8 <= sizeBytes; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        h = (h ^ mix64(word)) * kGoldenRatio;
+        h = (h << 31) | (h >> 33);
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, p + i, sizeBytes - i);
+    h ^= mix64(tail ^ kGoldenRatio);
+    return mix64(h);
+}
+
+inline uint64_t combine(uint64_t seed, uint64_t value)
+{
+    return mix64(seed ^ (value + kGoldenRatio + (seed << 6) + (seed >> 2)));
+}
+
+// 128-bit content identity, for keys where a 64-bit collision would silently alias data (e.g. texture payloads)
+struct Hash128
+{
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Hash128& other) const { return low == other.low && high == other.high; }
+    bool operator!=(const Hash128& other) const { return !(*this == other); }
+};
+
+struct Hash128Hasher
+{
+    size_t operator()(const Hash128& h) const { return static_cast<size_t>(h.low); }
+};
+
+// Two lanes with different multipliers, 16 bytes per step, so the same pass produces both halves.
+inline Hash128 hash128(const void* pData, size_t sizeBytes, uint64_t seed = 0)
+{
+    constexpr uint64_t kLaneMultiplier = 0xc2b2ae3d27d4eb4full;
+    const uint8_t* p = static_cast<const uint8_t*>(pData);
+    uint64_t h1 = seed ^ (sizeBytes * kGoldenRatio);
+    uint64_t h2 = mix64(seed + kGoldenRatio) ^ sizeBytes;
+
+    size_t i = 0;
+    for (; i + 16 <= sizeBytes; i += 16)
+    {
+        uint64_t words[2];
+        std::memcpy(words, p + i, 16);
+        h1 = (h1 ^ mix64(words[0])) * kGoldenRatio;
+        h1 = (h1 << 31) | (h1 >> 33);
+        h2 = (h2 ^ mix64(words[1])) * kLaneMultiplier;
+        h2 = (h2 << 29) | (h2 >> 35);
+    }
+
+    uint64_t tail[2] = {0, 0};
+    std::memcpy(tail, p + i, sizeBytes - i);
+    h1 ^= mix64(tail[0] ^ kGoldenRatio);
+    h2 ^= mix64(tail[1] ^ kLaneMultiplier);
+
+    Hash128 result;
+    result.low = mix64(h1 + h2);
+    result.high = mix64(h2 ^ result.low);
+    return result;
+}
+} // namespace Hash
@@ -1,32 +1,24 @@
 #include "Core/Device.h"
+#include "Utils/FrameStats.h"
 #include "Utils/Logger.h"
 #include "Utils/ResourceIO.h"
+#include <algorithm>
 
 namespace
 {
-uint32_t getChannelCount(nvrhi::Format format)
+// Bytes per row of texels, or per row of blocks for block-compressed formats; 0 for unsupported formats
+size_t computeRowSize(nvrhi::Format format, uint32_t width)
 {
-    switch (format)
-    {
-    case nvrhi::Format::R32_FLOAT:
-    case nvrhi::Format::R16_FLOAT:
-        return 1;
-    case nvrhi::Format::RG32_FLOAT:
-    case nvrhi::Format::RG16_FLOAT:
-        return 2;
-    case nvrhi::Format::RGB32_FLOAT:
-        return 3;
-    case nvrhi::Format::RGBA32_FLOAT:
-    case nvrhi::Format::RGBA16_FLOAT:
-        return 4;
-    default:
+    const nvrhi::FormatInfo& info = nvrhi::getFormatInfo(format);
+    if (info.bytesPerBlock == 0 || info.blockSize == 0)
         return 0;
-    }
+    return static_cast<size_t>((width + info.blockSize - 1) / info.blockSize) * info.bytesPerBlock;
 }
 
-size_t computeRowSize(const nvrhi::TextureDesc& desc, uint32_t channelCount)
+uint32_t computeRowCount(nvrhi::Format format, uint32_t height)
 {
-    return static_cast<size_t>(desc.width) * channelCount * sizeof(float);
+    const uint32_t blockSize = nvrhi::getFormatInfo(format).blockSize;
+    return (height + blockSize - 1) / blockSize;
 }
 } // namespace
 
@@ -44,6 +36,7 @@ bool uploadBuffer(ref<Device> device, nvrhi::BufferHandle buffer, const void* pD
     commandList->writeBuffer(buffer, pData, sizeBytes);
     commandList->close();
     nvrhiDevice->executeCommandList(commandList);
+    FrameStats::addCommandListSubmission();
     return true;
 }
 
@@ -56,15 +49,15 @@ bool uploadTexture(ref<Device> device, nvrhi::TextureHandle texture, const void*
     auto commandList = device->getCommandList();
 
     const auto& desc = texture->getDesc();
-    uint32_t channelCount = getChannelCount(desc.format);
-    if (channelCount == 0)
+    if (computeRowSize(desc.format, desc.width) == 0)
     {
         LOG_ERROR("uploadTexture unsupported format: {}", static_cast<int>(desc.format));
         return false;
     }
 
-    const size_t rowSizeBytes = computeRowSize(desc, channelCount);
-    const size_t requiredSize = rowSizeBytes * desc.height;
+    size_t requiredSize = 0;
+    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip)
+        requiredSize += computeRowSize(desc.format, std::max(desc.width >> mip, 1u)) * computeRowCount(desc.format, std::max(desc.height >> mip, 1u));
     if (sizeBytes < requiredSize)
     {
         LOG_ERROR("uploadTexture insufficient data: required {} bytes, got {} bytes", requiredSize, sizeBytes);
@@ -78,30 +71,43 @@ bool uploadTexture(ref<Device> device, nvrhi::TextureHandle texture, const void*
         return false;
     }
 
-    nvrhi::TextureSlice slice;
-    size_t mappedRowPitch = 0;
-    void* mappedData = nvrhiDevice->mapStagingTexture(stagingTexture, slice, nvrhi::CpuAccessMode::Write, &mappedRowPitch);
-    if (!mappedData)
-    {
-        LOG_ERROR("Failed to map staging texture for upload");
-        return false;
-    }
-
-    const size_t effectiveSrcRowPitch = srcRowPitchBytes != 0 ? srcRowPitchBytes : rowSizeBytes;
+    // Levels follow each other in pData; the explicit source pitch only applies to the top level
     const uint8_t* src = static_cast<const uint8_t*>(pData);
-    for (uint32_t row = 0; row < desc.height; ++row)
+    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip)
     {
-        const auto* srcRow = src + row * effectiveSrcRowPitch;
-        auto* dstRow = static_cast<uint8_t*>(mappedData) + row * mappedRowPitch;
-        std::memcpy(dstRow, srcRow, rowSizeBytes);
+        const size_t rowSizeBytes = computeRowSize(desc.format, std::max(desc.width >> mip, 1u));
+        const uint32_t rowCount = computeRowCount(desc.format, std::max(desc.height >> mip, 1u));
+
+        nvrhi::TextureSlice slice = nvrhi::TextureSlice().setMipLevel(mip);
+        size_t mappedRowPitch = 0;
+        void* mappedData = nvrhiDevice->mapStagingTexture(stagingTexture, slice, nvrhi::CpuAccessMode::Write, &mappedRowPitch);
+        if (!mappedData)
+        {
+            LOG_ERROR("Failed to map staging texture for upload");
+            return false;
+        }
+
+        const size_t effectiveSrcRowPitch = mip == 0 && srcRowPitchBytes != 0 ? srcRowPitchBytes : rowSizeBytes;
+        for (uint32_t row = 0; row < rowCount; ++row)
+        {
+            const auto* srcRow = src + row * effectiveSrcRowPitch;
+            auto* dstRow = static_cast<uint8_t*>(mappedData) + row * mappedRowPitch;
+            std::memcpy(dstRow, srcRow, rowSizeBytes);
+        }
+        src += effectiveSrcRowPitch * rowCount;
+
+        nvrhiDevice->unmapStagingTexture(stagingTexture);
     }
 
-    nvrhiDevice->unmapStagingTexture(stagingTexture);
-
     commandList->open();
-    commandList->copyTexture(texture, slice, stagingTexture, slice);
+    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip)
+    {
+        nvrhi::TextureSlice slice = nvrhi::TextureSlice().setMipLevel(mip);
+        commandList->copyTexture(texture, slice, stagingTexture, slice);
+    }
     commandList->close();
     nvrhiDevice->executeCommandList(commandList);
+    FrameStats::addCommandListSubmission();
     return true;
 }
 
@@ -126,6 +132,7 @@ bool readbackBuffer(ref<Device> device, nvrhi::BufferHandle buffer, void* pData,
 
     nvrhi::EventQueryHandle eventQuery = nvrhiDevice->createEventQuery();
     nvrhiDevice->executeCommandList(commandList);
+    FrameStats::addCommandListSubmission();
     nvrhiDevice->setEventQuery(eventQuery, nvrhi::CommandQueue::Graphics);
     nvrhiDevice->waitEventQuery(eventQuery);
     std::memcpy(pData, gReadbackHeap->mMappedBuffer, sizeBytes);
@@ -141,15 +148,15 @@ bool readbackTexture(ref<Device> device, nvrhi::TextureHandle texture, void* pDa
     auto commandList = device->getCommandList();
 
     const auto& desc = texture->getDesc();
-    uint32_t channelCount = getChannelCount(desc.format);
-    if (channelCount == 0)
+    const size_t rowSizeBytes = computeRowSize(desc.format, desc.width);
+    if (rowSizeBytes == 0)
     {
         LOG_ERROR("readbackTexture unsupported format: {}", static_cast<int>(desc.format));
         return false;
     }
 
-    const size_t rowSizeBytes = computeRowSize(desc, channelCount);
-    const size_t requiredSize = rowSizeBytes * desc.height;
+    const uint32_t rowCount = computeRowCount(desc.format, desc.height);
+    const size_t requiredSize = rowSizeBytes * rowCount;
     if (sizeBytes < requiredSize)
     {
         LOG_ERROR("readbackTexture insufficient destination size: required {} bytes, got {} bytes", requiredSize, sizeBytes);
@@ -170,6 +177,7 @@ bool readbackTexture(ref<Device> device, nvrhi::TextureHandle texture, void* pDa
 
     nvrhi::EventQueryHandle eventQuery = nvrhiDevice->createEventQuery();
     nvrhiDevice->executeCommandList(commandList);
+    FrameStats::addCommandListSubmission();
     nvrhiDevice->setEventQuery(eventQuery, nvrhi::CommandQueue::Graphics);
     nvrhiDevice->waitEventQuery(eventQuery);
 
@@ -183,7 +191,7 @@ bool readbackTexture(ref<Device> device, nvrhi::TextureHandle texture, void* pDa
 
     const size_t effectiveDstRowPitch = dstRowPitchBytes != 0 ? dstRowPitchBytes : rowSizeBytes;
     auto* dst = static_cast<uint8_t*>(pData);
-    for (uint32_t row = 0; row < desc.height; ++row)
+    for (uint32_t row = 0; row < rowCount; ++row)
     {
         const auto* srcRow = static_cast<const uint8_t*>(mappedData) + row * mappedRowPitch;
         auto* dstRow = dst + row * effectiveDstRowPitch;
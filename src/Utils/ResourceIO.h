@@ -21,9 +21,9 @@ bool uploadBuffer(ref<Device> device, nvrhi::BufferHandle buffer, const void* pD
     Upload texture data from CPU memory to GPU texture
     \param device The graphics device handle
     \param texture Target GPU texture to upload data to
-    \param pData Pointer to source texture data in CPU memory
+    \param pData Pointer to source texture data in CPU memory; every mip level of the texture, finest first
     \param sizeBytes Total size of texture data in bytes
-    \param srcRowPitchBytes Bytes per row in source data (0 = tightly packed)
+    \param srcRowPitchBytes Bytes per row of mip 0 in source data, or per row of blocks for BC formats (0 = tightly packed)
     \return True if upload succeeds, false otherwise
 */
 bool uploadTexture(ref<Device> device, nvrhi::TextureHandle texture, const void* pData, size_t sizeBytes, size_t srcRowPitchBytes = 0);
@@ -40,12 +40,12 @@ bool uploadTexture(ref<Device> device, nvrhi::TextureHandle texture, const void*
 bool readbackBuffer(ref<Device> device, nvrhi::BufferHandle buffer, void* pData, size_t sizeBytes, const char* debugName = "ReadbackBuffer");
 
 /*
-    Read back texture data from GPU texture to CPU memory
+    Read back mip 0 of a GPU texture to CPU memory
     \param device The graphics device handle
     \param texture Source GPU texture to read data from
     \param pData Pointer to destination buffer in CPU memory
     \param sizeBytes Total size of texture data in bytes
-    \param dstRowPitchBytes Bytes per row in destination data (0 = tightly packed)
+    \param dstRowPitchBytes Bytes per row in destination data, or per row of blocks for BC formats (0 = tightly packed)
     \return True if readback succeeds, false otherwise
 */
 bool readbackTexture(ref<Device> device, nvrhi::TextureHandle texture, void* pData, size_t sizeBytes, size_t dstRowPitchBytes = 0);
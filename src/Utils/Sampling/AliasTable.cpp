@@ -0,0 +1,62 @@
+#include "AliasTable.h"
+#include <algorithm>
+
+AliasTable::AliasTable(const std::vector<float>& weights)
+{
+    const size_t n = weights.size();
+    mEntries.resize(n);
+    mProbabilities.assign(n, 0.f);
+    for (size_t i = 0; i < n; ++i)
+        mEntries[i] = {1.f, static_cast<uint32_t>(i)};
+
+    for (float w : weights)
+        mWeightSum += std::max(w, 0.f);
+    if (n == 0 || mWeightSum <= 0.0)
+        return;
+
+    // Vose's method in double precision: scale probabilities by n, then repeatedly top up an
+    // under-full bin with the excess of an over-full one.
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    small.reserve(n);
+    large.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        double p = std::max(weights[i], 0.f) / mWeightSum;
+        mProbabilities[i] = static_cast<float>(p);
+        scaled[i] = p * static_cast<double>(n);
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32_t s = small.back();
+        small.pop_back();
+        uint32_t l = large.back();
+
+        mEntries[s] = {static_cast<float>(scaled[s]), l};
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // Whatever is left is full up to rounding error; such bins keep themselves, except zero-weight
+    // items, which must still never be returned.
+    const uint32_t heaviest = static_cast<uint32_t>(std::max_element(mProbabilities.begin(), mProbabilities.end()) - mProbabilities.begin());
+    for (uint32_t i : large)
+        mEntries[i] = {1.f, i};
+    for (uint32_t i : small)
+        mEntries[i] = mProbabilities[i] > 0.f ? AliasEntry{1.f, i} : AliasEntry{0.f, heaviest};
+}
+
+uint32_t AliasTable::sample(float uBin, float uAlias) const
+{
+    const uint32_t n = static_cast<uint32_t>(mEntries.size());
+    uint32_t bin = std::min(static_cast<uint32_t>(uBin * n), n - 1);
+    const AliasEntry& entry = mEntries[bin];
+    return uAlias < entry.threshold ? bin : entry.alias;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// One alias-table bin: keep the bin with probability `threshold`, otherwise take `alias`.
+// Layout matches EmissiveAlias in Scene.slang.
+struct AliasEntry
+{
+    float threshold;
+    uint32_t alias;
+};
+
+// Walker/Vose alias table for O(1) sampling of a discrete distribution.
+// Weights need not be normalized; items with zero weight are never selected.
+class AliasTable
+{
+public:
+    AliasTable() = default;
+    explicit AliasTable(const std::vector<float>& weights);
+
+    const std::vector<AliasEntry>& getEntries() const { return mEntries; }
+    size_t size() const { return mEntries.size(); }
+    double getWeightSum() const { return mWeightSum; }
+
+    // Probability of selecting item `index` (weight / weight sum)
+    float getProbability(uint32_t index) const { return mProbabilities[index]; }
+
+    // CPU mirror of the shader lookup: uBin picks the bin, uAlias picks between bin and alias. Both in [0, 1).
+    uint32_t sample(float uBin, float uAlias) const;
+
+private:
+    std::vector<AliasEntry> mEntries;
+    std::vector<float> mProbabilities;
+    double mWeightSum = 0.0;
+};
@@ -0,0 +1,108 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool& ThreadPool::get()
+{
+    static ThreadPool sPool;
+    return sPool;
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    mWorkers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++)
+        mWorkers.emplace_back([this]() { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mCondition.notify_all();
+    for (std::thread& worker : mWorkers)
+        worker.join();
+}
+
+void ThreadPool::enqueue(std::function<void()> task)
+{
+    if (mWorkers.empty())
+    {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTasks.push(std::move(task));
+    }
+    mCondition.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mStopping || !mTasks.empty(); });
+            if (mStopping && mTasks.empty())
+                return;
+            task = std::move(mTasks.front());
+            mTasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t blockSize, const std::function<void(size_t, size_t)>& body, bool parallel)
+{
+    if (count == 0)
+        return;
+    blockSize = std::max<size_t>(blockSize, 1);
+    const size_t blockCount = (count + blockSize - 1) / blockSize;
+
+    if (!parallel || blockCount == 1 || mWorkers.empty())
+    {
+        for (size_t block = 0; block < blockCount; block++)
+            body(block * blockSize, std::min(count, (block + 1) * blockSize));
+        return;
+    }
+
+    // Blocks are claimed from a shared counter. The caller claims blocks too, so a parallelFor issued
+    // from inside a worker task still makes progress when every worker is busy.
+    struct SharedState
+    {
+        std::atomic<size_t> nextBlock{0};
+        std::atomic<size_t> doneBlocks{0};
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<SharedState>();
+    auto runBlocks = [state, &body, count, blockSize, blockCount]()
+    {
+        size_t block;
+        while ((block = state->nextBlock.fetch_add(1)) < blockCount)
+        {
+            body(block * blockSize, std::min(count, (block + 1) * blockSize));
+            if (state->doneBlocks.fetch_add(1) + 1 == blockCount)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_all();
+            }
+        }
+    };
+
+    // Helpers that start after all blocks are claimed return immediately, so capturing body by
+    // reference is safe: no helper touches it once the last block has finished.
+    const size_t helperCount = std::min<size_t>(mWorkers.size(), blockCount - 1);
+    for (size_t i = 0; i < helperCount; i++)
+        enqueue(runBlocks);
+    runBlocks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&]() { return state->doneBlocks.load() == blockCount; });
+}
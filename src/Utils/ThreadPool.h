@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+    Fixed-size worker pool for CPU-side load work (scene setup, texture decoding, shader builds).
+    parallelFor splits a range into fixed-size blocks; the block layout never depends on the
+    thread count, so per-block results combined in block order are deterministic.
+*/
+class ThreadPool
+{
+public:
+    // Process-wide pool sized to the hardware concurrency
+    static ThreadPool& get();
+
+    // threadCount = 0 picks std::thread::hardware_concurrency() - 1 workers (the caller also works)
+    explicit ThreadPool(uint32_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+    // Queue a task; the future carries its result
+    template<typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<F>>
+    {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    /*
+        Run body(begin, end) over [0, count) in blocks of blockSize and wait for all of them
+        \param count Number of items
+        \param blockSize Items per block; fixes the partition independently of the thread count
+        \param body Called once per block; blocks may run concurrently and in any order
+        \param parallel False runs every block in order on the calling thread (reference path)
+    */
+    void parallelFor(size_t count, size_t blockSize, const std::function<void(size_t, size_t)>& body, bool parallel = true);
+
+private:
+    void enqueue(std::function<void()> task);
+    void workerLoop();
+
+    std::vector<std::thread> mWorkers;
+    std::queue<std::function<void()>> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopping = false;
+};
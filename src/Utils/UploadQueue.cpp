@@ -0,0 +1,77 @@
+#include "UploadQueue.h"
+#include "Core/Device.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+
+UploadQueue::UploadQueue(ref<Device> pDevice, uint64_t chunkSizeBytes, uint64_t batchSizeBytes)
+    : mpDevice(pDevice), mBatchSizeBytes(batchSizeBytes)
+{
+    nvrhi::CommandListParameters params;
+    params.setQueueType(nvrhi::CommandQueue::Graphics).setUploadChunkSize(chunkSizeBytes);
+    mCommandList = mpDevice->getDevice()->createCommandList(params);
+}
+
+UploadQueue::~UploadQueue()
+{
+    submit();
+}
+
+bool UploadQueue::enqueueTexture(nvrhi::TextureHandle texture, const void* pData, size_t sizeBytes)
+{
+    if (!texture || !pData || sizeBytes == 0)
+        return false;
+
+    const nvrhi::TextureDesc& desc = texture->getDesc();
+    const nvrhi::FormatInfo& info = nvrhi::getFormatInfo(desc.format);
+    if (info.bytesPerBlock == 0 || info.blockSize == 0)
+    {
+        LOG_ERROR("UploadQueue unsupported format: {}", static_cast<int>(desc.format));
+        return false;
+    }
+
+    size_t requiredSize = 0;
+    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip)
+    {
+        const size_t blocksX = (std::max(desc.width >> mip, 1u) + info.blockSize - 1) / info.blockSize;
+        const size_t blocksY = (std::max(desc.height >> mip, 1u) + info.blockSize - 1) / info.blockSize;
+        requiredSize += blocksX * blocksY * info.bytesPerBlock;
+    }
+    if (sizeBytes < requiredSize)
+    {
+        LOG_ERROR("UploadQueue insufficient data for '{}': required {} bytes, got {} bytes", desc.debugName, requiredSize, sizeBytes);
+        return false;
+    }
+
+    if (!mIsOpen)
+    {
+        mCommandList->open();
+        mIsOpen = true;
+    }
+
+    const uint8_t* src = static_cast<const uint8_t*>(pData);
+    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip)
+    {
+        const size_t rowPitch = (std::max(desc.width >> mip, 1u) + info.blockSize - 1) / info.blockSize * info.bytesPerBlock;
+        const size_t rowCount = (std::max(desc.height >> mip, 1u) + info.blockSize - 1) / info.blockSize;
+        mCommandList->writeTexture(texture, 0, mip, src, rowPitch);
+        src += rowPitch * rowCount;
+    }
+
+    mOpenBytes += requiredSize;
+    if (mOpenBytes >= mBatchSizeBytes)
+        submit();
+    return true;
+}
+
+void UploadQueue::submit()
+{
+    if (!mIsOpen)
+        return;
+
+    mCommandList->close();
+    mpDevice->getDevice()->executeCommandList(mCommandList);
+    mIsOpen = false;
+    mSubmittedBatchCount++;
+    mSubmittedBytes += mOpenBytes;
+    mOpenBytes = 0;
+}
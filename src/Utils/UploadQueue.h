@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <nvrhi/nvrhi.h>
+
+#include "Core/Pointer.h"
+
+class Device;
+
+/*
+    Batches texture uploads into one command list per batch instead of one submission per texture.
+    Texels are copied into the command list's upload chunks when they are enqueued, so the caller
+    can release its data right away. NVRHI keeps those chunks in a pool and reuses one only after the
+    fence of the batch that last used it has passed; a large chunk size makes the pool behave as a
+    persistent staging ring. Batches are submitted without waiting, so the GPU copies one batch while
+    the CPU prepares the next.
+*/
+class UploadQueue
+{
+public:
+    static constexpr uint64_t kDefaultChunkSizeBytes = 64ull << 20;
+    static constexpr uint64_t kDefaultBatchSizeBytes = 128ull << 20;
+
+    /*
+        \param chunkSizeBytes Size of each staging chunk; larger uploads get a dedicated chunk
+        \param batchSizeBytes Enqueued bytes after which the open batch is submitted
+    */
+    UploadQueue(ref<Device> pDevice, uint64_t chunkSizeBytes = kDefaultChunkSizeBytes, uint64_t batchSizeBytes = kDefaultBatchSizeBytes);
+    ~UploadQueue();
+
+    /*
+        Record a copy of every mip level of a texture into the open batch
+        \param pData All mip levels back to back, finest first, each tightly packed (rows of blocks for BC formats)
+        \param sizeBytes Total size of pData in bytes
+        \return True if the copies were recorded, false otherwise
+    */
+    bool enqueueTexture(nvrhi::TextureHandle texture, const void* pData, size_t sizeBytes);
+
+    // Submit the open batch, if any, without waiting. Later work on the graphics queue sees the uploads.
+    void submit();
+
+    uint32_t getSubmittedBatchCount() const { return mSubmittedBatchCount; }
+    uint64_t getSubmittedBytes() const { return mSubmittedBytes; }
+
+private:
+    ref<Device> mpDevice;
+    nvrhi::CommandListHandle mCommandList;
+    uint64_t mBatchSizeBytes;
+    bool mIsOpen = false;
+    uint64_t mOpenBytes = 0;
+    uint32_t mSubmittedBatchCount = 0;
+    uint64_t mSubmittedBytes = 0;
+};
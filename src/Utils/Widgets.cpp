@@ -147,8 +147,8 @@ void headerStrip(const HeaderMetrics& metrics)
     char memText[32];
     formatTriangleCount(trisText, sizeof(trisText), metrics.sceneTris);
     formatGpuMem(memText, sizeof(memText), metrics.gpuMemMB);
-    char statsText[80];
-    std::snprintf(statsText, sizeof(statsText), "   |   %s   %s", trisText, memText);
+    char statsText[96];
+    std::snprintf(statsText, sizeof(statsText), "   |   %s   %s   %u submits", trisText, memText, metrics.submits);
 
     const ImVec2 timingSize = ImGui::CalcTextSize(timingText);
     const ImVec2 statsSize = ImGui::CalcTextSize(statsText);
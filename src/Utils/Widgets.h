@@ -14,6 +14,7 @@ struct HeaderMetrics
     float fps;          // averaged framerate
     uint64_t sceneTris; // unique triangle count (pre-instancing)
     uint64_t gpuMemMB;  // local VRAM currently in use, in megabytes
+    uint32_t submits;   // command lists submitted this frame, UI excluded
 };
 
 /// Multiplier for converting design-space pixels to physical pixels at the
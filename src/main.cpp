@@ -4,10 +4,13 @@
 
 #include "Core/Device.h"
 #include "Core/Window.h"
+#include "Core/Program/ShaderCache.h"
+#include "ShaderPasses/ShaderHotReload.h"
 #include "Scene/Importer/Importer.h"
 #include "RenderPasses/RenderGraphBuilder.h"
 #include "RenderPasses/RenderGraphEditor.h"
 #include "RenderPasses/ErrorMeasurePass/ErrorMeasure.h"
+#include "Utils/FrameStats.h"
 #include "Utils/Logger.h"
 #include "Utils/GUI.h"
 #include "Utils/ResourceIO.h"
@@ -57,6 +60,8 @@ int main()
         RenderGraphEditor renderGraphEditor(pDevice);
         auto defaultRenderGraph = RenderGraphBuilder::createDefaultGraph(pDevice);
         defaultRenderGraph->setScene(scene);
+        const ShaderCache::Stats shaderCacheStats = ShaderCache::getStats();
+        LOG_INFO("Shader cache: {} hits, {} misses", shaderCacheStats.hits, shaderCacheStats.misses);
 
         auto errorMeasure = defaultRenderGraph->getPassByName<ErrorMeasurePass>("ErrorMeasure");
         errorMeasure->setTextureReference(std::string(PROJECT_DIR) + "/media/bistro_reference.exr");
@@ -65,6 +70,8 @@ int main()
         renderGraphEditor.initializeFromRenderGraph(defaultRenderGraph);
         renderGraphEditor.setScene(scene);
 
+        ShaderHotReload::get().start();
+
         GUIManager guiManager(pDevice);
         bool notDone = true;
         while (notDone)
@@ -83,9 +90,13 @@ int main()
                 break;
             }
             pDevice->getDevice()->runGarbageCollection();
+            FrameStats::reset();
+
+            // Swap in recompiled shaders between frames; restart accumulation like a camera move would
+            const bool shadersReloaded = ShaderHotReload::get().applyPendingReloads() > 0;
 
             // Update camera parameters if dirty
-            if (scene->camera->dirty)
+            if (scene->camera->dirty || shadersReloaded)
                 renderGraphEditor.setScene(scene);
             scene->camera->calculateCameraParameters(); // Remember this contains jitter
 
@@ -93,7 +104,7 @@ int main()
             auto renderGraph = renderGraphEditor.getCurrentRenderGraph();
             renderGraph->execute();
 
-            // Set texture for display using the selected output
+            // Display the selected output; the window rewrites its SRV only when the texture changes
             nvrhi::TextureHandle imageTexture = renderGraph->getFinalOutputTexture();
             ID3D12Resource* d3d12Texture = static_cast<ID3D12Resource*>(imageTexture->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource));
             window.SetDisplayTexture(d3d12Texture);
@@ -122,6 +133,9 @@ int main()
         exitCode = 1;
     }
 
+    // The reload thread compiles through the device
+    ShaderHotReload::get().stop();
+
     // Release readback heap before device shutdown
     gReadbackHeap.reset();
 
@@ -4,6 +4,7 @@
 
 #include "Core/Device.h"
 #include "ShaderPasses/ComputePass.h"
+#include "Utils/FrameStats.h"
 #include "Utils/ResourceIO.h"
 #include "Utils/Logger.h"
 #include "Environment.h"
@@ -55,4 +56,59 @@ TEST_F(ComputeShader, BufferAdd)
     ASSERT_TRUE(ResourceIO::readbackBuffer(mpDevice, bufResult, resultData.data(), bufferByteSize));
     for (size_t i = 0; i < elementCount; i++)
         EXPECT_FLOAT_EQ(resultData[i], inputA[i] + inputB[i]);
-}
\ No newline at end of file
+}
+
+// Constant buffers persist across dispatches: an unchanged one is not written again, and after a change the
+// next dispatch reads the new value.
+TEST_F(ComputeShader, ConstantBufferUploadsOnlyOnChange)
+{
+    const uint32_t elementCount = 64;
+    const size_t bufferByteSize = elementCount * sizeof(float);
+    std::vector<float> input(elementCount, 0.5f);
+    nvrhi::BufferHandle bufA = TestHelpers::createStructuredBufferSRV(mpDevice, input.data(), bufferByteSize, sizeof(float), "BufferA");
+    nvrhi::BufferHandle bufResult = TestHelpers::createStructuredBufferUAV(mpDevice, bufferByteSize, sizeof(float), "BufferResult");
+    ASSERT_TRUE(bufA && bufResult);
+
+    struct alignas(16) ScaleCB
+    {
+        float scale = 2.f;
+    } constants;
+    nvrhi::BufferDesc cbDesc;
+    cbDesc.byteSize = sizeof(ScaleCB);
+    cbDesc.isConstantBuffer = true;
+    cbDesc.initialState = nvrhi::ResourceStates::ConstantBuffer;
+    cbDesc.keepInitialState = true;
+    cbDesc.debugName = "ScaleCB";
+    nvrhi::BufferHandle cb = mpDevice->getDevice()->createBuffer(cbDesc);
+    ASSERT_TRUE(cb);
+
+    auto pass = make_ref<ComputePass>(mpDevice, "/tests/ConstantBufferTest.slang", "scaleMain");
+    pass->addConstantBuffer(cb, &constants, sizeof(constants));
+    (*pass)["ScaleCB"] = cb;
+    (*pass)["BufferA"] = bufA;
+    (*pass)["BufferResult"] = bufResult;
+
+    auto verify = [&](float expected, const char* label)
+    {
+        auto bytes = TestHelpers::readbackBuffer(mpDevice, bufResult, bufferByteSize);
+        ASSERT_EQ(bytes.size(), bufferByteSize) << label;
+        std::vector<float> result(elementCount);
+        std::memcpy(result.data(), bytes.data(), bufferByteSize);
+        for (size_t i = 0; i < elementCount; i++)
+            EXPECT_FLOAT_EQ(result[i], expected) << label << " element " << i;
+    };
+
+    FrameStats::reset();
+    pass->execute(elementCount, 1, 1);
+    verify(1.f, "first dispatch");
+    pass->execute(elementCount, 1, 1);
+    verify(1.f, "unchanged");
+    EXPECT_EQ(FrameStats::get().constantBufferUploads, 1u);
+    EXPECT_EQ(FrameStats::get().constantBufferSkips, 1u);
+
+    constants.scale = 4.f;
+    pass->execute(elementCount, 1, 1);
+    verify(2.f, "changed");
+    EXPECT_EQ(FrameStats::get().constantBufferUploads, 2u);
+    EXPECT_EQ(FrameStats::get().constantBufferUploadBytes, 2 * sizeof(ScaleCB));
+}
@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Scene/Importer/Importer.h"
+#include "Scene/Lights/LightBVH.h"
+#include "Utils/Sampling/AliasTable.h"
+#include "Environment.h"
+#include "TestHelpers.h"
+
+namespace
+{
+const std::string kCornellPath = std::string(PROJECT_DIR) + "/media/cornell_box.usdc";
+
+// Random double-sided triangle emitters scattered in a 10^3 box, every fifth one dark.
+std::vector<LightBounds> makeRandomTriangleLights(uint32_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-5.f, 5.f);
+    std::uniform_real_distribution<float> offset(-0.3f, 0.3f);
+    std::uniform_real_distribution<float> power(0.1f, 10.f);
+
+    std::vector<LightBounds> lights(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        float3 p0(pos(rng), pos(rng), pos(rng));
+        float3 p1 = p0 + float3(offset(rng), offset(rng), offset(rng));
+        float3 p2 = p0 + float3(offset(rng), offset(rng), offset(rng));
+        LightBounds& lb = lights[i];
+        lb.boundsMin = glm::min(p0, glm::min(p1, p2));
+        lb.boundsMax = glm::max(p0, glm::max(p1, p2));
+        lb.phi = (i % 5 == 4) ? 0.f : power(rng);
+        lb.w = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+        lb.cosThetaO = 1.f;
+        lb.cosThetaE = 0.f;
+        lb.twoSided = true;
+    }
+    return lights;
+}
+
+// Strip of `trianglesPerMesh` emissive triangles instanced `instanceCount` times with random
+// transforms, plus one non-emissive instance in between so offsets are not trivially dense.
+ref<Scene> makeEmissiveStripScene(ref<Device> pDevice, uint32_t trianglesPerMesh, uint32_t instanceCount)
+{
+    ref<Scene> scene = make_ref<Scene>(pDevice);
+    for (uint32_t i = 0; i < trianglesPerMesh + 2; i++)
+    {
+        float x = float(i / 2);
+        float y = float(i % 2);
+        scene->vertices.push_back(Vertex{{x, y, 0.01f * x * x}, {x / trianglesPerMesh, y}, {0.f, 0.f, 1.f}});
+    }
+    for (uint32_t t = 0; t < trianglesPerMesh; t++)
+    {
+        scene->indices.push_back(t);
+        scene->indices.push_back(t + 1);
+        scene->indices.push_back(t + 2);
+    }
+
+    Material emissive;
+    emissive.emissiveFactor = float3(4.f, 2.f, 1.f);
+    scene->materials = {Material(), emissive};
+    uint32_t meshID = scene->addMesh(0, static_cast<uint32_t>(scene->indices.size()));
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-50.f, 50.f);
+    for (uint32_t i = 0; i < instanceCount; i++)
+    {
+        glm::mat4 xform = glm::rotate(glm::translate(glm::mat4(1.f), float3(dist(rng), dist(rng), dist(rng))), dist(rng), float3(0.f, 1.f, 0.f));
+        scene->addInstance(meshID, i % 3 == 1 ? 0 : 1, xform);
+    }
+    return scene;
+}
+
+std::vector<std::pair<float3, float3>> makeReceivers(uint32_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-6.f, 6.f);
+    std::uniform_real_distribution<float> dir(-1.f, 1.f);
+    std::vector<std::pair<float3, float3>> receivers;
+    for (uint32_t i = 0; i < count; i++)
+        receivers.emplace_back(float3(pos(rng), pos(rng), pos(rng)), glm::normalize(float3(dir(rng), dir(rng), dir(rng)) + float3(0.f, 0.f, 1e-3f)));
+    // Orientation-agnostic receiver as well
+    receivers.emplace_back(float3(0.f), float3(0.f));
+    return receivers;
+}
+} // namespace
+
+// Headless checks of the CPU reference that LightSampler.slang mirrors.
+TEST(LightBVH, PmfSumsToOne)
+{
+    std::vector<LightBounds> lights = makeRandomTriangleLights(300, 7);
+    LightBVH bvh;
+    bvh.build(lights);
+    ASSERT_FALSE(bvh.empty());
+
+    for (const auto& [p, n] : makeReceivers(16, 11))
+    {
+        double sum = 0.0;
+        for (uint32_t i = 0; i < lights.size(); i++)
+        {
+            float pmf = bvh.evalPMF(p, n, i);
+            EXPECT_GE(pmf, 0.f);
+            if (lights[i].phi == 0.f)
+                EXPECT_EQ(pmf, 0.f) << "zero-power light " << i << " has non-zero pmf";
+            sum += pmf;
+        }
+        // A receiver may see no light at all; otherwise the pmf is normalized.
+        if (sum > 0.0)
+            EXPECT_NEAR(sum, 1.0, 1e-4);
+    }
+}
+
+TEST(LightBVH, SampleMatchesEvalPMF)
+{
+    std::vector<LightBounds> lights = makeRandomTriangleLights(300, 3);
+    LightBVH bvh;
+    bvh.build(lights);
+
+    constexpr uint32_t kSamples = 200000;
+    for (const auto& [p, n] : makeReceivers(4, 5))
+    {
+        std::vector<uint32_t> hits(lights.size(), 0);
+        uint32_t valid = 0;
+        for (uint32_t s = 0; s < kSamples; s++)
+        {
+            float pmf = 0.f;
+            uint32_t light = bvh.sample(p, n, (s + 0.5f) / kSamples, pmf);
+            if (light == LightBVH::kInvalidLight)
+                continue;
+            ASSERT_LT(light, lights.size());
+            EXPECT_NEAR(pmf, bvh.evalPMF(p, n, light), 1e-5f * std::max(pmf, 1.f));
+            hits[light]++;
+            valid++;
+        }
+        if (valid == 0)
+            continue;
+
+        // Stratified u sweeps the unit interval, so frequencies must track the pmf closely.
+        for (uint32_t i = 0; i < lights.size(); i++)
+            EXPECT_NEAR(double(hits[i]) / kSamples, bvh.evalPMF(p, n, i), 1e-3) << "light " << i;
+    }
+}
+
+TEST(AliasTable, ReproducesWeights)
+{
+    const std::vector<float> weights = {0.f, 1.f, 8.f, 0.5f, 0.f, 3.f, 0.25f};
+    AliasTable table(weights);
+    ASSERT_EQ(table.size(), weights.size());
+    EXPECT_DOUBLE_EQ(table.getWeightSum(), 12.75);
+
+    // Integrate the selection probability over a fine grid of (uBin, uAlias); each bin owns an equal
+    // slice of uBin, so the fraction of grid points landing on item i must match its weight.
+    constexpr uint32_t kSteps = 512;
+    std::vector<uint32_t> hits(weights.size(), 0);
+    for (uint32_t b = 0; b < weights.size() * kSteps; b++)
+    {
+        float uBin = (b + 0.5f) / (weights.size() * kSteps);
+        for (uint32_t a = 0; a < kSteps; a++)
+            hits[table.sample(uBin, (a + 0.5f) / kSteps)]++;
+    }
+
+    const double total = double(weights.size()) * kSteps * kSteps;
+    for (uint32_t i = 0; i < weights.size(); i++)
+    {
+        EXPECT_NEAR(table.getProbability(i), weights[i] / 12.75, 1e-6);
+        EXPECT_NEAR(hits[i] / total, weights[i] / 12.75, 2e-3) << "item " << i;
+        if (weights[i] == 0.f)
+            EXPECT_EQ(hits[i], 0u) << "zero-weight item " << i << " was selected";
+    }
+}
+
+class EmissiveSamplingTest : public DeviceTest
+{};
+
+TEST_F(EmissiveSamplingTest, CornellTrianglePdfsIntegrateToOne)
+{
+    ref<Scene> scene = loadSceneWithImporter(kCornellPath, mpDevice);
+    ASSERT_NE(scene, nullptr);
+    scene->buildAccelStructs();
+    ASSERT_FALSE(scene->emissiveTriangles.empty());
+    ASSERT_GT(scene->totalEmissivePower, 0.f);
+
+    // Sum over triangles of pdf_area * area is the total selection probability.
+    double sum = 0.0;
+    for (const EmissiveTriangle& et : scene->emissiveTriangles)
+    {
+        EXPECT_GE(et.pdf, 0.f);
+        sum += double(et.pdf) * et.area;
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-4);
+    EXPECT_EQ(scene->getEmissiveAliasTable().size(), scene->emissiveTriangles.size());
+}
+
+TEST_F(EmissiveSamplingTest, ParallelCollectionMatchesSerial)
+{
+    ref<Scene> scene = makeEmissiveStripScene(mpDevice, 20000, 12);
+
+    scene->collectEmissiveLights(false);
+    const std::vector<EmissiveTriangle> serialTriangles = scene->emissiveTriangles;
+    const std::vector<uint32_t> serialOffsets = scene->getInstanceEmissiveOffsets();
+    const std::vector<AliasEntry> serialAlias = scene->getEmissiveAliasTable().getEntries();
+    const std::vector<LightBVHNode> serialNodes = scene->getLightBVH().getNodes();
+    const float serialArea = scene->totalEmissiveArea;
+    const float serialPower = scene->totalEmissivePower;
+    ASSERT_EQ(serialTriangles.size(), 8u * 20000u);
+
+    scene->collectEmissiveLights(true);
+    auto sameBytes = [](const auto& a, const auto& b)
+    { return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0; };
+    EXPECT_TRUE(sameBytes(serialTriangles, scene->emissiveTriangles));
+    EXPECT_TRUE(sameBytes(serialOffsets, scene->getInstanceEmissiveOffsets()));
+    EXPECT_TRUE(sameBytes(serialAlias, scene->getEmissiveAliasTable().getEntries()));
+    EXPECT_TRUE(sameBytes(serialNodes, scene->getLightBVH().getNodes()));
+    // Both paths sum per-block partials in block order, so the totals match to the bit
+    EXPECT_EQ(std::memcmp(&serialArea, &scene->totalEmissiveArea, sizeof(float)), 0);
+    EXPECT_EQ(std::memcmp(&serialPower, &scene->totalEmissivePower, sizeof(float)), 0);
+}
+
+TEST_F(EmissiveSamplingTest, CornellLightMatchesHandComputedGeometry)
+{
+    // The ceiling light is one quad spanning x in [-0.24, 0.23] and z in [-10.22, -9.84] at y = 0.98.
+    constexpr float kLightArea = 0.47f * 0.38f;
+    ref<Scene> scene = loadSceneWithImporter(kCornellPath, mpDevice);
+    ASSERT_NE(scene, nullptr);
+
+    for (bool parallel : {false, true})
+    {
+        scene->collectEmissiveLights(parallel);
+        ASSERT_EQ(scene->emissiveTriangles.size(), 2u) << "parallel: " << parallel;
+        for (const EmissiveTriangle& et : scene->emissiveTriangles)
+            EXPECT_NEAR(et.area, 0.5f * kLightArea, 1e-5f);
+        EXPECT_NEAR(scene->totalEmissiveArea, kLightArea, 1e-5f);
+    }
+}
+
+class EmissiveSamplingBench : public BenchmarkTest
+{};
+
+TEST_F(EmissiveSamplingBench, CollectOneMillionTriangles)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kIterations = 3;
+    // 16 of 24 instances are emissive: 16 x 66667 ~ 1.07M emissive triangles
+    ref<Scene> scene = makeEmissiveStripScene(mpDevice, 66667, 24);
+
+    auto timeCollect = [&](bool parallel)
+    {
+        double ms = 0.0;
+        for (int i = 0; i < kIterations; ++i)
+        {
+            auto start = Clock::now();
+            scene->collectEmissiveLights(parallel);
+            ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+        return ms / kIterations;
+    };
+    const double serialMs = timeCollect(false);
+    const double parallelMs = timeCollect(true);
+    ASSERT_GE(scene->emissiveTriangles.size(), 1000000u);
+
+    std::cout << scene->emissiveTriangles.size() << " emissive triangles (avg of " << kIterations << "): serial " << serialMs << " ms, parallel "
+              << parallelMs << " ms" << std::endl;
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -7,6 +11,8 @@
 #include "Environment.h"
 #include "TestHelpers.h"
 #include "RenderPasses/RenderGraph.h"
+#include "RenderPasses/TransientResourcePlanner.h"
+#include "ShaderPasses/ComputePass.h"
 
 namespace
 {
@@ -27,17 +33,15 @@ public:
         , mpExecutionLog(std::move(executionLog))
     {}
 
-    RenderData execute(const RenderData& input) override
+    void execute(RenderContext& context, const RenderData& input) override
     {
         if (mpExecutionLog)
             mpExecutionLog->push_back(mName);
 
-        RenderData result;
-        for (const auto& output : mOutputs)
-            result.setResource(output.name, nullptr);
+        for (uint32_t i = 0; i < mPublished.size(); ++i)
+            setOutput(i, mPublished[i]);
 
         mLastInputs = input;
-        return result;
     }
 
     void renderUI() override {}
@@ -45,8 +49,13 @@ public:
     std::vector<RenderPassInput> getInputs() const override { return mInputs; }
     std::vector<RenderPassOutput> getOutputs() const override { return mOutputs; }
     std::string getName() const override { return mName; }
+    bool hasSideEffects() const override { return mHasSideEffects; }
 
     const RenderData& getLastInputs() const { return mLastInputs; }
+    void setHasSideEffects(bool hasSideEffects) { mHasSideEffects = hasSideEffects; }
+    // Resources execute() publishes, by output index; outputs past the list stay null
+    void setPublished(std::vector<nvrhi::ResourceHandle> published) { mPublished = std::move(published); }
+    nvrhi::TextureHandle getGraphOutputTexture(const std::string& name) const { return getOutputTexture(name); }
 
 private:
     std::string mName;
@@ -54,6 +63,8 @@ private:
     std::vector<RenderPassOutput> mOutputs;
     std::shared_ptr<std::vector<std::string>> mpExecutionLog;
     RenderData mLastInputs;
+    std::vector<nvrhi::ResourceHandle> mPublished;
+    bool mHasSideEffects = false;
 };
 } // namespace
 
@@ -244,3 +255,349 @@ TEST_F(RenderGraphBuild, RejectsConnectionsToUnknownSlots)
     EXPECT_EQ(graph, nullptr);
     EXPECT_EQ(RenderGraph::lastBuildStatus(), RenderGraphBuildStatus::UnknownOutputSlot);
 }
+
+TEST_F(RenderGraphBuild, ForwardsPublishedOutputsBySlot)
+{
+    const float4 texel(1.f, 2.f, 3.f, 4.f);
+    nvrhi::TextureHandle texture = TestHelpers::createFloat4Texture1D(mpDevice, &texel, 1, "ForwardedTexture");
+    nvrhi::BufferHandle buffer = TestHelpers::createStructuredBufferUAV(mpDevice, sizeof(float4), sizeof(float4), "ForwardedBuffer");
+    ASSERT_TRUE(texture && buffer);
+
+    auto source = make_ref<TestRenderPass>(
+        mpDevice,
+        "Source",
+        std::vector<RenderPassInput>{},
+        std::vector<RenderPassOutput>{{"color", RenderDataType::Texture2D}, {"data", RenderDataType::Buffer}},
+        nullptr
+    );
+    auto sink = make_ref<TestRenderPass>(
+        mpDevice,
+        "Sink",
+        std::vector<RenderPassInput>{{"color", RenderDataType::Texture2D}, {"data", RenderDataType::Buffer}},
+        std::vector<RenderPassOutput>{{"result", RenderDataType::Texture2D}},
+        nullptr
+    );
+    source->setPublished({texture, buffer});
+
+    std::vector<RenderGraphNode> nodes{{"Source", source}, {"Sink", sink}};
+    std::vector<RenderGraphConnection> connections{
+        {"Source", "color", "Sink", "color"},
+        {"Source", "data", "Sink", "data"},
+    };
+    auto graph = RenderGraph::create(mpDevice, nodes, connections);
+    ASSERT_NE(graph, nullptr);
+
+    const RenderData& outputs = graph->execute();
+    EXPECT_EQ(sink->getLastInputs()["color"].Get(), texture.Get());
+    EXPECT_EQ(sink->getLastInputs()["data"].Get(), buffer.Get());
+    EXPECT_EQ(outputs["Source.data"].Get(), buffer.Get());
+    EXPECT_EQ(outputs["Sink.result"], nullptr);
+
+    // Nothing published this frame: last frame's handles must not leak through
+    source->setPublished({});
+    graph->execute();
+    EXPECT_EQ(sink->getLastInputs()["color"], nullptr);
+    EXPECT_EQ(source->getOutput("data"), nullptr);
+}
+
+// Only the texture the graph allocated for the selected output ends the frame as a shader resource; anything else
+// a pass publishes there (e.g. its input, passed through) is displayed through the copy.
+TEST_F(RenderGraphBuild, CopiesSelectedOutputNotAllocatedByGraph)
+{
+    constexpr uint32_t kSize = 8;
+    auto pass = make_ref<TestRenderPass>(
+        mpDevice,
+        "Source",
+        std::vector<RenderPassInput>{},
+        std::vector<RenderPassOutput>{{"color", nvrhi::Format::RGBA32_FLOAT, RenderPassOutputLifetime::Transient}},
+        nullptr
+    );
+    auto graph = RenderGraph::create(mpDevice, {{"Source", pass}}, {});
+    ASSERT_NE(graph, nullptr);
+    ASSERT_TRUE(graph->selectOutput("Source.color"));
+
+    ref<Scene> scene = make_ref<Scene>(mpDevice);
+    scene->camera = make_ref<Camera>(float3(0.f), float3(0.f, 0.f, -1.f), 1.f, kSize, kSize);
+    graph->setScene(scene);
+    nvrhi::TextureHandle allocated = pass->getGraphOutputTexture("color");
+    ASSERT_NE(allocated, nullptr);
+
+    pass->setPublished({allocated});
+    graph->execute();
+    EXPECT_FALSE(graph->isFinalOutputCopied());
+    EXPECT_EQ(graph->getFinalOutputTexture().Get(), allocated.Get());
+
+    // A texture the pass owns keeps its own initial state, here UnorderedAccess, so it must not be sampled in place
+    auto foreignDesc = nvrhi::TextureDesc()
+                           .setWidth(kSize)
+                           .setHeight(kSize)
+                           .setFormat(nvrhi::Format::RGBA32_FLOAT)
+                           .setIsUAV(true)
+                           .setInitialState(nvrhi::ResourceStates::UnorderedAccess)
+                           .setKeepInitialState(true)
+                           .setDebugName("ForeignOutput");
+    nvrhi::TextureHandle foreign = mpDevice->getDevice()->createTexture(foreignDesc);
+    pass->setPublished({foreign});
+    graph->execute();
+    EXPECT_TRUE(graph->isFinalOutputCopied());
+    ASSERT_NE(graph->getFinalOutputTexture(), nullptr);
+    EXPECT_NE(graph->getFinalOutputTexture().Get(), foreign.Get());
+    EXPECT_EQ(graph->getFinalOutputTexture()->getDesc().initialState, nvrhi::ResourceStates::ShaderResource);
+}
+
+TEST_F(RenderGraphBuild, CullsPassesNotFeedingSelectedOutputOrSideEffects)
+{
+    auto executionLog = std::make_shared<std::vector<std::string>>();
+    const std::vector<RenderPassInput> oneInput{{"input", RenderDataType::Texture2D}};
+    const std::vector<RenderPassOutput> oneOutput{{"color", RenderDataType::Texture2D}};
+
+    auto source = make_ref<TestRenderPass>(mpDevice, "Source", std::vector<RenderPassInput>{}, oneOutput, executionLog);
+    auto viewed = make_ref<TestRenderPass>(mpDevice, "Viewed", oneInput, oneOutput, executionLog);
+    auto debug = make_ref<TestRenderPass>(mpDevice, "Debug", oneInput, oneOutput, executionLog);
+    auto readback = make_ref<TestRenderPass>(mpDevice, "Readback", oneInput, std::vector<RenderPassOutput>{}, executionLog);
+
+    std::vector<RenderGraphNode> nodes{
+        {"Source", source},
+        {"Viewed", viewed},
+        {"Debug", debug},
+        {"Readback", readback},
+    };
+
+    std::vector<RenderGraphConnection> connections{
+        {"Source", "color", "Viewed", "input"},
+        {"Source", "color", "Debug", "input"},
+        {"Debug", "color", "Readback", "input"},
+    };
+
+    auto graph = RenderGraph::create(mpDevice, nodes, connections);
+    ASSERT_NE(graph, nullptr);
+    ASSERT_TRUE(graph->selectOutput("Viewed.color"));
+    EXPECT_FALSE(graph->selectOutput("Viewed.missing"));
+
+    graph->execute();
+    EXPECT_EQ(*executionLog, (std::vector<std::string>{"Source", "Viewed"}));
+    EXPECT_TRUE(graph->isCulled("Debug"));
+    EXPECT_TRUE(graph->isCulled("Readback"));
+
+    // A side-effect pass keeps itself and everything it reads alive
+    executionLog->clear();
+    readback->setHasSideEffects(true);
+    graph->execute();
+    EXPECT_EQ(executionLog->size(), 4u);
+    EXPECT_FALSE(graph->isCulled("Debug"));
+
+    executionLog->clear();
+    readback->setHasSideEffects(false);
+    ASSERT_TRUE(graph->selectOutput("Debug.color"));
+    graph->execute();
+    EXPECT_EQ(*executionLog, (std::vector<std::string>{"Source", "Debug"}));
+    EXPECT_TRUE(graph->isCulled("Viewed"));
+}
+
+// Lifetimes are inclusive positions in the execution order; these run without a device.
+TEST(TransientResourcePlanner, DisjointLifetimesShareMemory)
+{
+    constexpr uint64_t kFrame4K = 3840ull * 2160ull * 16ull; // RGBA32_FLOAT
+    constexpr uint64_t kAlignment = 64ull << 10;
+
+    // Default graph selecting ErrorMeasure.output: PathTracing -> (Accumulate) -> ToneMapping -> ErrorMeasure -> copy
+    std::vector<TransientResourcePlanner::Request> requests{
+        {kFrame4K, kAlignment, 0, 1}, // PathTracing.output
+        {kFrame4K, kAlignment, 2, 3}, // ToneMapping.output
+        {kFrame4K, kAlignment, 3, 5}, // ErrorMeasure.output
+    };
+    TransientResourcePlanner::Plan plan = TransientResourcePlanner::plan(requests);
+    EXPECT_EQ(plan.offsets[0], plan.offsets[1]);
+    EXPECT_NE(plan.offsets[1], plan.offsets[2]);
+    EXPECT_EQ(plan.requestedBytes, 3 * kFrame4K);
+    EXPECT_LT(plan.heapSizeBytes, 2 * kFrame4K + kAlignment);
+    EXPECT_EQ(plan.sharesMemoryWith[0], std::vector<size_t>{1});
+    EXPECT_EQ(plan.sharesMemoryWith[1], std::vector<size_t>{0});
+    EXPECT_TRUE(plan.sharesMemoryWith[2].empty());
+
+    // A long chain of single-reader outputs ping-pongs between two slots
+    requests.clear();
+    for (uint32_t i = 0; i < 8; ++i)
+        requests.push_back({kFrame4K, kAlignment, i, i + 1});
+    plan = TransientResourcePlanner::plan(requests);
+    EXPECT_LT(plan.heapSizeBytes, 2 * kFrame4K + kAlignment);
+    EXPECT_EQ(plan.requestedBytes, 8 * kFrame4K);
+}
+
+TEST(TransientResourcePlanner, LiveResourcesNeverOverlap)
+{
+    std::vector<TransientResourcePlanner::Request> requests;
+    uint32_t seed = 12345u;
+    auto next = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        const uint32_t firstUse = next() % 32;
+        const uint64_t alignment = 1ull << (8 + next() % 9);
+        requests.push_back({1 + next() % (1u << 20), alignment, firstUse, firstUse + next() % 8});
+    }
+
+    const TransientResourcePlanner::Plan plan = TransientResourcePlanner::plan(requests);
+    ASSERT_EQ(plan.offsets.size(), requests.size());
+    EXPECT_LE(plan.heapSizeBytes, plan.requestedBytes + requests.size() * (1ull << 16));
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        EXPECT_EQ(plan.offsets[i] % requests[i].alignment, 0u);
+        EXPECT_LE(plan.offsets[i] + requests[i].sizeBytes, plan.heapSizeBytes);
+        for (size_t j = i + 1; j < requests.size(); ++j)
+        {
+            const bool memoryOverlaps =
+                plan.offsets[i] < plan.offsets[j] + requests[j].sizeBytes && plan.offsets[j] < plan.offsets[i] + requests[i].sizeBytes;
+            EXPECT_FALSE(memoryOverlaps && TransientResourcePlanner::livesOverlap(requests[i], requests[j]))
+                << "requests " << i << " and " << j << " are live at the same time in the same memory";
+            const auto& shared = plan.sharesMemoryWith[i];
+            EXPECT_EQ(memoryOverlaps, std::find(shared.begin(), shared.end(), j) != shared.end());
+        }
+    }
+}
+
+// CPU cost of binding the default graph's compute passes each frame, by name (hashing every lookup)
+// vs by slots resolved up front. Accumulate ping-pongs its output between two targets, which must
+// reuse cached binding sets instead of creating one per frame.
+class BindingBench : public BenchmarkTest
+{
+protected:
+    nvrhi::TextureHandle createTarget(const char* name)
+    {
+        nvrhi::TextureDesc desc = nvrhi::TextureDesc()
+                                      .setDimension(nvrhi::TextureDimension::Texture2D)
+                                      .setWidth(64)
+                                      .setHeight(64)
+                                      .setFormat(nvrhi::Format::RGBA32_FLOAT)
+                                      .setIsUAV(true)
+                                      .setInitialState(nvrhi::ResourceStates::UnorderedAccess)
+                                      .setKeepInitialState(true)
+                                      .setDebugName(name);
+        return mpDevice->getDevice()->createTexture(desc);
+    }
+};
+
+TEST_F(BindingBench, DefaultGraphPerFrameBinding)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kWarmupFrames = 16;
+    constexpr uint32_t kFrames = 100000;
+
+    ComputePass accumulate(mpDevice, "/src/RenderPasses/AccumulatePass/Accumulate.slang", "main");
+    ComputePass toneMapping(mpDevice, "/src/RenderPasses/ToneMappingPass/ToneMapping.slang", "main");
+
+    nvrhi::BufferDesc cbDesc = nvrhi::BufferDesc().setByteSize(256).setIsConstantBuffer(true).setKeepInitialState(true).setDebugName("PerFrameCB");
+    nvrhi::BufferHandle cb = mpDevice->getDevice()->createBuffer(cbDesc);
+    nvrhi::TextureHandle radiance = createTarget("Radiance");
+    nvrhi::TextureHandle history = createTarget("History");
+    nvrhi::TextureHandle pingPong[2] = {createTarget("Ping"), createTarget("Pong")};
+    nvrhi::TextureHandle display = createTarget("Display");
+    ASSERT_TRUE(cb && radiance && history && pingPong[0] && pingPong[1] && display);
+
+    auto bindByName = [&](uint32_t frame)
+    {
+        accumulate["PerFrameCB"] = cb;
+        accumulate["input"] = radiance;
+        accumulate["accumulateTexture"] = history;
+        accumulate["output"] = pingPong[frame & 1];
+        toneMapping["input"] = pingPong[frame & 1];
+        toneMapping["output"] = display;
+        return accumulate.getBindingSetManager()->getBindingSets().size() + toneMapping.getBindingSetManager()->getBindingSets().size();
+    };
+
+    const uint32_t accumulateSlots[4] = {
+        accumulate.getSlot("PerFrameCB"), accumulate.getSlot("input"), accumulate.getSlot("accumulateTexture"), accumulate.getSlot("output")
+    };
+    const uint32_t toneMappingSlots[2] = {toneMapping.getSlot("input"), toneMapping.getSlot("output")};
+    auto bindBySlot = [&](uint32_t frame)
+    {
+        accumulate[accumulateSlots[0]] = cb;
+        accumulate[accumulateSlots[1]] = radiance;
+        accumulate[accumulateSlots[2]] = history;
+        accumulate[accumulateSlots[3]] = pingPong[frame & 1];
+        toneMapping[toneMappingSlots[0]] = pingPong[frame & 1];
+        toneMapping[toneMappingSlots[1]] = display;
+        return accumulate.getBindingSetManager()->getBindingSets().size() + toneMapping.getBindingSetManager()->getBindingSets().size();
+    };
+
+    auto createdSets = [&]()
+    {
+        return accumulate.getBindingSetManager()->getCreatedBindingSetCount() + toneMapping.getBindingSetManager()->getCreatedBindingSetCount();
+    };
+
+    auto timeFrames = [&](auto bind)
+    {
+        size_t sink = 0;
+        auto start = Clock::now();
+        for (uint32_t i = 0; i < kFrames; ++i)
+            sink += bind(i);
+        EXPECT_GT(sink, 0u);
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kFrames;
+    };
+
+    for (uint32_t i = 0; i < kWarmupFrames; ++i)
+        bindBySlot(i);
+    const uint64_t warmCreated = createdSets();
+
+    const double byNameUs = timeFrames(bindByName);
+    const double bySlotUs = timeFrames(bindBySlot);
+    EXPECT_EQ(createdSets(), warmCreated) << "ping-pong bindings should reuse cached binding sets";
+
+    std::cout << "Default graph binding (avg of " << kFrames << " frames): by name " << byNameUs << " us, by slot " << bySlotUs
+              << " us, binding sets created after warm-up " << createdSets() - warmCreated << std::endl;
+}
+
+class RenderGraphBench : public BenchmarkTest
+{};
+
+TEST_F(RenderGraphBench, SyntheticGraphExecute)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kPassCount = 200;
+    constexpr uint32_t kWarmupFrames = 16;
+    constexpr uint32_t kFrames = 2000;
+
+    // A chain of no-op passes; every fourth pass also reads the output four passes back
+    std::vector<RenderGraphNode> nodes;
+    std::vector<RenderGraphConnection> connections;
+    for (uint32_t i = 0; i < kPassCount; ++i)
+    {
+        std::vector<RenderPassInput> inputs;
+        if (i > 0)
+            inputs.push_back({"input", RenderDataType::Texture2D});
+        if (i >= 4 && i % 4 == 0)
+            inputs.push_back({"skip", RenderDataType::Texture2D});
+
+        const std::string name = "P" + std::to_string(i);
+        auto pass = make_ref<TestRenderPass>(
+            mpDevice, name, std::move(inputs), std::vector<RenderPassOutput>{{"color", RenderDataType::Texture2D}}, nullptr
+        );
+        nodes.push_back({name, pass});
+        if (i > 0)
+            connections.push_back({"P" + std::to_string(i - 1), "color", name, "input"});
+        if (i >= 4 && i % 4 == 0)
+            connections.push_back({"P" + std::to_string(i - 4), "color", name, "skip"});
+    }
+
+    auto graph = RenderGraph::create(mpDevice, nodes, connections);
+    ASSERT_NE(graph, nullptr);
+    ASSERT_EQ(graph->getExecutionOrder().size(), kPassCount);
+
+    for (uint32_t i = 0; i < kWarmupFrames; ++i)
+        graph->execute();
+
+    size_t sink = 0;
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < kFrames; ++i)
+    {
+        const RenderData& outputs = graph->execute();
+        sink += std::distance(outputs.begin(), outputs.end());
+    }
+    const double frameUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kFrames;
+    EXPECT_EQ(sink, static_cast<size_t>(kPassCount) * kFrames);
+
+    std::cout << "Synthetic graph execute (" << kPassCount << " no-op passes, avg of " << kFrames << " frames): " << frameUs << " us" << std::endl;
+}
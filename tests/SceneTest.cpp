@@ -0,0 +1,381 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+
+#include "Scene/Importer/Importer.h"
+#include "Scene/Importer/SceneCache.h"
+#include "Scene/Importer/UsdImporter.h"
+#include "Scene/Material/TextureMips.h"
+#include "Utils/ResourceIO.h"
+#include "Utils/UploadQueue.h"
+#include "Environment.h"
+#include "TestHelpers.h"
+
+namespace
+{
+const std::string kCornellPath = std::string(PROJECT_DIR) + "/media/cornell_box.usdc";
+
+template<typename T>
+bool bytesEqual(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+} // namespace
+
+class UsdImporterTest : public DeviceTest
+{};
+
+TEST_F(UsdImporterTest, WeldsCornellBoxVertices)
+{
+    ref<Scene> scene = loadSceneWithImporter(kCornellPath, mpDevice, false);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_FALSE(scene->indices.empty());
+
+    // Without welding every index gets its own vertex.
+    EXPECT_LT(scene->vertices.size(), scene->indices.size());
+
+    for (const MeshDesc& mesh : scene->meshes)
+    {
+        // Within one mesh no two referenced vertices may be bit-identical.
+        std::unordered_set<uint32_t> referenced;
+        std::unordered_set<std::string> unique;
+        for (uint32_t i = 0; i < mesh.indexCount; i++)
+        {
+            uint32_t index = scene->indices[mesh.indexOffset + i];
+            ASSERT_LT(index, scene->vertices.size());
+            if (!referenced.insert(index).second)
+                continue;
+            const char* bytes = reinterpret_cast<const char*>(&scene->vertices[index]);
+            EXPECT_TRUE(unique.emplace(bytes, sizeof(Vertex)).second) << "duplicate vertex " << index;
+        }
+    }
+}
+
+class SceneAccelStructTest : public DeviceTest
+{};
+
+TEST_F(SceneAccelStructTest, CompactsBottomLevelAccelStructs)
+{
+    ref<Scene> scene = loadSceneWithImporter(kCornellPath, mpDevice);
+    ASSERT_NE(scene, nullptr);
+    scene->buildAccelStructs();
+    ASSERT_NE(scene->getTLAS(), nullptr);
+
+    const AccelStructStats& stats = scene->getAccelStructStats();
+    EXPECT_GE(stats.blasBatchCount, 1u);
+    EXPECT_GT(stats.blasBytesBeforeCompaction, 0u);
+    EXPECT_GT(stats.blasBytesAfterCompaction, 0u);
+    EXPECT_LE(stats.blasBytesAfterCompaction, stats.blasBytesBeforeCompaction);
+}
+
+class TextureManagerTest : public DeviceTest
+{};
+
+TEST_F(TextureManagerTest, KeepsSourcePrecision)
+{
+    constexpr uint32_t kSize = 8;
+    std::vector<uint8_t> rgba(kSize * kSize * 4);
+    for (size_t i = 0; i < rgba.size(); i++)
+        rgba[i] = static_cast<uint8_t>(i * 7);
+
+    TextureManager textures(mpDevice);
+    uint32_t id = textures.loadTexture(rgba.data(), kSize, kSize, 4, TextureUsage::Color, "rgba8");
+    ASSERT_NE(id, kInvalidTextureId);
+    textures.flush();
+    EXPECT_EQ(textures.getTexture(id)->getDesc().format, nvrhi::Format::RGBA8_UNORM);
+    // The full chain (8x8 down to 1x1) is resident
+    EXPECT_EQ(textures.getTexture(id)->getDesc().mipLevels, 4u);
+    EXPECT_EQ(textures.getTextureMemoryBytes(), TextureMips::getChainSizeBytes(kSize, kSize, nvrhi::Format::RGBA8_UNORM, 4));
+    EXPECT_EQ(textures.getFloatEquivalentMemoryBytes(), rgba.size() * sizeof(float));
+
+    std::vector<uint8_t> readback(rgba.size());
+    ASSERT_TRUE(ResourceIO::readbackTexture(mpDevice, textures.getTexture(id), readback.data(), readback.size()));
+    EXPECT_TRUE(bytesEqual(rgba, readback));
+
+    // Normal maps keep RG only; opaque color and single-channel data compress to BC1 and BC4
+    uint32_t normalId = textures.loadTexture(rgba.data(), kSize, kSize, 4, TextureUsage::Normal, "normal");
+    textures.flush();
+    EXPECT_EQ(textures.getTexture(normalId)->getDesc().format, nvrhi::Format::RG8_UNORM);
+
+    textures.setCompression(true);
+    std::vector<uint8_t> gray(kSize * kSize, 128);
+    uint32_t bc4Id = textures.loadTexture(gray.data(), kSize, kSize, 1, TextureUsage::Data, "bc4");
+    textures.flush();
+    EXPECT_EQ(textures.getTexture(bc4Id)->getDesc().format, nvrhi::Format::BC4_UNORM);
+    std::vector<float> linear(kSize * kSize * 3, 0.5f);
+    uint32_t bc1Id = textures.loadTexture(linear.data(), kSize, kSize, 3, TextureUsage::Color, "bc1");
+    textures.flush();
+    EXPECT_EQ(textures.getTexture(bc1Id)->getDesc().format, nvrhi::Format::BC1_UNORM_SRGB);
+    ASSERT_NE(textures.getThumbnail(bc1Id), nullptr);
+    EXPECT_NEAR(textures.getThumbnail(bc1Id)->fetch(float2(0.5f)).g, 0.5f, 0.02f);
+}
+
+TEST_F(TextureManagerTest, DeduplicatesIdenticalPayloads)
+{
+    constexpr uint32_t kSize = 8;
+    std::vector<uint8_t> rg(kSize * kSize * 2);
+    for (size_t i = 0; i < rg.size(); i++)
+        rg[i] = static_cast<uint8_t>(i * 5);
+
+    // Same texels under another name or usage share the texture; one changed byte does not
+    TextureManager textures(mpDevice);
+    uint32_t id = textures.loadTexture(rg.data(), kSize, kSize, 2, TextureUsage::Data, "a.png");
+    EXPECT_EQ(textures.loadTexture(rg.data(), kSize, kSize, 2, TextureUsage::Data, "copy/a.png"), id);
+    EXPECT_EQ(textures.loadTexture(rg.data(), kSize, kSize, 2, TextureUsage::Color, "a_color.png"), id);
+    rg.back() ^= 1;
+    uint32_t otherId = textures.loadTexture(rg.data(), kSize, kSize, 2, TextureUsage::Data, "b.png");
+    EXPECT_NE(otherId, id);
+    textures.flush();
+
+    const uint64_t chainBytes = TextureMips::getChainSizeBytes(kSize, kSize, nvrhi::Format::RG8_UNORM, 4);
+    EXPECT_EQ(textures.getTextureCount(), 2u);
+    EXPECT_EQ(textures.getDeduplicatedTextureCount(), 2u);
+    EXPECT_EQ(textures.getDeduplicatedBytes(), 2 * chainBytes);
+    EXPECT_EQ(textures.getTextureMemoryBytes(), 2 * chainBytes);
+
+    // Another manager holding as many textures must not report the same generation to a bindless table
+    TextureManager otherTextures(mpDevice);
+    otherTextures.loadTexture(rg.data(), kSize, kSize, 2, TextureUsage::Data, "b.png");
+    rg.back() ^= 1;
+    otherTextures.loadTexture(rg.data(), kSize, kSize, 2, TextureUsage::Data, "a.png");
+    otherTextures.flush();
+    EXPECT_EQ(otherTextures.getTextureCount(), textures.getTextureCount());
+    EXPECT_NE(otherTextures.getGeneration(), textures.getGeneration());
+}
+
+TEST_F(TextureManagerTest, PackedScalarsCompressLikeSeparateTextures)
+{
+    // Two scalar maps as the importer packs them: separately each is BC4, interleaved into RG they are BC5
+    constexpr uint32_t kSize = 16;
+    std::vector<uint8_t> metallic(kSize * kSize), roughness(kSize * kSize), packed(kSize * kSize * 2);
+    for (uint32_t i = 0; i < kSize * kSize; i++)
+    {
+        metallic[i] = static_cast<uint8_t>((i % kSize) * 16 + (i * 7) % 13);
+        roughness[i] = static_cast<uint8_t>(255 - (i / kSize) * 15 - (i * 11) % 9);
+        packed[i * 2 + 0] = metallic[i];
+        packed[i * 2 + 1] = roughness[i];
+    }
+
+    TextureManager textures(mpDevice);
+    textures.setCompression(true);
+    uint32_t metallicId = textures.loadTexture(metallic.data(), kSize, kSize, 1, TextureUsage::Data, "metallic");
+    uint32_t roughnessId = textures.loadTexture(roughness.data(), kSize, kSize, 1, TextureUsage::Data, "roughness");
+    uint32_t packedId = textures.loadTexture(packed.data(), kSize, kSize, 2, TextureUsage::Data, "metallic+roughness");
+    textures.flush();
+    EXPECT_EQ(textures.getTexture(metallicId)->getDesc().format, nvrhi::Format::BC4_UNORM);
+    EXPECT_EQ(textures.getTexture(packedId)->getDesc().format, nvrhi::Format::BC5_UNORM);
+
+    // Thumbnails of textures up to kMaxSize hold the decoded top level texel for texel
+    auto maxError = [&](uint32_t id, int channel, const std::vector<uint8_t>& source)
+    {
+        const TextureThumbnail* pThumbnail = textures.getThumbnail(id);
+        float error = 0.f;
+        for (size_t i = 0; i < source.size(); i++)
+            error = std::max(error, std::abs(pThumbnail->texels[i][channel] - source[i] / 255.f));
+        return error;
+    };
+    for (uint32_t id : {metallicId, roughnessId, packedId})
+    {
+        ASSERT_NE(textures.getThumbnail(id), nullptr);
+        ASSERT_EQ(textures.getThumbnail(id)->texels.size(), kSize * kSize);
+    }
+    const float metallicError = maxError(metallicId, 0, metallic);
+    const float roughnessError = maxError(roughnessId, 0, roughness);
+    EXPECT_LE(maxError(packedId, 0, metallic), metallicError + 1.f / 255.f);
+    EXPECT_LE(maxError(packedId, 1, roughness), roughnessError + 1.f / 255.f);
+    EXPECT_LT(std::max(metallicError, roughnessError), 8.f / 255.f);
+
+    // The material reads each scalar from its own channel of the packed texture; unpacked slots stay on R
+    Material material;
+    material.setScalarChannel(MaterialScalarSlot::Roughness, 1);
+    EXPECT_EQ(material.getScalarChannel(MaterialScalarSlot::Metallic), 0u);
+    EXPECT_EQ(material.getScalarChannel(MaterialScalarSlot::Roughness), 1u);
+    EXPECT_EQ(material.getScalarChannel(MaterialScalarSlot::Transmission), 0u);
+}
+
+TEST_F(TextureManagerTest, BatchedUploadsMatchSource)
+{
+    // A 1-byte batch limit submits after every texture, so the copies cross several batches
+    constexpr uint32_t kSize = 16;
+    UploadQueue uploads(mpDevice, UploadQueue::kDefaultChunkSizeBytes, 1);
+    std::vector<std::vector<uint8_t>> sources;
+    std::vector<nvrhi::TextureHandle> textures;
+    for (uint32_t t = 0; t < 3; t++)
+    {
+        std::vector<uint8_t>& texels = sources.emplace_back(kSize * kSize * 4);
+        for (size_t i = 0; i < texels.size(); i++)
+            texels[i] = static_cast<uint8_t>(i * 3 + t * 41);
+
+        auto desc = nvrhi::TextureDesc()
+                        .setWidth(kSize)
+                        .setHeight(kSize)
+                        .setFormat(nvrhi::Format::RGBA8_UNORM)
+                        .setInitialState(nvrhi::ResourceStates::ShaderResource)
+                        .setKeepInitialState(true)
+                        .setDebugName("batched");
+        textures.push_back(mpDevice->getDevice()->createTexture(desc));
+        ASSERT_TRUE(uploads.enqueueTexture(textures.back(), texels.data(), texels.size()));
+    }
+    uploads.submit();
+    EXPECT_EQ(uploads.getSubmittedBatchCount(), 3u);
+
+    for (size_t t = 0; t < textures.size(); t++)
+    {
+        std::vector<uint8_t> readback(sources[t].size());
+        ASSERT_TRUE(ResourceIO::readbackTexture(mpDevice, textures[t], readback.data(), readback.size()));
+        EXPECT_TRUE(bytesEqual(sources[t], readback)) << "texture " << t;
+    }
+}
+
+class SceneCacheTest : public DeviceTest
+{};
+
+TEST_F(SceneCacheTest, RoundTripMatchesImport)
+{
+    std::error_code ec;
+    std::filesystem::remove(SceneCache::getCachePath(kCornellPath), ec);
+
+    // First load misses, imports, and writes the cache; second load must come from the cache.
+    ref<Scene> imported = loadSceneWithImporter(kCornellPath, mpDevice);
+    ASSERT_NE(imported, nullptr);
+    ASSERT_TRUE(std::filesystem::exists(SceneCache::getCachePath(kCornellPath)));
+
+    ref<Scene> cached = SceneCache::load(kCornellPath, mpDevice);
+    ASSERT_NE(cached, nullptr);
+
+    EXPECT_TRUE(bytesEqual(imported->vertices, cached->vertices));
+    EXPECT_TRUE(bytesEqual(imported->indices, cached->indices));
+    EXPECT_TRUE(bytesEqual(imported->meshes, cached->meshes));
+    EXPECT_TRUE(bytesEqual(imported->instances, cached->instances));
+    EXPECT_TRUE(bytesEqual(imported->materials, cached->materials));
+    EXPECT_EQ(imported->getTextureCount(), cached->getTextureCount());
+    ASSERT_EQ(imported->camera != nullptr, cached->camera != nullptr);
+
+    cached->buildAccelStructs();
+    EXPECT_NE(cached->getTLAS(), nullptr);
+}
+
+// A texture edited or replaced after the cache was written must invalidate it, even though the .usdc is unchanged.
+TEST_F(SceneCacheTest, ChangedSourceFileInvalidatesCache)
+{
+    const std::string texturePath = TestHelpers::artifactPath("scene_cache_dependency.png");
+    auto writeTexture = [&](const char* contents)
+    {
+        std::ofstream stream(texturePath, std::ios::binary | std::ios::trunc);
+        stream << contents;
+    };
+    writeTexture("original");
+
+    UsdImporter importer(mpDevice);
+    importer.setRecordTexturePayloads(true);
+    ref<Scene> imported = importer.loadScene(kCornellPath);
+    ASSERT_NE(imported, nullptr);
+    imported->getTextureManager()->flush();
+    imported->sourceFiles.push_back(texturePath);
+    ASSERT_TRUE(SceneCache::save(kCornellPath, *imported));
+
+    ref<Scene> cached = SceneCache::load(kCornellPath, mpDevice);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->sourceFiles, imported->sourceFiles);
+
+    writeTexture("replaced");
+    EXPECT_EQ(SceneCache::load(kCornellPath, mpDevice), nullptr);
+
+    std::error_code ec;
+    std::filesystem::remove(texturePath, ec);
+    EXPECT_EQ(SceneCache::load(kCornellPath, mpDevice), nullptr);
+    std::filesystem::remove(SceneCache::getCachePath(kCornellPath), ec);
+}
+
+class SceneCacheBench : public BenchmarkTest
+{};
+
+TEST_F(SceneCacheBench, CornellLoadTime)
+{
+    constexpr int kIterations = 5;
+    using Clock = std::chrono::steady_clock;
+
+    double coldMs = 0.0;
+    for (int i = 0; i < kIterations; ++i)
+    {
+        auto start = Clock::now();
+        ref<Scene> scene = loadSceneWithImporter(kCornellPath, mpDevice, false);
+        coldMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        ASSERT_NE(scene, nullptr);
+    }
+
+    // Make sure a current cache exists before timing warm loads.
+    ASSERT_NE(loadSceneWithImporter(kCornellPath, mpDevice), nullptr);
+
+    double warmMs = 0.0;
+    for (int i = 0; i < kIterations; ++i)
+    {
+        auto start = Clock::now();
+        ref<Scene> scene = SceneCache::load(kCornellPath, mpDevice);
+        warmMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        ASSERT_NE(scene, nullptr);
+    }
+
+    std::cout << "cornell_box.usdc load time (avg of " << kIterations << "): cold import " << coldMs / kIterations << " ms, cached "
+              << warmMs / kIterations << " ms" << std::endl;
+}
+
+class TextureUploadBench : public BenchmarkTest
+{};
+
+// 500 distinct 512x512 RGBA8 textures: one staging texture and submission per texture (mips generated
+// inline) vs TextureManager preparing on workers and uploading in batches.
+TEST_F(TextureUploadBench, FiveHundredTextures)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kCount = 500;
+    constexpr uint32_t kSize = 512;
+
+    std::vector<std::vector<uint8_t>> sources(kCount);
+    for (uint32_t t = 0; t < kCount; t++)
+    {
+        sources[t].resize(kSize * kSize * 4);
+        for (size_t i = 0; i < sources[t].size(); i++)
+            sources[t][i] = static_cast<uint8_t>(i * 13 + t * 7);
+    }
+
+    auto start = Clock::now();
+    {
+        std::vector<nvrhi::TextureHandle> textures;
+        const uint32_t mipLevels = TextureMips::getLevelCount(kSize, kSize);
+        for (uint32_t t = 0; t < kCount; t++)
+        {
+            std::vector<uint8_t> chain = TextureMips::generate(kSize, kSize, nvrhi::Format::RGBA8_UNORM, sources[t].data(), mipLevels, false);
+            auto desc = nvrhi::TextureDesc()
+                            .setWidth(kSize)
+                            .setHeight(kSize)
+                            .setMipLevels(mipLevels)
+                            .setFormat(nvrhi::Format::RGBA8_UNORM)
+                            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+                            .setKeepInitialState(true);
+            textures.push_back(mpDevice->getDevice()->createTexture(desc));
+            ASSERT_TRUE(ResourceIO::uploadTexture(mpDevice, textures.back(), chain.data(), chain.size()));
+        }
+        mpDevice->getDevice()->waitForIdle();
+    }
+    const double perTextureMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    TextureManager textures(mpDevice);
+    for (uint32_t t = 0; t < kCount; t++)
+        ASSERT_NE(textures.loadTexture(sources[t].data(), kSize, kSize, 4, TextureUsage::Data, "bench"), kInvalidTextureId);
+    textures.flush();
+    mpDevice->getDevice()->waitForIdle();
+    const double batchedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << kCount << " textures " << kSize << "x" << kSize << ": per-texture upload " << perTextureMs << " ms, batched "
+              << batchedMs << " ms" << std::endl;
+}
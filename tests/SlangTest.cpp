@@ -1,12 +1,23 @@
 #include <gtest/gtest.h>
 #include <vector>
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
 #include <string>
 
 #include "Core/Device.h"
+#include "Core/Program/ShaderCache.h"
+#include "Core/Program/ShaderCompiler.h"
+#include "RenderPasses/RenderGraphBuilder.h"
 #include "ShaderPasses/ComputePass.h"
+#include "ShaderPasses/ShaderHotReload.h"
 #include "Utils/ResourceIO.h"
+#include "Utils/ThreadPool.h"
 #include "Environment.h"
 #include "TestHelpers.h"
 
@@ -35,6 +46,19 @@ constexpr uint32_t kBindlessSlotCount = 8; // must match kBindlessSlotCount in S
 constexpr uint32_t kBindlessWrittenCount = 4;
 
 const float4 kDefaultBindlessColor{0.77f, 0.88f, 0.99f, 1.0f};
+
+// Puts back the shader cache and precompiled-module switches a test turns off, even when it stops early
+struct CompileSettingsGuard
+{
+    const bool shaderCacheEnabled = ShaderCache::isEnabled();
+    const bool precompiledModulesEnabled = ShaderCompiler::get().isPrecompiledModulesEnabled();
+
+    ~CompileSettingsGuard()
+    {
+        ShaderCache::setEnabled(shaderCacheEnabled);
+        ShaderCompiler::get().setPrecompiledModulesEnabled(precompiledModulesEnabled);
+    }
+};
 } // namespace
 
 // One shader (`everythingMain`) exercises constant buffers, RWTexture2D writes,
@@ -267,3 +291,310 @@ TEST_F(Slang, Bindless)
         EXPECT_FLOAT_EQ(results[i].w, kDefaultBindlessColor.w);
     }
 }
+
+// Unbounded descriptor table — grows past its initial size keeping earlier slots, and a repeated
+// generation leaves the table untouched.
+TEST_F(Slang, UnboundedBindless)
+{
+    constexpr uint32_t kCount = 300; // More than the initial table size
+    constexpr uint32_t kFirstCount = 100;
+    std::vector<float4> colors;
+    std::vector<nvrhi::TextureHandle> textures;
+    for (uint32_t i = 0; i < kCount; ++i)
+    {
+        const float4& color = colors.emplace_back(float(i) / kCount, 1.0f - float(i) / kCount, 0.5f, 1.0f);
+        textures.push_back(TestHelpers::createFloat4Texture1D(mpDevice, &color, 1, "UnboundedSlot"));
+        ASSERT_TRUE(textures.back());
+    }
+    nvrhi::TextureHandle defaultTexture = TestHelpers::createFloat4Texture1D(mpDevice, &kDefaultBindlessColor, 1, "UnboundedDefault");
+    nvrhi::BufferHandle output = TestHelpers::createStructuredBufferUAV(mpDevice, kCount * sizeof(float4), sizeof(float4), "UnboundedOutput");
+    ASSERT_TRUE(output);
+
+    auto unboundedPass = make_ref<ComputePass>(mpDevice, "/tests/SlangTest.slang", "unboundedMain");
+    (*unboundedPass)["gUnboundedOutput"] = output;
+    const uint32_t tableSlot = unboundedPass->getSlot("gUnbounded.textures");
+    ASSERT_NE(tableSlot, BindingSetManager::kInvalidSlot);
+
+    auto verify = [&](uint32_t count, const char* label)
+    {
+        auto bytes = TestHelpers::readbackBuffer(mpDevice, output, kCount * sizeof(float4));
+        ASSERT_EQ(bytes.size(), kCount * sizeof(float4));
+        const float4* results = reinterpret_cast<const float4*>(bytes.data());
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            SCOPED_TRACE(std::string(label) + " slot=" + std::to_string(i));
+            EXPECT_FLOAT_EQ(results[i].x, colors[i].x);
+            EXPECT_FLOAT_EQ(results[i].y, colors[i].y);
+        }
+    };
+
+    // Threads past the first list read default-filled slots that are still inside the initial table
+    std::vector<nvrhi::TextureHandle> firstTextures(textures.begin(), textures.begin() + kFirstCount);
+    unboundedPass->setDescriptorTable("gUnbounded.textures", firstTextures, defaultTexture, 1);
+    unboundedPass->execute(kFirstCount, 1, 1);
+    verify(kFirstCount, "first");
+
+    unboundedPass->setDescriptorTable(tableSlot, textures, defaultTexture, 2);
+    unboundedPass->execute(kCount, 1, 1);
+    verify(kCount, "grown");
+
+    // Same generation: the reversed list must not be written, whether the table is named or given by slot
+    std::vector<nvrhi::TextureHandle> reversed(textures.rbegin(), textures.rend());
+    unboundedPass->setDescriptorTable("gUnbounded.textures", reversed, defaultTexture, 2);
+    unboundedPass->setDescriptorTable(tableSlot, reversed, defaultTexture, 2);
+    unboundedPass->execute(kCount, 1, 1);
+    verify(kCount, "same generation");
+}
+
+// SetUp compiled everythingMain (or found it cached), so a second pass must come from disk without Slang
+// and still bind and dispatch identically.
+TEST_F(Slang, ShaderCacheHit)
+{
+    ShaderCache::resetStats();
+    auto cachedPass = make_ref<ComputePass>(mpDevice, "/tests/SlangTest.slang", "everythingMain");
+    EXPECT_EQ(ShaderCache::getStats().hits, 1u);
+    EXPECT_EQ(ShaderCache::getStats().misses, 0u);
+
+    (*cachedPass)["gInputBuffer"] = inputBuffer;
+    (*cachedPass)["gInputTexture"] = inputTexture;
+    (*cachedPass)["gConstants"] = constantBuffer;
+    (*cachedPass)["gOutputBuffer"] = basicOutput;
+    (*cachedPass)["gRWTextureOutput"] = rwTexture;
+    (*cachedPass)["gBlockParams.values"] = blockValueBuffer;
+    (*cachedPass)["gBlockParams.tex"] = blockTexture;
+    (*cachedPass)["gBlockOutput"] = blockOutput;
+    cachedPass->setDescriptorTable("gBindless.textures", {}, inputTexture);
+    (*cachedPass)["gBindlessOutput"] = bindlessOutput;
+    cachedPass->execute(kDispatchWidth, kDispatchHeight, 1);
+    verifyBasicOutput(constants, "cached");
+}
+
+// Headless: an entry goes stale as soon as any recorded dependency changes on disk.
+TEST(ShaderCache, EditedDependencyMisses)
+{
+    const std::filesystem::path dependency = std::filesystem::temp_directory_path() / "007ShaderCacheDependency.slang";
+    std::ofstream(dependency) << "// v1";
+
+    ShaderCache::Key key;
+    key.filePath = dependency.string();
+    key.profile = "cs_6_5";
+    key.sortedEntryPoints = {{"main", nvrhi::ShaderType::Compute}};
+    ShaderCache::Entry entry;
+    entry.kernels.push_back({"main", {1, 2, 3, 4}});
+    entry.threadGroupSize[0] = 16;
+    ShaderCache::Dependency recorded{dependency.string()};
+    ASSERT_TRUE(ShaderCache::hashDependency(recorded));
+    entry.dependencies.push_back(recorded);
+    ASSERT_TRUE(ShaderCache::save(key, entry));
+
+    ShaderCache::resetStats();
+    ShaderCache::Entry loaded;
+    ASSERT_TRUE(ShaderCache::load(key, loaded));
+    ASSERT_EQ(loaded.kernels.size(), 1u);
+    EXPECT_EQ(loaded.kernels[0].code, entry.kernels[0].code);
+    EXPECT_EQ(loaded.threadGroupSize[0], 16u);
+
+    key.sortedDefines = {{"FOO", "1"}};
+    EXPECT_FALSE(ShaderCache::load(key, loaded)) << "defines are part of the key";
+    key.sortedDefines.clear();
+
+    std::ofstream(dependency) << "// v2";
+    EXPECT_FALSE(ShaderCache::load(key, loaded));
+
+    // Saved after the edit, the entry still carries the hash of the compiled v1 and stays stale
+    ASSERT_TRUE(ShaderCache::save(key, entry));
+    EXPECT_FALSE(ShaderCache::load(key, loaded));
+    EXPECT_EQ(ShaderCache::getStats().hits, 1u);
+    EXPECT_EQ(ShaderCache::getStats().misses, 3u);
+
+    std::error_code ec;
+    std::filesystem::remove(ShaderCache::getCachePath(key), ec);
+    std::filesystem::remove(dependency, ec);
+}
+
+// Startup cost of building the default graph's shaders with Slang vs from the disk cache. Run this benchmark
+// alone: Slang sessions cached by earlier tests in the process would shorten the cold number.
+class ShaderCacheBench : public BenchmarkTest
+{
+protected:
+    CompileSettingsGuard mCompileSettings;
+};
+
+TEST_F(ShaderCacheBench, DefaultGraphStartup)
+{
+    using Clock = std::chrono::steady_clock;
+    auto timeStartup = [&]()
+    {
+        auto start = Clock::now();
+        auto renderGraph = RenderGraphBuilder::createDefaultGraph(mpDevice);
+        EXPECT_NE(renderGraph, nullptr);
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    ShaderCache::setEnabled(false);
+    const double coldMs = timeStartup();
+    ShaderCache::setEnabled(true);
+    timeStartup(); // Populate the cache
+    ShaderCache::resetStats();
+    const double warmMs = timeStartup();
+    const ShaderCache::Stats stats = ShaderCache::getStats();
+    EXPECT_EQ(stats.misses, 0u);
+
+    std::cout << "Default graph startup: Slang " << coldMs << " ms, shader cache " << warmMs << " ms (" << stats.hits << " hits, "
+              << stats.misses << " misses)" << std::endl;
+}
+
+// Programs compiled concurrently each lease their own Slang context; every pass must come out complete.
+class ShaderCompilerTest : public DeviceTest
+{
+protected:
+    CompileSettingsGuard mCompileSettings;
+};
+
+TEST_F(ShaderCompilerTest, ConcurrentCompiles)
+{
+    constexpr int kPassCount = 4;
+    ShaderCache::setEnabled(false);
+    std::vector<std::future<ref<ComputePass>>> futures;
+    for (int i = 0; i < kPassCount; ++i)
+        futures.push_back(ThreadPool::get().submit(
+            [this]() { return make_ref<ComputePass>(mpDevice, "/src/RenderPasses/ToneMappingPass/ToneMapping.slang", "main"); }
+        ));
+    for (auto& future : futures)
+    {
+        ref<ComputePass> pass = future.get();
+        ASSERT_NE(pass, nullptr);
+        EXPECT_NE(pass->getSlot("input"), BindingSetManager::kInvalidSlot);
+        EXPECT_NE(pass->getSlot("output"), BindingSetManager::kInvalidSlot);
+    }
+    EXPECT_GE(ShaderCompiler::get().getContextCount(), 1u);
+}
+
+// Default graph startup with every pass compiled by Slang: passes built one after another vs concurrently.
+// The concurrent number should approach the slowest single pass, not the sum.
+TEST_F(ShaderCacheBench, DefaultGraphParallelCompile)
+{
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+    ShaderCache::setEnabled(false);
+
+    double sumMs = 0.0;
+    double slowestMs = 0.0;
+    auto timePass = [&](auto create)
+    {
+        auto start = Clock::now();
+        EXPECT_NE(create(), nullptr);
+        const double ms = elapsedMs(start);
+        sumMs += ms;
+        slowestMs = std::max(slowestMs, ms);
+    };
+    timePass([&]() { return make_ref<PathTracingPass>(mpDevice); });
+    timePass([&]() { return make_ref<AccumulatePass>(mpDevice); });
+    timePass([&]() { return make_ref<ToneMappingPass>(mpDevice); });
+    timePass([&]() { return make_ref<ErrorMeasurePass>(mpDevice); });
+    timePass([&]() { return make_ref<TextureAverage>(mpDevice); });
+
+    auto start = Clock::now();
+    auto renderGraph = RenderGraphBuilder::createDefaultGraph(mpDevice);
+    const double parallelMs = elapsedMs(start);
+    EXPECT_NE(renderGraph, nullptr);
+
+    std::cout << "Default graph compile: sequential " << sumMs << " ms (slowest pass " << slowestMs << " ms), concurrent " << parallelMs
+              << " ms, " << ShaderCompiler::get().getContextCount() << " compiler contexts" << std::endl;
+}
+
+// A fresh session restores PathTracing's imports (Scene, materials, sampling) from precompiled IR
+// written by the previous compile, and the program still links against them.
+TEST_F(ShaderCompilerTest, PrecompiledModulesReload)
+{
+    ShaderCache::setEnabled(false);
+    ShaderCompiler& compiler = ShaderCompiler::get();
+    compiler.resetSessions();
+    EXPECT_NE(make_ref<PathTracingPass>(mpDevice), nullptr);
+
+    compiler.resetSessions();
+    compiler.resetModuleStats();
+    ref<PathTracingPass> pass = make_ref<PathTracingPass>(mpDevice);
+    ASSERT_NE(pass, nullptr);
+    EXPECT_GT(compiler.getModuleStats().loaded, 0u);
+    EXPECT_EQ(compiler.getModuleStats().stored, 0u) << "every import should have been up to date";
+}
+
+// An edited shader is recompiled by poll() and only swapped in by applyPendingReloads(); an edit that fails
+// to compile keeps the last good pipeline.
+TEST_F(ShaderCompilerTest, HotReload)
+{
+    const std::filesystem::path dir = std::filesystem::path(PROJECT_CACHE_DIR) / "hot-reload";
+    const std::filesystem::path shaderPath = dir / "HotReloadTest.slang";
+    std::filesystem::create_directories(dir);
+
+    // Coarse file clocks may not tick between two writes, so every write moves the timestamp forward explicitly
+    auto writeTime = std::filesystem::file_time_type::clock::now();
+    auto writeShader = [&](const char* statement)
+    {
+        std::ofstream(shaderPath) << "RWStructuredBuffer<uint> gOutput;\n\n[shader(\"compute\")]\n[numthreads(1, 1, 1)]\nvoid main()\n{\n    "
+                                  << statement << "\n}\n";
+        writeTime += std::chrono::seconds(1);
+        std::filesystem::last_write_time(shaderPath, writeTime);
+    };
+
+    writeShader("gOutput[0] = 1;");
+    ShaderHotReload& hotReload = ShaderHotReload::get();
+    auto pass = make_ref<ComputePass>(mpDevice, "/cache/hot-reload/HotReloadTest.slang", "main");
+    EXPECT_EQ(hotReload.poll(dir.string()), 0u) << "the first scan only records the directory";
+
+    nvrhi::BufferHandle output = TestHelpers::createStructuredBufferUAV(mpDevice, sizeof(uint32_t), sizeof(uint32_t), "HotReloadOutput");
+    auto run = [&]()
+    {
+        (*pass)["gOutput"] = output;
+        pass->execute(1, 1, 1);
+        auto bytes = TestHelpers::readbackBuffer(mpDevice, output, sizeof(uint32_t));
+        uint32_t value = 0;
+        if (bytes.size() == sizeof(value))
+            std::memcpy(&value, bytes.data(), sizeof(value));
+        return value;
+    };
+    EXPECT_EQ(run(), 1u);
+
+    writeShader("gOutput[0] = 2;");
+    EXPECT_EQ(hotReload.poll(dir.string()), 1u);
+    EXPECT_EQ(run(), 1u) << "the new pipeline waits for applyPendingReloads()";
+    EXPECT_EQ(hotReload.applyPendingReloads(), 1u);
+    EXPECT_EQ(run(), 2u);
+
+    writeShader("gOutput[0] = undefinedSymbol;");
+    EXPECT_EQ(hotReload.poll(dir.string()), 0u);
+    EXPECT_EQ(hotReload.applyPendingReloads(), 0u);
+    EXPECT_EQ(run(), 2u) << "a failed compile must keep the previous pipeline";
+
+    pass.reset();
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+// Front-end cost of building every registered pass in a fresh session, importing shared modules from
+// source vs from precompiled IR. The shader cache is off so both runs go through Slang.
+TEST_F(ShaderCacheBench, RegisteredPassesPrecompiledModules)
+{
+    using Clock = std::chrono::steady_clock;
+    ShaderCompiler& compiler = ShaderCompiler::get();
+    auto timePasses = [&]()
+    {
+        compiler.resetSessions();
+        auto start = Clock::now();
+        for (const RenderPassDescriptor& descriptor : RenderPassRegistry::getRegisteredPasses())
+            EXPECT_NE(descriptor.factory(mpDevice), nullptr) << descriptor.displayName;
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    ShaderCache::setEnabled(false);
+    compiler.setPrecompiledModulesEnabled(false);
+    const double sourceMs = timePasses();
+    compiler.setPrecompiledModulesEnabled(true);
+    timePasses(); // Serialize the imports
+    compiler.resetModuleStats();
+    const double precompiledMs = timePasses();
+
+    std::cout << "Registered passes (" << RenderPassRegistry::getRegisteredPasses().size() << "): imports from source " << sourceMs
+              << " ms, precompiled " << precompiledMs << " ms (" << compiler.getModuleStats().loaded << " modules loaded)" << std::endl;
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Scene/Material/TextureMips.h"
+
+namespace
+{
+size_t getLevelOffset(uint32_t width, uint32_t height, nvrhi::Format format, uint32_t level)
+{
+    return static_cast<size_t>(TextureMips::getChainSizeBytes(width, height, format, level));
+}
+} // namespace
+
+// Headless checks of the import-time mip generator.
+TEST(TextureMips, BoxFiltersEvenLevels)
+{
+    // 4x2 RG8: left 2x2 block is (0, 255), right is (255, 0)
+    const std::vector<uint8_t> level0 = {0, 255, 0, 255, 255, 0, 255, 0, 0, 255, 0, 255, 255, 0, 255, 0};
+    const nvrhi::Format format = nvrhi::Format::RG8_UNORM;
+
+    ASSERT_EQ(TextureMips::getLevelCount(4, 2), 3u);
+    std::vector<uint8_t> chain = TextureMips::generate(4, 2, format, level0.data(), 3, false);
+    ASSERT_EQ(chain.size(), level0.size() + 2 * 1 * 2 + 1 * 1 * 2);
+
+    const uint8_t* pLevel1 = chain.data() + getLevelOffset(4, 2, format, 1);
+    EXPECT_EQ(pLevel1[0], 0);
+    EXPECT_EQ(pLevel1[1], 255);
+    EXPECT_EQ(pLevel1[2], 255);
+    EXPECT_EQ(pLevel1[3], 0);
+
+    const uint8_t* pLevel2 = chain.data() + getLevelOffset(4, 2, format, 2);
+    EXPECT_EQ(pLevel2[0], 128);
+    EXPECT_EQ(pLevel2[1], 128);
+}
+
+TEST(TextureMips, OddSizesKeepEveryTexel)
+{
+    // A single bright texel at the end of a 3x1 row must still reach the 1x1 level with weight 1/3
+    const std::vector<float> level0 = {0.f, 0.f, 3.f};
+    const nvrhi::Format format = nvrhi::Format::R32_FLOAT;
+
+    std::vector<uint8_t> chain = TextureMips::generate(3, 1, format, reinterpret_cast<const uint8_t*>(level0.data()), 2, false);
+    float top = TextureMips::decodeTexel(format, chain.data() + getLevelOffset(3, 1, format, 1)).r;
+    EXPECT_NEAR(top, 1.f, 1e-6f);
+}
+
+TEST(TextureMips, AveragesSrgbInLinearSpace)
+{
+    // Black and white average to linear 0.5, which is sRGB ~188, not 128
+    const std::vector<uint8_t> level0 = {0, 0, 0, 255, 255, 255, 255, 255};
+    const nvrhi::Format format = nvrhi::Format::SRGBA8_UNORM;
+
+    std::vector<uint8_t> chain = TextureMips::generate(2, 1, format, level0.data(), 2, false);
+    const uint8_t* pLevel1 = chain.data() + getLevelOffset(2, 1, format, 1);
+    EXPECT_NEAR(pLevel1[0], 188, 1);
+    EXPECT_EQ(pLevel1[3], 255);
+    EXPECT_NEAR(TextureMips::decodeTexel(format, pLevel1).r, 0.5f, 0.005f);
+}
+
+TEST(TextureMips, RenormalizesNormalMaps)
+{
+    // Normals tilted +-45 degrees around Y average to +Z, not to a shortened vector
+    const float s = std::sqrt(0.5f);
+    const std::vector<float> level0 = {s * 0.5f + 0.5f, 0.5f, -s * 0.5f + 0.5f, 0.5f};
+    const nvrhi::Format format = nvrhi::Format::RG32_FLOAT;
+
+    std::vector<uint8_t> chain = TextureMips::generate(2, 1, format, reinterpret_cast<const uint8_t*>(level0.data()), 2, true);
+    float4 texel = TextureMips::decodeTexel(format, chain.data() + getLevelOffset(2, 1, format, 1));
+    float2 xy = float2(texel.r, texel.g) * 2.f - 1.f;
+    EXPECT_NEAR(xy.x, 0.f, 1e-5f);
+    EXPECT_NEAR(xy.y, 0.f, 1e-5f);
+
+    // Averaging the encoded values alone would only hold for symmetric inputs; check unit length on a skewed pair
+    const std::vector<float> skewed = {0.5f, 0.5f, 1.f, 0.5f};
+    chain = TextureMips::generate(2, 1, format, reinterpret_cast<const uint8_t*>(skewed.data()), 2, true);
+    texel = TextureMips::decodeTexel(format, chain.data() + getLevelOffset(2, 1, format, 1));
+    xy = float2(texel.r, texel.g) * 2.f - 1.f;
+    const float expected = std::sin(std::atan2(1.f, 1.f));
+    EXPECT_NEAR(xy.x, expected, 1e-5f);
+    EXPECT_LE(glm::dot(xy, xy), 1.f + 1e-5f);
+}